@@ -31,7 +31,6 @@ void chi_diffusion::Solver::CFEM_Assemble_A_and_b(chi_mesh::Cell& cell,
   cell_rhs.resize(num_nodes, 0.0);
 
   std::vector<int64_t> dof_global_row_ind(num_nodes, -1);
-  std::vector<int64_t> dof_global_col_ind(num_nodes, -1);
 
   //========================================= Loop over DOFs
   for (int i=0; i<num_nodes; i++)
@@ -50,7 +49,6 @@ void chi_diffusion::Solver::CFEM_Assemble_A_and_b(chi_mesh::Cell& cell,
     //====================== Develop RHS entry
     cell_rhs[i] = q[i]* fe_intgrl_values.IntV_shapeI(i);
   }//for i
-  dof_global_col_ind = dof_global_row_ind;
 
   //======================================== Apply Dirichlet,Vacuum, Neumann and
   //                                         Robin BCs
@@ -114,16 +112,15 @@ void chi_diffusion::Solver::CFEM_Assemble_A_and_b(chi_mesh::Cell& cell,
   for (int i=0; i<num_nodes; ++i)
     dirichlet_value[i] /= (dirichlet_count[i] > 0)? dirichlet_count[i] : 1;
 
+  //Dirichlet rows become identity rows and their columns are moved to
+  //the rhs. The zeroed entries are still inserted, keeping the
+  //structure of the matrix independent of the boundary conditions.
   for (int i=0; i<num_nodes; ++i)
   {
     if (dirichlet_count[i] > 0)
     {
-      cell_matrix[i].clear();
-      cell_matrix[i] = std::vector<double>(num_nodes, 0.0);
+      cell_matrix[i].assign(num_nodes, 0.0);
       cell_matrix[i][i] = 1.0;
-      int ir = dof_global_col_ind[i];
-      MatSetValue(A,ir,ir,1.0,ADD_VALUES);
-      dof_global_col_ind[i] = -1;
       cell_rhs[i] = dirichlet_value[i];
     }
     else
@@ -149,7 +146,7 @@ void chi_diffusion::Solver::CFEM_Assemble_A_and_b(chi_mesh::Cell& cell,
   //======================================== Add to global
   MatSetValues(A,
                num_nodes, dof_global_row_ind.data(),
-               num_nodes, dof_global_col_ind.data(),
+               num_nodes, dof_global_row_ind.data(),
                cell_matrix_cont.data(), ADD_VALUES);
 
   VecSetValues(b,
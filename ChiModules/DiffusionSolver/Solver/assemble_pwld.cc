@@ -8,318 +8,370 @@ extern ChiLog& chi_log;
 #include "chi_mpi.h"
 extern ChiMPI& chi_mpi;
 
+#include <cmath>
+
+namespace
+{
 //###################################################################
-/**Assembles PWLC matrix for polygon cells.*/
-void chi_diffusion::Solver::PWLD_Assemble_A_and_b(const chi_mesh::Cell &cell,
-                                                  int component)
+/**Group independent data of an interior face used by the MIP
+ * assembly.*/
+struct MIPFaceData
 {
-  auto pwl_sdm = std::static_pointer_cast<SpatialDiscretization_PWLD>(this->discretization);
-  const auto& fe_intgrl_values = pwl_sdm->GetUnitIntegrals(cell);
+  const chi_mesh::Cell* adj_cell = nullptr;
+  double                hm = 0.0;             ///< H-perpendicular of cell
+  double                hp = 0.0;             ///< H-perpendicular of adj_cell
+  std::vector<int>      adj_face_nodes;       ///< Adj-cell node of face nodes
+};
 
-  size_t num_nodes = fe_intgrl_values.NumNodes();
+//###################################################################
+/**MIP penalty coefficient of a face, given the sum of D/h over the
+ * sides of the face. Boundary faces use twice the interior factor.*/
+double MIPPenaltyCoefficient(chi_mesh::CellType cell_type,
+                             double D_over_h,
+                             bool boundary_face)
+{
+  double factor;
+  if (cell_type == chi_mesh::CellType::SLAB or
+      cell_type == chi_mesh::CellType::POLYGON)
+    factor = 2.0;
+  else if (cell_type == chi_mesh::CellType::POLYHEDRON)
+    factor = 4.0;
+  else
+    return 1.0;
+
+  if (boundary_face) factor *= 2.0;
+
+  return std::fmax(factor*D_over_h, 0.25);
+}
+}//namespace
 
-  //====================================== Process material id
-  int mat_id = cell.material_id;
+//###################################################################
+/**Assembles PWLD MIP matrix and rhs for a single component.*/
+void chi_diffusion::Solver::PWLD_Assemble_A_and_b(const chi_mesh::Cell &cell,
+                                                  int component)
+{
+  PWLD_AssembleCellBlocks(cell, component, component, 1);
+}
 
-  std::vector<double> D(num_nodes, 1.0);
-  std::vector<double> q(num_nodes, 1.0);
-  std::vector<double> siga(num_nodes, 0.0);
+//###################################################################
+/**Assembles PWLD MIP rhs for a single component.*/
+void chi_diffusion::Solver::PWLD_Assemble_b(const chi_mesh::Cell& cell,
+                                            int component)
+{
+  PWLD_AssembleCellSource(cell, component, component, 1);
+}
 
-  GetMaterialProperties(cell, num_nodes, D, q, siga, component);
+//###################################################################
+/**Assembles the PWLD MIP matrix and rhs contributions of a cell for
+ * num_groups consecutive components and groups. In matrix-free mode
+ * only the cell blocks are assembled, into the preconditioner matrix
+ * when it is used.*/
+void chi_diffusion::Solver::
+  PWLD_AssembleCellBlocks(const chi_mesh::Cell& cell,
+                          unsigned int first_component,
+                          int first_group,
+                          int num_groups)
+{
+  const Mat  target = matrix_free ? P : A;
+  const bool cell_blocks_only = matrix_free;
 
-  //========================================= Loop over DOFs
-  for (int i=0; i<num_nodes; i++)
+  auto insert_block = [target,cell_blocks_only](const std::vector<PetscInt>& rows,
+                                                const std::vector<PetscInt>& cols,
+                                                const std::vector<double>& values,
+                                                bool cell_block)
   {
-    int ir = pwl_sdm->MapDOF(cell, i, unknown_manager, 0, component);
-    double rhsvalue =0.0;
+    if (target == nullptr or (cell_blocks_only and not cell_block)) return;
 
-    //====================== Develop matrix entry
-    for (int j=0; j<num_nodes; j++)
-    {
-      int jr = pwl_sdm->MapDOF(cell, j, unknown_manager, 0, component);
-
-      double jr_mat_entry =
-        D[j]* fe_intgrl_values.IntV_gradShapeI_gradShapeJ(i, j);
-
-      jr_mat_entry +=
-        siga[j]* fe_intgrl_values.IntV_shapeI_shapeJ(i, j);
+    MatSetValues(target,
+                 static_cast<PetscInt>(rows.size()), rows.data(),
+                 static_cast<PetscInt>(cols.size()), cols.data(),
+                 values.data(), ADD_VALUES);
+  };
 
-      MatSetValue(A,ir,jr,jr_mat_entry,ADD_VALUES);
-
-      rhsvalue += q[j]* fe_intgrl_values.IntV_shapeI_shapeJ(i, j);
-    }//for j
+  PWLD_ComputeCellBlocks(cell, first_component, first_group, num_groups,
+                         insert_block, true);
+}
 
-    //====================== Apply RHS entry
-    VecSetValue(b,ir,rhsvalue,ADD_VALUES);
+//###################################################################
+/**Computes the PWLD MIP matrix blocks of a cell for num_groups
+ * consecutive components and groups and passes them to block_function.
+ * When assemble_rhs is set the rhs contributions are added to b.
+ *
+ * The volume, boundary and self-coupling face terms of a cell are
+ * accumulated in a dense element matrix. Each interior face adds a block
+ * coupling the rows of the cell to the face nodes of the neighbor, and
+ * a block coupling the face-node rows of the neighbor to the cell.
+ * Every block is passed whole, including its zero entries, so that an
+ * assembled matrix structure equals the preallocated sparsity pattern
+ * regardless of the material values.*/
+void chi_diffusion::Solver::
+  PWLD_ComputeCellBlocks(const chi_mesh::Cell& cell,
+                         unsigned int first_component,
+                         int first_group,
+                         int num_groups,
+                         const MIPBlockFunction& block_function,
+                         bool assemble_rhs)
+{
+  auto pwl_sdm = std::static_pointer_cast<SpatialDiscretization_PWLD>(this->discretization);
+  const auto& fe_intgrl_values = pwl_sdm->GetUnitIntegrals(cell);
 
-  }//for i
+  const size_t num_nodes = fe_intgrl_values.NumNodes();
+  const size_t num_faces = cell.faces.size();
+  const auto cell_type   = cell.Type();
 
+  const auto& mat_data = GetMaterialData(cell.material_id);
 
-  //========================================= Loop over faces
-  int num_faces = cell.faces.size();
-  for (unsigned int f=0; f<num_faces; f++)
+  //============================================= Group independent face data
+  std::vector<MIPFaceData> faces_data(num_faces);
+  for (size_t f=0; f<num_faces; f++)
   {
-    auto& face = cell.faces[f];
-
-    //================================== Get face normal
-    chi_mesh::Vector3 n  = face.normal;
-
-    int num_face_dofs = face.vertex_ids.size();
+    const auto& face = cell.faces[f];
+    auto& face_data = faces_data[f];
 
-    if (face.has_neighbor)
+    if (not face.has_neighbor)
     {
-      const auto& adj_cell = pwl_sdm->GetNeighborCell(face.neighbor_id);
-      const auto& adj_fe_intgrl_values = pwl_sdm->GetUnitIntegrals(adj_cell);
-
-
-      //========================= Get the current map to the adj cell's face
-      unsigned int fmap = MapCellFace(cell,adj_cell,f);
+      if (boundaries[face.neighbor_id]->type == BoundaryType::Dirichlet)
+        face_data.hm = HPerpendicular(cell, fe_intgrl_values, f);
+      continue;
+    }
 
-      //========================= Compute penalty coefficient
-      double hp = HPerpendicular(adj_cell, adj_fe_intgrl_values, fmap);
-      double hm = HPerpendicular(cell, fe_intgrl_values, f);
+    face_data.hm = HPerpendicular(cell, fe_intgrl_values, f);
 
-      std::vector<double> adj_D,adj_Q,adj_sigma;
+    const auto& adj_cell = pwl_sdm->GetNeighborCell(face.neighbor_id);
+    const auto& adj_fe_intgrl_values = pwl_sdm->GetUnitIntegrals(adj_cell);
 
-      GetMaterialProperties(adj_cell,
-                            adj_fe_intgrl_values.NumNodes(),
-                            adj_D,
-                            adj_Q,
-                            adj_sigma,
-                            component);
+    unsigned int fmap = MapCellFace(cell,adj_cell,f);
 
-      //========================= Compute surface average D
-      double D_avg = 0.0;
-      double intS = 0.0;
-      for (int fi=0; fi<num_face_dofs; fi++)
-      {
-        int i = fe_intgrl_values.FaceDofMapping(f,fi);
-        D_avg += D[i]* fe_intgrl_values.IntS_shapeI(f, i);
-        intS += fe_intgrl_values.IntS_shapeI(f, i);
-      }
-      D_avg /= intS;
+    face_data.adj_cell = &adj_cell;
+    face_data.hp = HPerpendicular(adj_cell, adj_fe_intgrl_values, fmap);
 
-      //========================= Compute surface average D_adj
-      double adj_D_avg = 0.0;
-      double adj_intS = 0.0;
-      for (int fi=0; fi<num_face_dofs; fi++)
-      {
-        int i    = fe_intgrl_values.FaceDofMapping(f,fi);
-        int imap = MapCellLocalNodeIDFromGlobalID(adj_cell, cell.vertex_ids[i]);
-        adj_D_avg += adj_D[imap]* adj_fe_intgrl_values.IntS_shapeI(fmap, imap);
-        adj_intS += adj_fe_intgrl_values.IntS_shapeI(fmap, imap);
-      }
-      adj_D_avg /= adj_intS;
-
-      //========================= Compute kappa
-      double kappa = 1.0;
-      if (cell.Type() == chi_mesh::CellType::SLAB)
-        kappa = fmax(2.0*(adj_D_avg/hp + D_avg/hm),0.25);
-      if (cell.Type() == chi_mesh::CellType::POLYGON)
-        kappa = fmax(2.0*(adj_D_avg/hp + D_avg/hm),0.25);
-      if (cell.Type() == chi_mesh::CellType::POLYHEDRON)
-        kappa = fmax(4.0*(adj_D_avg/hp + D_avg/hm),0.25);
-
-      //========================= Assembly penalty terms
-      for (int fi=0; fi<num_face_dofs; fi++)
-      {
-        int i  = fe_intgrl_values.FaceDofMapping(f,fi);
-        int ir = pwl_sdm->MapDOF(cell, i, unknown_manager, 0, component);
+    face_data.adj_face_nodes.reserve(face.vertex_ids.size());
+    for (uint64_t vid : face.vertex_ids)
+      face_data.adj_face_nodes.push_back(
+        static_cast<int>(MapCellLocalNodeIDFromGlobalID(adj_cell, vid)));
+  }//for f
 
-        for (int fj=0; fj<num_face_dofs; fj++)
-        {
-          int j     = fe_intgrl_values.FaceDofMapping(f,fj);
-          int jr    = pwl_sdm->MapDOF(cell, j, unknown_manager, 0, component);
-          int jmap  = MapCellLocalNodeIDFromGlobalID(adj_cell, face.vertex_ids[fj]);
-          int jrmap = pwl_sdm->MapDOF(adj_cell, jmap, unknown_manager, 0, component);
+  //============================================= Element storage
+  std::vector<PetscInt> cell_dofs(num_nodes);
+  std::vector<PetscInt> adj_face_dofs;
+  std::vector<double>   cell_matrix(num_nodes*num_nodes);
+  std::vector<double>   cell_rhs(num_nodes);
+  std::vector<double>   q;
+  std::vector<double>   coupling_out;          //cell rows, adj face cols
+  std::vector<double>   coupling_in;           //adj face rows, cell cols
 
-          double aij = kappa* fe_intgrl_values.IntS_shapeI_shapeJ(f, i, j);
+  for (int gr=0; gr<num_groups; gr++)
+  {
+    const unsigned int component = first_component + gr;
+    const int          group     = first_group + gr;
 
-          MatSetValue(A,ir    ,jr   , aij,ADD_VALUES);
-          MatSetValue(A,ir    ,jrmap,-aij,ADD_VALUES);
-        }//for fj
+    const double D    = mat_data.D[group];
+    const double siga = mat_data.sigma_a[group];
 
-      }//for fi
+    if (assemble_rhs)
+      GetCellSource(cell, mat_data, num_nodes, group, q);
 
-      //========================= Assemble gradient terms
-      // For the following comments we use the notation:
-      // Dk = 0.5* n dot nabla bk
+    for (size_t i=0; i<num_nodes; i++)
+      cell_dofs[i] = pwl_sdm->MapDOF(cell, i, unknown_manager, 0, component);
 
-      // 0.5*D* n dot (b_j^+ - b_j^-)*nabla b_i^-
-      for (int i=0; i<fe_intgrl_values.NumNodes(); i++)
+    //========================================= Volume terms
+    for (size_t i=0; i<num_nodes; i++)
+    {
+      double rhsvalue = 0.0;
+      for (size_t j=0; j<num_nodes; j++)
       {
-        int ir = pwl_sdm->MapDOF(cell, i, unknown_manager, 0, component);
-
-        for (int fj=0; fj<num_face_dofs; fj++)
-        {
-          int j     = fe_intgrl_values.FaceDofMapping(f,fj);
-          int jr    = pwl_sdm->MapDOF(cell, j, unknown_manager, 0, component);
-          int jmap  = MapCellLocalNodeIDFromGlobalID(adj_cell, face.vertex_ids[fj]);
-          int jrmap = pwl_sdm->MapDOF(adj_cell, jmap, unknown_manager, 0, component);
-
-          double aij =
-            -0.5*D_avg*n.Dot(fe_intgrl_values.IntS_shapeI_gradshapeJ(f, j, i));
-
-          MatSetValue(A,ir,jr   , aij,ADD_VALUES);
-          MatSetValue(A,ir,jrmap,-aij,ADD_VALUES);
-        }//for fj
-      }//for i
+        cell_matrix[i*num_nodes + j] =
+          D   * fe_intgrl_values.IntV_gradShapeI_gradShapeJ(i, j) +
+          siga* fe_intgrl_values.IntV_shapeI_shapeJ(i, j);
+
+        if (assemble_rhs)
+          rhsvalue += q[j]* fe_intgrl_values.IntV_shapeI_shapeJ(i, j);
+      }//for j
+      cell_rhs[i] = rhsvalue;
+    }//for i
+
+    //========================================= Face terms
+    for (size_t f=0; f<num_faces; f++)
+    {
+      const auto& face = cell.faces[f];
+      const auto& face_data = faces_data[f];
+      const chi_mesh::Vector3& n = face.normal;
+      const size_t num_face_dofs = face.vertex_ids.size();
 
-      // 0.5*D* n dot (b_i^+ - b_i^-)*nabla b_j^-
-      for (int fi=0; fi<num_face_dofs; fi++)
+      if (face.has_neighbor)
       {
-        int i     = fe_intgrl_values.FaceDofMapping(f,fi);
-        int ir    = pwl_sdm->MapDOF(cell, i, unknown_manager, 0, component);
-        int imap  = MapCellLocalNodeIDFromGlobalID(adj_cell, face.vertex_ids[fi]);
-        int irmap = pwl_sdm->MapDOF(adj_cell, imap, unknown_manager, 0, component);
+        const auto& adj_cell = *face_data.adj_cell;
+        const auto& adj_mat_data = GetMaterialData(adj_cell.material_id);
+        const double adj_D = adj_mat_data.D[group];
 
-        for (int j=0; j<fe_intgrl_values.NumNodes(); j++)
-        {
-          int jr = pwl_sdm->MapDOF(cell, j, unknown_manager, 0, component);
+        const double kappa =
+          MIPPenaltyCoefficient(cell_type,
+                                adj_D/face_data.hp + D/face_data.hm, false);
 
-          double aij =
-            -0.5*D_avg*n.Dot(fe_intgrl_values.IntS_shapeI_gradshapeJ(f, i, j));
+        adj_face_dofs.resize(num_face_dofs);
+        for (size_t fj=0; fj<num_face_dofs; fj++)
+          adj_face_dofs[fj] = pwl_sdm->MapDOF(adj_cell,
+                                              face_data.adj_face_nodes[fj],
+                                              unknown_manager, 0, component);
 
-          MatSetValue(A,ir   ,jr, aij,ADD_VALUES);
-          MatSetValue(A,irmap,jr,-aij,ADD_VALUES);
-        }//for j
-      }//for fi
+        coupling_out.assign(num_nodes*num_face_dofs, 0.0);
+        coupling_in.assign(num_face_dofs*num_nodes, 0.0);
 
-    }//if not bndry
-    else
-    {
-      int ir_boundary_index = face.neighbor_id;
-      auto ir_boundary_type  = boundaries[ir_boundary_index]->type;
-
-      if (ir_boundary_type == BoundaryType::Dirichlet)
-      {
-        auto dc_boundary =
-          (chi_diffusion::BoundaryDirichlet*)boundaries[ir_boundary_index];
-
-        //========================= Compute penalty coefficient
-        double hm = HPerpendicular(cell, fe_intgrl_values, f);
-
-        //========================= Compute surface average D
-        double D_avg = 0.0;
-        double intS = 0.0;
-        for (int fi=0; fi<num_face_dofs; fi++)
-        {
-          int i = fe_intgrl_values.FaceDofMapping(f,fi);
-          D_avg += D[i]* fe_intgrl_values.IntS_shapeI(f, i);
-          intS += fe_intgrl_values.IntS_shapeI(f, i);
-        }
-        D_avg /= intS;
-
-        double kappa = 1.0;
-        if (cell.Type() == chi_mesh::CellType::SLAB)
-          kappa = fmax(4.0*(D_avg/hm),0.25);
-        if (cell.Type() == chi_mesh::CellType::POLYGON)
-          kappa = fmax(4.0*(D_avg/hm),0.25);
-        if (cell.Type() == chi_mesh::CellType::POLYHEDRON)
-          kappa = fmax(8.0*(D_avg/hm),0.25);
-
-        //========================= Assembly penalty terms
-        for (int fi=0; fi<num_face_dofs; fi++)
+        //==================== Penalty terms
+        for (size_t fi=0; fi<num_face_dofs; fi++)
         {
-          int i  = fe_intgrl_values.FaceDofMapping(f,fi);
-          int ir = pwl_sdm->MapDOF(cell, i, unknown_manager, 0, component);
-
-          for (int fj=0; fj<num_face_dofs; fj++)
+          const int i = fe_intgrl_values.FaceDofMapping(f,fi);
+          for (size_t fj=0; fj<num_face_dofs; fj++)
           {
-            int j  = fe_intgrl_values.FaceDofMapping(f,fj);
-            int jr = pwl_sdm->MapDOF(cell, j, unknown_manager, 0, component);
-
-            double aij = kappa* fe_intgrl_values.IntS_shapeI_shapeJ(f, i, j);
+            const int j = fe_intgrl_values.FaceDofMapping(f,fj);
+            const double aij = kappa* fe_intgrl_values.IntS_shapeI_shapeJ(f, i, j);
 
-            MatSetValue(A,ir    ,jr, aij,ADD_VALUES);
-            VecSetValue(b,ir,aij*dc_boundary->boundary_value,ADD_VALUES);
+            cell_matrix[i*num_nodes + j]       += aij;
+            coupling_out[i*num_face_dofs + fj] -= aij;
           }//for fj
         }//for fi
 
-        // -Di^- bj^- and
-        // -Dj^- bi^-
-        for (int i=0; i<fe_intgrl_values.NumNodes(); i++)
+        //==================== Gradient terms
+        // 0.5*D* n dot (b_j^+ - b_j^-)*nabla b_i^-
+        for (size_t i=0; i<num_nodes; i++)
         {
-          int ir = pwl_sdm->MapDOF(cell, i, unknown_manager, 0, component);
-
-          for (int j=0; j<fe_intgrl_values.NumNodes(); j++)
+          for (size_t fj=0; fj<num_face_dofs; fj++)
           {
-            int jr = pwl_sdm->MapDOF(cell, j, unknown_manager, 0, component);
+            const int j = fe_intgrl_values.FaceDofMapping(f,fj);
+            const double aij =
+              -0.5*D*n.Dot(fe_intgrl_values.IntS_shapeI_gradshapeJ(f, j, i));
 
-            double gij =
-              n.Dot(fe_intgrl_values.IntS_shapeI_gradshapeJ(f, i, j) +
-                    fe_intgrl_values.IntS_shapeI_gradshapeJ(f, j, i));
-            double aij = -0.5*D_avg*gij;
+            cell_matrix[i*num_nodes + j]       += aij;
+            coupling_out[i*num_face_dofs + fj] -= aij;
+          }//for fj
+        }//for i
 
-            MatSetValue(A,ir,jr,aij,ADD_VALUES);
-            VecSetValue(b,ir,aij*dc_boundary->boundary_value,ADD_VALUES);
+        // 0.5*D* n dot (b_i^+ - b_i^-)*nabla b_j^-
+        for (size_t fi=0; fi<num_face_dofs; fi++)
+        {
+          const int i = fe_intgrl_values.FaceDofMapping(f,fi);
+          for (size_t j=0; j<num_nodes; j++)
+          {
+            const double aij =
+              -0.5*D*n.Dot(fe_intgrl_values.IntS_shapeI_gradshapeJ(f, i, j));
+
+            cell_matrix[i*num_nodes + j]    += aij;
+            coupling_in[fi*num_nodes + j]   -= aij;
           }//for j
-        }//for i
-      }//Dirichlet
-      else if (ir_boundary_type == BoundaryType::Robin)
+        }//for fi
+
+        block_function(cell_dofs, adj_face_dofs, coupling_out, false);
+        block_function(adj_face_dofs, cell_dofs, coupling_in, false);
+      }//if not bndry
+      else
       {
-        auto robin_bndry =
-          (chi_diffusion::BoundaryRobin*)boundaries[ir_boundary_index];
+        const auto boundary = boundaries[face.neighbor_id];
 
-        for (int fi=0; fi<num_face_dofs; fi++)
+        if (boundary->type == BoundaryType::Dirichlet)
         {
-          int i  = fe_intgrl_values.FaceDofMapping(f,fi);
-          int ir = pwl_sdm->MapDOF(cell, i, unknown_manager, 0, component);
-
-          for (int fj=0; fj<num_face_dofs; fj++)
-          {
-            int j  = fe_intgrl_values.FaceDofMapping(f,fj);
-            int jr = pwl_sdm->MapDOF(cell, j, unknown_manager, 0, component);
+          const double bndry_value =
+            ((chi_diffusion::BoundaryDirichlet*)boundary)->boundary_value;
 
-            double aij = robin_bndry->a* fe_intgrl_values.IntS_shapeI_shapeJ(f, i, j);
-            aij /= robin_bndry->b;
+          const double kappa =
+            MIPPenaltyCoefficient(cell_type, D/face_data.hm, true);
 
-            MatSetValue(A,ir ,jr, aij,ADD_VALUES);
-          }//for fj
+          //==================== Penalty terms
+          for (size_t fi=0; fi<num_face_dofs; fi++)
+          {
+            const int i = fe_intgrl_values.FaceDofMapping(f,fi);
+            for (size_t fj=0; fj<num_face_dofs; fj++)
+            {
+              const int j = fe_intgrl_values.FaceDofMapping(f,fj);
+              const double aij = kappa* fe_intgrl_values.IntS_shapeI_shapeJ(f, i, j);
+
+              cell_matrix[i*num_nodes + j] += aij;
+              cell_rhs[i] += aij*bndry_value;
+            }//for fj
+          }//for fi
+
+          // -Di^- bj^- and
+          // -Dj^- bi^-
+          for (size_t i=0; i<num_nodes; i++)
+          {
+            for (size_t j=0; j<num_nodes; j++)
+            {
+              const double gij =
+                n.Dot(fe_intgrl_values.IntS_shapeI_gradshapeJ(f, i, j) +
+                      fe_intgrl_values.IntS_shapeI_gradshapeJ(f, j, i));
+              const double aij = -0.5*D*gij;
+
+              cell_matrix[i*num_nodes + j] += aij;
+              cell_rhs[i] += aij*bndry_value;
+            }//for j
+          }//for i
+        }//Dirichlet
+        else if (boundary->type == BoundaryType::Robin)
+        {
+          const auto robin_bndry = (chi_diffusion::BoundaryRobin*)boundary;
 
-          double aii = robin_bndry->f* fe_intgrl_values.IntS_shapeI(f, i);
-          aii /= robin_bndry->b;
+          for (size_t fi=0; fi<num_face_dofs; fi++)
+          {
+            const int i = fe_intgrl_values.FaceDofMapping(f,fi);
+            for (size_t fj=0; fj<num_face_dofs; fj++)
+            {
+              const int j = fe_intgrl_values.FaceDofMapping(f,fj);
+
+              cell_matrix[i*num_nodes + j] +=
+                robin_bndry->a* fe_intgrl_values.IntS_shapeI_shapeJ(f, i, j)/
+                robin_bndry->b;
+            }//for fj
+
+            cell_matrix[i*num_nodes + i] +=
+              robin_bndry->f* fe_intgrl_values.IntS_shapeI(f, i)/robin_bndry->b;
+          }//for fi
+        }//robin
+      }
+    }//for f
 
-          MatSetValue(A,ir ,ir, aii,ADD_VALUES);
-        }//for fi
-      }//robin
-    }
-  }//for f
+    //========================================= Insert element blocks
+    block_function(cell_dofs, cell_dofs, cell_matrix, true);
+    if (assemble_rhs)
+      VecSetValues(b, num_nodes, cell_dofs.data(), cell_rhs.data(), ADD_VALUES);
+  }//for gr
 }
 
 //###################################################################
-/**Assembles PWLC matrix for polygon cells.*/
-void chi_diffusion::Solver::PWLD_Assemble_b(const chi_mesh::Cell& cell,
-                                            int component)
+/**Assembles the PWLD MIP rhs contributions of a cell for num_groups
+ * consecutive components and groups.*/
+void chi_diffusion::Solver::
+  PWLD_AssembleCellSource(const chi_mesh::Cell& cell,
+                          unsigned int first_component,
+                          int first_group,
+                          int num_groups)
 {
   auto pwl_sdm = std::static_pointer_cast<SpatialDiscretization_PWLD>(this->discretization);
   const auto& fe_intgrl_values = pwl_sdm->GetUnitIntegrals(cell);
 
-  size_t num_nodes = fe_intgrl_values.NumNodes();
-
-  //====================================== Process material id
-  int mat_id = cell.material_id;
+  const size_t num_nodes = fe_intgrl_values.NumNodes();
 
-  std::vector<double> D(num_nodes, 1.0);
-  std::vector<double> q(num_nodes, 1.0);
-  std::vector<double> siga(num_nodes, 1.0);
+  const auto& mat_data = GetMaterialData(cell.material_id);
 
-  GetMaterialProperties(cell, num_nodes, D, q, siga, component);
+  std::vector<PetscInt> cell_dofs(num_nodes);
+  std::vector<double>   cell_rhs(num_nodes);
+  std::vector<double>   q;
 
-  //========================================= Loop over DOFs
-  for (int i=0; i<num_nodes; i++)
+  for (int gr=0; gr<num_groups; gr++)
   {
-    int ir = pwl_sdm->MapDOF(cell, i, unknown_manager, 0, component);
+    const unsigned int component = first_component + gr;
+    const int          group     = first_group + gr;
 
-    //====================== Develop rhs entry
-    double rhsvalue =0.0;
-    for (int j=0; j<num_nodes; j++)
-      rhsvalue += q[j]* fe_intgrl_values.IntV_shapeI_shapeJ(i, j);
+    GetCellSource(cell, mat_data, num_nodes, group, q);
 
-    //====================== Apply RHS entry
-    VecSetValue(b,ir,rhsvalue,ADD_VALUES);
-
-  }//for i
+    for (size_t i=0; i<num_nodes; i++)
+    {
+      cell_dofs[i] = pwl_sdm->MapDOF(cell, i, unknown_manager, 0, component);
 
+      double rhsvalue = 0.0;
+      for (size_t j=0; j<num_nodes; j++)
+        rhsvalue += q[j]* fe_intgrl_values.IntV_shapeI_shapeJ(i, j);
+      cell_rhs[i] = rhsvalue;
+    }//for i
 
+    VecSetValues(b, num_nodes, cell_dofs.data(), cell_rhs.data(), ADD_VALUES);
+  }//for gr
 }
@@ -14,6 +14,8 @@ Option name           | Type   | Default Value | Description
 "property_map_D"        | int    | 0             | Material property index to use for diffusion coefficient
 "property_map_q"        | int    | 1             | Material property index to use for source.
 "property_map_sigma"    | int    | 2             | Material property index to use for interaction coefficient.
+"matrix_free"           | bool   | false         | Applies the PWLD_MIP operators matrix-free instead of assembling them.
+"matrix_free_pc"        | string | "CELL_BLOCK"  | Preconditioner of the matrix-free operator. "CELL_BLOCK" assembles the cell blocks only, "JACOBI" uses the diagonal.
  *
  * To set these options use the command chiSolverSetBasicOption() with
  * an option-name and value in the table above.
@@ -30,7 +32,9 @@ chi_diffusion::Solver::Solver(const std::string& in_solver_name):
                                        {"residual_tolerance", 1.0e-8},
                                        {"property_map_D",int64_t(0)},
                                        {"property_map_q",int64_t(1)},
-                                       {"property_map_sigma",int64_t(2)}})
+                                       {"property_map_sigma",int64_t(2)},
+                                       {"matrix_free",false},
+                                       {"matrix_free_pc",std::string("CELL_BLOCK")}})
 {}
 
 chi_diffusion::Solver::~Solver()
@@ -42,6 +46,10 @@ chi_diffusion::Solver::~Solver()
   VecDestroy(&x);
   VecDestroy(&b);
   MatDestroy(&A);
+  MatDestroy(&P);
+  VecScatterDestroy(&mf_scatter);
+  VecDestroy(&mf_x_local);
+  VecDestroy(&mf_y_local);
   KSPDestroy(&ksp);
 
   MPI_Barrier(MPI_COMM_WORLD);
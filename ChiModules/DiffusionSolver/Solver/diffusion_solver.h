@@ -18,6 +18,8 @@
 
 #include <petscksp.h>
 
+#include <functional>
+
 #define DIFFUSION_MATERIALS_REGULAR                       10
 #define DIFFUSION_MATERIALS_FROM_TRANSPORTXS_TTR          11
 #define DIFFUSION_MATERIALS_FROM_TRANSPORTXS_TTF          12
@@ -43,6 +45,27 @@ public:
   typedef std::pair<BoundaryType,std::vector<double>> BoundaryInfo;
   typedef std::map<uint, BoundaryInfo> BoundaryPreferences;
 
+  /**Material coefficients resolved once per material for an assembly.
+   * The diffusion coefficient and absorption cross-section are indexed
+   * by group. The source is either a material value or, when
+   * q_from_field is set, read per node from the source field.*/
+  struct MaterialData
+  {
+    bool                resolved = false;
+    std::vector<double> D;
+    std::vector<double> sigma_a;
+    double              q = 1.0;
+    bool                q_from_field = false;
+  };
+
+  /**Receives a dense, row-major block of the MIP operator along with
+   * the global rows and columns it couples. cell_block is set for the
+   * self-coupling block of a cell.*/
+  typedef std::function<void(const std::vector<PetscInt>& rows,
+                             const std::vector<PetscInt>& cols,
+                             const std::vector<double>& values,
+                             bool cell_block)> MIPBlockFunction;
+
 public:
   BoundaryPreferences                      boundary_preferences;
   std::vector<chi_diffusion::Boundary*>    boundaries;
@@ -57,6 +80,11 @@ public:
   std::shared_ptr<chi_physics::FieldFunction> q_field     = nullptr;
   std::shared_ptr<chi_physics::FieldFunction> sigma_field = nullptr;
 
+  /**When set, the solver is only used for its operator. Field-sourced
+   * material modes then require no source field and assemble a zero
+   * source.*/
+  bool  operator_only      = false;
+
   bool common_items_initialized=false;
 
   Vec            x = nullptr;            // approx solution
@@ -64,6 +92,14 @@ public:
   Mat            A = nullptr;            // linear system matrix
   KSP            ksp = nullptr;          // linear solver context
   PC             pc = nullptr;           // preconditioner context
+  Mat            P = nullptr;            // preconditioner matrix, matrix-free only
+
+  bool           matrix_free = false;
+  VecScatter     mf_scatter = nullptr;   // owned dofs and ghost dofs
+  Vec            mf_x_local = nullptr;   // of face neighbors
+  Vec            mf_y_local = nullptr;
+  PetscInt       mf_first_dof = 0;
+  std::map<PetscInt,PetscInt>    mf_ghost_local_index;
 
   PetscReal      norm = 0.0;         /* norm of solution error */
   PetscErrorCode ierr = 0;         // General error code
@@ -73,6 +109,9 @@ public:
 
   std::vector<double>            pwld_phi_local;
 
+  std::vector<MaterialData>      material_data;
+  std::vector<MaterialData>      assembled_material_data;
+
   int    gi = 0;
   int    G = 1;
   std::string options_string;
@@ -89,6 +128,14 @@ public:
                              std::vector<double>& sigmaa,
                              int group=0,
                              int moment=0);
+  void ResetMaterialData();
+  bool MaterialDataChanged();
+  const MaterialData& GetMaterialData(int mat_id);
+  void GetCellSource(const chi_mesh::Cell& cell,
+                     const MaterialData& mat_data,
+                     size_t num_nodes,
+                     int group,
+                     std::vector<double>& sourceQ);
   //01a
   void InitializeCommonItems();
 
@@ -113,6 +160,27 @@ public:
   void PWLD_Assemble_A_and_b_GAGG(const chi_mesh::Cell& cell);
   void PWLD_Assemble_b_GAGG(const chi_mesh::Cell& cell);
 
+  //02d
+  void PWLD_AssembleCellBlocks(const chi_mesh::Cell& cell,
+                               unsigned int first_component,
+                               int first_group,
+                               int num_groups);
+  void PWLD_AssembleCellSource(const chi_mesh::Cell& cell,
+                               unsigned int first_component,
+                               int first_group,
+                               int num_groups);
+  void PWLD_ComputeCellBlocks(const chi_mesh::Cell& cell,
+                              unsigned int first_component,
+                              int first_group,
+                              int num_groups,
+                              const MIPBlockFunction& block_function,
+                              bool assemble_rhs);
+
+  //02f
+  void PWLD_InitMatrixFree();
+  PetscInt MapMatrixFreeLocalIndex(PetscInt global_dof) const;
+  void PWLD_MatrixFreeApply(Vec x_in, Vec y_out, bool diagonal_only);
+
 
   //03b
   double HPerpendicular(const chi_mesh::Cell& cell,
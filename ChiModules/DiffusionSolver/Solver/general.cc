@@ -22,11 +22,68 @@ void chi_diffusion::Solver::GetMaterialProperties(const chi_mesh::Cell& cell,
                                                   int group,
                                                   int moment)
 {
-  uint64_t cell_glob_index = cell.global_id;
-  bool cell_is_local = (cell.partition_id == chi_mpi.location_id);
-  uint64_t cell_local_id = cell.local_id;
-  int mat_id = cell.material_id;
+  const auto& mat_data = GetMaterialData(cell.material_id);
 
+  diffCoeff.assign(cell_dofs, mat_data.D[group]);
+  sigmaa.assign(cell_dofs, mat_data.sigma_a[group]);
+
+  GetCellSource(cell, mat_data, cell_dofs, group, sourceQ);
+}
+
+//###################################################################
+/**Clears the resolved material data so that the next lookups reflect
+ * the current materials and options. Called at the start of every
+ * assembly.*/
+void chi_diffusion::Solver::ResetMaterialData()
+{
+  material_data.assign(chi_physics_handler.material_stack.size(),
+                       MaterialData());
+}
+
+//###################################################################
+/**Determines whether the diffusion coefficients or absorption
+ * cross-sections of any material used by the last matrix assembly have
+ * changed since, in which case the matrix and preconditioner need to be
+ * rebuilt. Sources are not compared since they only affect the rhs.*/
+bool chi_diffusion::Solver::MaterialDataChanged()
+{
+  if (assembled_material_data.size() !=
+      chi_physics_handler.material_stack.size())
+    return true;
+
+  ResetMaterialData();
+
+  bool changed = false;
+  for (size_t m=0; m<assembled_material_data.size(); m++)
+  {
+    const auto& assembled_data = assembled_material_data[m];
+    if (not assembled_data.resolved) continue;
+
+    const auto& current_data = GetMaterialData(static_cast<int>(m));
+    if ((current_data.D != assembled_data.D) or
+        (current_data.sigma_a != assembled_data.sigma_a))
+    {
+      changed = true;
+      break;
+    }
+  }
+
+  //Materials are used on other locations as ghosts
+  int local_changed = changed ? 1 : 0;
+  int global_changed = 0;
+  MPI_Allreduce(&local_changed, &global_changed, 1, MPI_INT, MPI_MAX,
+                MPI_COMM_WORLD);
+
+  return global_changed > 0;
+}
+
+//###################################################################
+/**Gets the coefficients of a material, resolving them from the
+ * material properties on first use. Only materials that are actually
+ * encountered are checked for valid properties.*/
+const chi_diffusion::Solver::MaterialData& chi_diffusion::Solver::
+  GetMaterialData(int mat_id)
+{
   if (mat_id<0)
   {
     chi_log.Log(LOG_0ERROR)
@@ -42,16 +99,66 @@ void chi_diffusion::Solver::GetMaterialProperties(const chi_mesh::Cell& cell,
     exit(EXIT_FAILURE);
   }
 
+  if (material_data.size() != chi_physics_handler.material_stack.size())
+    ResetMaterialData();
+
+  auto& mat_data = material_data[mat_id];
+  if (mat_data.resolved) return mat_data;
+
   auto property_map_D     = basic_options("property_map_D").IntegerValue();
   auto property_map_q     = basic_options("property_map_q").IntegerValue();
   auto property_map_sigma = basic_options("property_map_sigma").IntegerValue();
 
   auto material = chi_physics_handler.material_stack[mat_id];
 
-  //====================================== Process material properties
-  diffCoeff.resize(cell_dofs,1.0);
-  sourceQ.resize(cell_dofs,0.0);
-  sigmaa.resize(cell_dofs,0.0);
+  const size_t num_groups = static_cast<size_t>(gi + G);
+
+  //====================================== Scalar source, shared by the
+  //                                       regular and TTR modes
+  auto ResolveScalarSource = [&]()
+  {
+    if ((property_map_q < material->properties.size()) &&
+        (property_map_q >= 0))
+    {
+      if (std::dynamic_pointer_cast<chi_physics::ScalarValue>
+          (material->properties[property_map_q]))
+      {
+        mat_data.q = material->properties[property_map_q]->GetScalarValue();
+      }
+      else
+      {
+        chi_log.Log(LOG_0ERROR)
+          << "Source value mapped to property index "
+          << property_map_q << " is not a valid property type"
+          << " for material \""
+          << material->name <<"\" id " << mat_id
+          << ". Currently SCALAR_VALUE is the "
+          << "only supported type.";
+        exit(EXIT_FAILURE);
+      }
+    }
+  };
+
+  //====================================== Transport cross-sections,
+  //                                       needed by all other modes
+  std::shared_ptr<chi_physics::TransportCrossSections> xs;
+  if (material_mode != DIFFUSION_MATERIALS_REGULAR)
+  {
+    for (const auto& property : material->properties)
+      if (std::dynamic_pointer_cast<chi_physics::TransportCrossSections>(property))
+        xs = std::static_pointer_cast<chi_physics::TransportCrossSections>(property);
+
+    if (xs == nullptr)
+    {
+      chi_log.Log(LOG_ALLERROR)
+        << "Diffusion Solver: Material encountered with no tranport xs"
+           " yet material mode is DIFFUSION_MATERIALS_FROM_TRANSPORTXS.";
+      exit(EXIT_FAILURE);
+    }
+
+    if (!xs->diffusion_initialized)
+      xs->ComputeDiffusionParameters();
+  }
 
   //####################################################### REGULAR MATERIAL
   if (material_mode == DIFFUSION_MATERIALS_REGULAR)
@@ -70,8 +177,8 @@ void chi_diffusion::Solver::GetMaterialProperties(const chi_mesh::Cell& cell,
     if (std::dynamic_pointer_cast<chi_physics::ScalarValue>
         (material->properties[property_map_D]))
     {
-      diffCoeff.assign(cell_dofs,
-                       material->properties[property_map_D]->GetScalarValue());
+      mat_data.D.assign(num_groups,
+                        material->properties[property_map_D]->GetScalarValue());
     }
     else
     {
@@ -85,34 +192,14 @@ void chi_diffusion::Solver::GetMaterialProperties(const chi_mesh::Cell& cell,
       exit(EXIT_FAILURE);
     }
 
+    ResolveScalarSource();
 
-    if ((property_map_q < material->properties.size()) &&
-        (property_map_q >= 0))
-    {
-      if (std::dynamic_pointer_cast<chi_physics::ScalarValue>
-          (material->properties[property_map_q]))
-      {
-        sourceQ.assign(cell_dofs,
-                       material->properties[property_map_q]->GetScalarValue());
-      }
-      else
-      {
-        chi_log.Log(LOG_0ERROR)
-          << "Source value mapped to property index "
-          << property_map_q << " is not a valid property type"
-          << " for material \""
-          << material->name <<"\" id " << mat_id
-          << ". Currently SCALAR_VALUE is the "
-          << "only supported type.";
-        exit(EXIT_FAILURE);
-      }
-    }
-
+    mat_data.sigma_a.assign(num_groups, 0.0);
     if (not ((property_map_sigma < 0) ||
              (property_map_sigma >= material->properties.size())))
     {
-      sigmaa.assign(cell_dofs,
-                    material->properties[property_map_sigma]->GetScalarValue());
+      mat_data.sigma_a.assign(num_groups,
+        material->properties[property_map_sigma]->GetScalarValue());
     }
   }//regular
 
@@ -121,332 +208,106 @@ void chi_diffusion::Solver::GetMaterialProperties(const chi_mesh::Cell& cell,
   //                                                        SCALAR       Q
   else if (material_mode == DIFFUSION_MATERIALS_FROM_TRANSPORTXS_TTR)
   {
-    //====================================== Setting D and Sigma_a
-    bool transportxs_found = false;
-    for (int p=0; p<material->properties.size(); p++)
-    {
-      if (std::dynamic_pointer_cast<chi_physics::TransportCrossSections>
-          (material->properties[p]))
-      {
-        auto xs = std::static_pointer_cast<chi_physics::TransportCrossSections>(
-          material->properties[p]);
-
-        if (!xs->diffusion_initialized)
-          xs->ComputeDiffusionParameters();
-
-        diffCoeff.assign(cell_dofs,xs->diffusion_coeff[group]);
-        sigmaa.assign(cell_dofs,xs->sigma_removal[group]);
-        transportxs_found = true;
-      }
-    }//for properties
-
-    if (!transportxs_found)
-    {
-      chi_log.Log(LOG_ALLERROR)
-        << "Diffusion Solver: Material encountered with no tranport xs"
-           " yet material mode is DIFFUSION_MATERIALS_FROM_TRANSPORTXS.";
-      exit(EXIT_FAILURE);
-    }
+    mat_data.D       = xs->diffusion_coeff;
+    mat_data.sigma_a = xs->sigma_removal;
 
-    //====================================== Setting Q
-    if ((property_map_q < material->properties.size()) &&
-        (property_map_q >= 0))
-    {
-      if (std::dynamic_pointer_cast<chi_physics::ScalarValue>
-          (material->properties[property_map_q]))
-      {
-        sourceQ.assign(cell_dofs,
-                       material->properties[property_map_q]->GetScalarValue());
-      }
-      else
-      {
-        chi_log.Log(LOG_0ERROR)
-          << "Source value mapped to property index "
-          << property_map_q << " is not a valid property type"
-          << " for material \""
-          << material->name <<"\" id " << mat_id
-          << ". Currently SCALAR_VALUE is the "
-          << "only supported type.";
-        exit(EXIT_FAILURE);
-      }
-    }
+    ResolveScalarSource();
   }//transport xs TTR
   //####################################################### TRANSPORT XS D
   //                                                        TRANSPORT XS SIGA
   //                                                        FIELDFUNC    Q
   else if (material_mode == DIFFUSION_MATERIALS_FROM_TRANSPORTXS_TTF)
   {
-    //====================================== Setting D and Sigma_a
-    bool transportxs_found = false;
-    for (int p=0; p<material->properties.size(); p++)
-    {
-      if (std::dynamic_pointer_cast<chi_physics::TransportCrossSections>
-          (material->properties[p]))
-      {
-        auto xs = std::static_pointer_cast<chi_physics::TransportCrossSections>(
-          material->properties[p]);
-
-        if (!xs->diffusion_initialized)
-          xs->ComputeDiffusionParameters();
-
-        diffCoeff.assign(cell_dofs,xs->diffusion_coeff[group]);
-        sigmaa.assign(cell_dofs,xs->sigma_removal[group]);
-        transportxs_found = true;
-      }
-    }//for properties
-
-    if (!transportxs_found)
-    {
-      chi_log.Log(LOG_ALLERROR)
-        << "Diffusion Solver: Material encountered with no tranport xs"
-           " yet material mode is DIFFUSION_MATERIALS_FROM_TRANSPORTXS.";
-      exit(EXIT_FAILURE);
-    }
-
-    //====================================== Setting Q
-    if ((q_field != nullptr) and (cell_is_local))
-    {
-      std::vector<uint64_t> mapping;
-//      std::vector<int> pwld_nodes;
-//      std::vector<int> pwld_cells;
-//
-//      for (int i=0; i<cell_dofs; i++)
-//      {
-//        pwld_nodes.push_back(i);
-//        pwld_cells.push_back(cell_local_id);
-//      }
-//
-//      chi_mesh::FieldFunctionInterpolation ffinterp;
-//      ffinterp.grid_view = grid;
-//      ffinterp.CreatePWLDMapping(q_field->num_components,
-//                                 q_field->num_sets,
-//                                 group-gi,moment,
-//                                 pwld_nodes,pwld_cells,
-//                                 pwl_sdm->cell_dfem_block_address,
-//                                 mapping);
-
-      std::vector<std::tuple<uint64_t,uint,uint>> cell_node_component_tuples;
-
-      for (int i=0; i<cell_dofs; i++)
-        cell_node_component_tuples.emplace_back(cell_local_id,i,group-gi);
-
-      q_field->CreatePWLDMappingLocal(cell_node_component_tuples, mapping);
-
-      for (int i=0; i<cell_dofs; i++)
-      {
-        try { sourceQ[i] = q_field->field_vector_local->at(mapping[i]); }
-        catch (const std::out_of_range& o)
-        {
-          chi_log.Log(LOG_ALLERROR)
-            << "Mapping error i=" << i
-            << " mapping[i]=" << mapping[i]
-            << " g=" << group << "(" << G << ")"
-            << " ffsize=" << q_field->field_vector_local->size()
-            << " dof_count=" << local_dof_count
-            << " cell_loc=" << grid->cells[cell_glob_index].partition_id;
-          exit(EXIT_FAILURE);
-        }
-
-      }
-
-
-    }
-    else if (q_field == nullptr)
-    {
-      chi_log.Log(LOG_ALLERROR)
-        << "Diffusion Solver: Material source set to field function however"
-           " the field is empty or not set.";
-      exit(EXIT_FAILURE);
-    }
+    mat_data.D       = xs->diffusion_coeff;
+    mat_data.sigma_a = xs->sigma_removal;
+    mat_data.q_from_field = true;
   }//transport xs TTF
-  //####################################################### TRANSPORT XS D
-  //                                                        TRANSPORT XS SIGA
+  //####################################################### JFULL D
+  //                                                        JFULL SIGA
   //                                                        FIELDFUNC    Q
   else if (material_mode == DIFFUSION_MATERIALS_FROM_TRANSPORTXS_TTF_JFULL)
   {
-    //====================================== Setting D and Sigma_a
-    bool transportxs_found = false;
-    for (int p=0; p<material->properties.size(); p++)
-    {
-      if (std::dynamic_pointer_cast<chi_physics::TransportCrossSections>
-          (material->properties[p]))
-      {
-        auto xs = std::static_pointer_cast<chi_physics::TransportCrossSections>(
-          material->properties[p]);
-
-        if (!xs->diffusion_initialized)
-          xs->ComputeDiffusionParameters();
-
-        diffCoeff.assign(cell_dofs,xs->D_jfull);
-        sigmaa.assign(cell_dofs,xs->sigma_a_jfull);
-        transportxs_found = true;
-      }
-    }//for properties
-
-    if (!transportxs_found)
-    {
-      chi_log.Log(LOG_ALLERROR)
-        << "Diffusion Solver: Material encountered with no tranport xs"
-           " yet material mode is DIFFUSION_MATERIALS_FROM_TRANSPORTXS.";
-      exit(EXIT_FAILURE);
-    }
-
-    //====================================== Setting Q
-    if ((q_field != nullptr) and (cell_is_local))
-    {
-      std::vector<uint64_t> mapping;
-//      std::vector<int> pwld_nodes;
-//      std::vector<int> pwld_cells;
-//
-//      for (int i=0; i<cell_dofs; i++)
-//      {
-//        pwld_nodes.push_back(i);
-//        pwld_cells.push_back(cell_local_id);
-//      }
-//
-//      chi_mesh::FieldFunctionInterpolation ffinterp;
-//      ffinterp.grid_view = grid;
-//      ffinterp.CreatePWLDMapping(q_field->num_components,
-//                                 q_field->num_sets,
-//                                 0,0,
-//                                 pwld_nodes,pwld_cells,
-//                                 pwl_sdm->cell_dfem_block_address,
-//                                 mapping);
-
-      std::vector<std::tuple<uint64_t,uint,uint>> cell_node_component_tuples;
-
-      for (int i=0; i<cell_dofs; i++)
-        cell_node_component_tuples.emplace_back(cell_local_id,i,0);
-
-      q_field->CreatePWLDMappingLocal(cell_node_component_tuples, mapping);
-
-      for (int i=0; i<cell_dofs; i++)
-      {
-//        sourceQ[i] = q_field->field_vector_local->operator[](mapping[i]);
-        try {
-          sourceQ[i] = q_field->field_vector_local->at(mapping[i]);
-        }
-        catch (const std::out_of_range& o)
-        {
-          chi_log.Log(LOG_ALLERROR)
-            << "Mapping error i=" << i
-            << " mapping[i]=" << mapping[i]
-            << " g=" << group << "(" << G << ")"
-            << " ffsize=" << q_field->field_vector_local->size()
-            << " dof_count=" << local_dof_count
-            << " cell_loc=" << grid->cells[cell_glob_index].partition_id;
-          exit(EXIT_FAILURE);
-        }
-
-      }
-
-
-    }
-    else if (q_field == nullptr)
-    {
-      chi_log.Log(LOG_ALLERROR)
-        << "Diffusion Solver: Material source set to field function however"
-           " the field is empty or not set.";
-      exit(EXIT_FAILURE);
-    }
-  }//transport xs TTF
-  //####################################################### TRANSPORT XS D
-  //                                                        TRANSPORT XS SIGA
+    mat_data.D.assign(num_groups, xs->D_jfull);
+    mat_data.sigma_a.assign(num_groups, xs->sigma_a_jfull);
+    mat_data.q_from_field = true;
+  }//transport xs TTF JFULL
+  //####################################################### JPART D
+  //                                                        JPART SIGA
   //                                                        FIELDFUNC    Q
   else if (material_mode == DIFFUSION_MATERIALS_FROM_TRANSPORTXS_TTF_JPART)
   {
-    //====================================== Setting D and Sigma_a
-    bool transportxs_found = false;
-    for (int p=0; p<material->properties.size(); p++)
-    {
-      if (std::dynamic_pointer_cast<chi_physics::TransportCrossSections>
-          (material->properties[p]))
-      {
-        auto xs = std::static_pointer_cast<chi_physics::TransportCrossSections>(
-          material->properties[p]);
+    mat_data.D.assign(num_groups, xs->D_jpart);
+    mat_data.sigma_a.assign(num_groups, xs->sigma_a_jpart);
+    mat_data.q_from_field = true;
+  }//transport xs TTF JPART
+  else
+  {
+    chi_log.Log(LOG_0ERROR)
+      << "Diffusion Solver: Invalid material mode.";
+    exit(EXIT_FAILURE);
+  }
 
-        if (!xs->diffusion_initialized)
-          xs->ComputeDiffusionParameters();
+  mat_data.resolved = true;
+  return mat_data;
+}
 
-        diffCoeff.assign(cell_dofs,xs->D_jpart);
-        sigmaa.assign(cell_dofs,xs->sigma_a_jpart);
-        transportxs_found = true;
-      }
-    }//for properties
+//###################################################################
+/**Gets the nodal source of a cell. Field sources are read for local
+ * cells only and require a source field, unless the solver is flagged
+ * as operator_only, in which case the field source is zero.*/
+void chi_diffusion::Solver::GetCellSource(const chi_mesh::Cell& cell,
+                                          const MaterialData& mat_data,
+                                          size_t num_nodes,
+                                          int group,
+                                          std::vector<double>& sourceQ)
+{
+  if (not mat_data.q_from_field)
+  {
+    sourceQ.assign(num_nodes, mat_data.q);
+    return;
+  }
 
-    if (!transportxs_found)
-    {
-      chi_log.Log(LOG_ALLERROR)
-        << "Diffusion Solver: Material encountered with no tranport xs"
-           " yet material mode is DIFFUSION_MATERIALS_FROM_TRANSPORTXS.";
-      exit(EXIT_FAILURE);
-    }
+  sourceQ.assign(num_nodes, 0.0);
+  if (operator_only) return;
 
-    //====================================== Setting Q
-    if ((q_field != nullptr) and (cell_is_local))
-    {
-      std::vector<uint64_t> mapping;
-//      std::vector<int> pwld_nodes;
-//      std::vector<int> pwld_cells;
-//
-//      for (int i=0; i<cell_dofs; i++)
-//      {
-//        pwld_nodes.push_back(i);
-//        pwld_cells.push_back(cell_local_id);
-//      }
-//
-//      chi_mesh::FieldFunctionInterpolation ffinterp;
-//      ffinterp.grid_view = grid;
-//      ffinterp.CreatePWLDMapping(q_field->num_components,
-//                                 q_field->num_sets,
-//                                 0,0,
-//                                 pwld_nodes,pwld_cells,
-//                                 pwl_sdm->cell_dfem_block_address,
-//                                 mapping);
-
-      std::vector<std::tuple<uint64_t,uint,uint>> cell_node_component_tuples;
-
-      for (int i=0; i<cell_dofs; i++)
-        cell_node_component_tuples.emplace_back(cell_local_id,i,0);
-
-      q_field->CreatePWLDMappingLocal(cell_node_component_tuples, mapping);
-
-      for (int i=0; i<cell_dofs; i++)
-      {
-//        sourceQ[i] = q_field->field_vector_local->operator[](mapping[i]);
-        try {
-          sourceQ[i] = q_field->field_vector_local->at(mapping[i]);
-        }
-        catch (const std::out_of_range& o)
-        {
-          chi_log.Log(LOG_ALLERROR)
-            << "Mapping error i=" << i
-            << " mapping[i]=" << mapping[i]
-            << " g=" << group << "(" << G << ")"
-            << " ffsize=" << q_field->field_vector_local->size()
-            << " dof_count=" << local_dof_count
-            << " cell_loc=" << grid->cells[cell_glob_index].partition_id;
-          exit(EXIT_FAILURE);
-        }
+  if (q_field == nullptr)
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Diffusion Solver: Material source set to field function however"
+         " the field is empty or not set.";
+    exit(EXIT_FAILURE);
+  }
 
-      }
+  if (cell.partition_id != chi_mpi.location_id) return;
 
+  //The within-group field has a component per group of the solver, the
+  //others a single component
+  uint component = 0;
+  if (material_mode == DIFFUSION_MATERIALS_FROM_TRANSPORTXS_TTF)
+    component = group - gi;
 
-    }
-    else if (q_field == nullptr)
+  std::vector<std::tuple<uint64_t,uint,uint>> cell_node_component_tuples;
+  cell_node_component_tuples.reserve(num_nodes);
+  for (uint i=0; i<num_nodes; i++)
+    cell_node_component_tuples.emplace_back(cell.local_id,i,component);
+
+  std::vector<uint64_t> mapping;
+  mapping.reserve(num_nodes);
+  q_field->CreatePWLDMappingLocal(cell_node_component_tuples, mapping);
+
+  for (size_t i=0; i<num_nodes; i++)
+  {
+    try { sourceQ[i] = q_field->field_vector_local->at(mapping[i]); }
+    catch (const std::out_of_range& o)
     {
       chi_log.Log(LOG_ALLERROR)
-        << "Diffusion Solver: Material source set to field function however"
-           " the field is empty or not set.";
+        << "Mapping error i=" << i
+        << " mapping[i]=" << mapping[i]
+        << " g=" << group << "(" << G << ")"
+        << " ffsize=" << q_field->field_vector_local->size()
+        << " dof_count=" << local_dof_count
+        << " cell_loc=" << cell.partition_id;
       exit(EXIT_FAILURE);
     }
-  }//transport xs TTF
-  else
-  {
-    chi_log.Log(LOG_0ERROR)
-      << "Diffusion Solver: Invalid material mode.";
-    exit(EXIT_FAILURE);
   }
-
-
 }
@@ -29,6 +29,22 @@ int chi_diffusion::Solver::ExecuteS(bool suppress_assembly,
   VecSet(x,0.0);
   VecSet(b,0.0);
 
+  ResetMaterialData();
+
+  //================================================== Reassembly reuses the
+  //                                                   structure of A. The
+  //                                                   matrix-free operator
+  //                                                   only assembles its
+  //                                                   preconditioner, if any
+  Mat A_assembled_matrix = matrix_free ? P : A;
+  if (!suppress_assembly and A_assembled_matrix != nullptr)
+  {
+    PetscBool A_assembled = PETSC_FALSE;
+    MatAssembled(A_assembled_matrix,&A_assembled);
+    if (A_assembled)
+      MatZeroEntries(A_assembled_matrix);
+  }
+
   if (!suppress_assembly)
     chi_log.Log(LOG_0) << chi_program_timer.GetTimeString() << " "
                        << TextName() << ": Assembling A locally";
@@ -69,6 +85,9 @@ int chi_diffusion::Solver::ExecuteS(bool suppress_assembly,
     exit(EXIT_FAILURE);
   }
 
+  if (!suppress_assembly)
+    assembled_material_data = material_data;
+
   if (!suppress_assembly)
     chi_log.Log(LOG_0) << chi_program_timer.GetTimeString() << " "
                        << TextName() << ": Done Assembling A locally";
@@ -80,12 +99,12 @@ int chi_diffusion::Solver::ExecuteS(bool suppress_assembly,
       << chi_program_timer.GetTimeString() << " "
       << TextName() << ": Communicating matrix assembly";
 
-  if (!suppress_assembly)
+  if (!suppress_assembly and A_assembled_matrix != nullptr)
   {
     chi_log.Log(LOG_0) << chi_program_timer.GetTimeString() << " "
                        << TextName() << ": Assembling A globally";
-    MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);
-    MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);
+    MatAssemblyBegin(A_assembled_matrix,MAT_FINAL_ASSEMBLY);
+    MatAssemblyEnd(A_assembled_matrix,MAT_FINAL_ASSEMBLY);
 
     //================================= Matrix symmetry check
 //    PetscBool is_symmetric;
@@ -96,27 +115,31 @@ int chi_diffusion::Solver::ExecuteS(bool suppress_assembly,
 //        << "Assembled matrix is not symmetric";
 //    }
 
-    //================================= Matrix diagonal check
-    chi_log.Log(LOG_0) << chi_program_timer.GetTimeString() << " "
-                       << TextName() << ": Diagonal check";
-    PetscBool missing_diagonal;
-    PetscInt  row;
-    MatMissingDiagonal(A,&missing_diagonal,&row);
-    if (missing_diagonal)
-      chi_log.Log(LOG_ALLERROR) << chi_program_timer.GetTimeString() << " "
-                                << TextName() << ": Missing diagonal detected";
-
-    //================================= Matrix sparsity info
-    MatInfo info;
-    ierr = MatGetInfo(A,MAT_GLOBAL_SUM,&info);
-
-    chi_log.Log(LOG_0) << "Number of mallocs used = " << info.mallocs
-                       << "\nNumber of non-zeros allocated = "
-                       << info.nz_allocated
-                       << "\nNumber of non-zeros used = "
-                       << info.nz_used
-                       << "\nNumber of unneeded non-zeros = "
-                       << info.nz_unneeded;
+    //================================= Matrix diagonal check and
+    //                                  sparsity info, which are
+    //                                  collective and only informative
+    if (verbose_info || chi_log.GetVerbosity() >= LOG_0VERBOSE_1)
+    {
+      chi_log.Log(LOG_0) << chi_program_timer.GetTimeString() << " "
+                         << TextName() << ": Diagonal check";
+      PetscBool missing_diagonal;
+      PetscInt  row;
+      MatMissingDiagonal(A_assembled_matrix,&missing_diagonal,&row);
+      if (missing_diagonal)
+        chi_log.Log(LOG_ALLERROR) << chi_program_timer.GetTimeString() << " "
+                                  << TextName() << ": Missing diagonal detected";
+
+      MatInfo info;
+      ierr = MatGetInfo(A_assembled_matrix,MAT_GLOBAL_SUM,&info);
+
+      chi_log.Log(LOG_0) << "Number of mallocs used = " << info.mallocs
+                         << "\nNumber of non-zeros allocated = "
+                         << info.nz_allocated
+                         << "\nNumber of non-zeros used = "
+                         << info.nz_used
+                         << "\nNumber of unneeded non-zeros = "
+                         << info.nz_unneeded;
+    }
   }
   if (verbose_info || chi_log.GetVerbosity() >= LOG_0VERBOSE_1)
     chi_log.Log(LOG_0) << chi_program_timer.GetTimeString() << " "
@@ -128,17 +151,23 @@ int chi_diffusion::Solver::ExecuteS(bool suppress_assembly,
 
   time_assembly = t_assembly.GetTime()/1000.0;
 
-  //=================================== Execute solve
-  if (suppress_solve)
+  //=================================== Preconditioner setup
+  //The preconditioner, e.g. the AMG hierarchy, is only rebuilt when the
+  //matrix has been assembled and is otherwise reused by every solve.
+  if (!suppress_assembly)
   {
     chi_log.Log(LOG_0)
       << chi_program_timer.GetTimeString() << " "
       << TextName()
       << ": Setting up solver and preconditioner\n";
+    PCSetReusePreconditioner(pc,PETSC_FALSE);
     PCSetUp(pc);
     KSPSetUp(ksp);
+    PCSetReusePreconditioner(pc,PETSC_TRUE);
   }
-  else
+
+  //=================================== Execute solve
+  if (!suppress_solve)
   {
     if (verbose_info || chi_log.GetVerbosity() >= LOG_0VERBOSE_1)
       chi_log.Log(LOG_0)
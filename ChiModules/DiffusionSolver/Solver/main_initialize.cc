@@ -51,6 +51,12 @@ int chi_diffusion::Solver::Initialize(bool verbose)
         sdm_string + ", specified.");
   }
 
+  matrix_free = basic_options("matrix_free").BoolValue();
+  if (matrix_free and sdm_string == "PWLC")
+    throw std::invalid_argument(
+      TextName() + ": The matrix-free operator is only available for the "
+                   "PWLD_MIP discretizations.");
+
   MPI_Barrier(MPI_COMM_WORLD);
   auto& sdm = discretization;
 
@@ -98,12 +104,15 @@ int chi_diffusion::Solver::Initialize(bool verbose)
 
 
   //================================================== Determine nodal DOF
-  chi_log.Log(LOG_0) << "Building sparsity pattern.";
   std::vector<int64_t> nodal_nnz_in_diag;
   std::vector<int64_t> nodal_nnz_off_diag;
-  sdm->BuildSparsityPattern(nodal_nnz_in_diag,
-                            nodal_nnz_off_diag,
-                            unknown_manager);
+  if (not matrix_free)
+  {
+    chi_log.Log(LOG_0) << "Building sparsity pattern.";
+    sdm->BuildSparsityPattern(nodal_nnz_in_diag,
+                              nodal_nnz_off_diag,
+                              unknown_manager);
+  }
 
   chi_log.Log(LOG_0)
     << chi_program_timer.GetTimeString() << " "
@@ -122,80 +131,95 @@ int chi_diffusion::Solver::Initialize(bool verbose)
   VecSet(b,0.0);
 
   //################################################## Create matrix
-  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
-  ierr = MatSetSizes(A, static_cast<PetscInt>(local_dof_count),
-                        static_cast<PetscInt>(local_dof_count),
-                        static_cast<PetscInt>(global_dof_count),
-                        static_cast<PetscInt>(global_dof_count));CHKERRQ(ierr);
-  ierr = MatSetType(A,MATMPIAIJ);CHKERRQ(ierr);
-
-  //================================================== Allocate matrix memory
-  chi_log.Log(LOG_0) << "Setting matrix preallocation.";
-  MatMPIAIJSetPreallocation(A,0,nodal_nnz_in_diag.data(),
-                            0,nodal_nnz_off_diag.data());
-  MatSetOption(A, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE);
-  MatSetOption(A, MAT_IGNORE_ZERO_ENTRIES, PETSC_TRUE);
-  MatSetUp(A);
+  if (matrix_free)
+    PWLD_InitMatrixFree();
+  else
+  {
+    ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+    ierr = MatSetSizes(A, static_cast<PetscInt>(local_dof_count),
+                          static_cast<PetscInt>(local_dof_count),
+                          static_cast<PetscInt>(global_dof_count),
+                          static_cast<PetscInt>(global_dof_count));CHKERRQ(ierr);
+    ierr = MatSetType(A,MATMPIAIJ);CHKERRQ(ierr);
+
+    //================================================ Allocate matrix memory
+    chi_log.Log(LOG_0) << "Setting matrix preallocation.";
+    MatMPIAIJSetPreallocation(A,0,nodal_nnz_in_diag.data(),
+                              0,nodal_nnz_off_diag.data());
+    MatSetOption(A, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE);
+    MatSetUp(A);
+  }
 
   //================================================== Set up solver
   ierr = KSPCreate(PETSC_COMM_WORLD,&ksp);
-  ierr = KSPSetOperators(ksp,A,A);
+  ierr = KSPSetOperators(ksp,A,(P != nullptr)? P : A);
   ierr = KSPSetType(ksp,KSPCG);
 
   //================================================== Set up preconditioner
   ierr = KSPGetPC(ksp,&pc);
-  PCSetType(pc,PCHYPRE);
+  if (matrix_free)
+  {
+    if (P != nullptr) PCSetType(pc,PCBJACOBI);
+    else              PCSetType(pc,PCJACOBI);
+  }
+  else
+  {
+    PCSetType(pc,PCHYPRE);
 
-  PCHYPRESetType(pc,"boomeramg");
+    PCHYPRESetType(pc,"boomeramg");
+  }
 
   //================================================== Setting Hypre parameters
-  //The default HYPRE parameters used for polyhedra
-  //seemed to have caused a lot of trouble for Slab
-  //geometries. This section makes some custom options
-  //per cell type
-  auto first_cell = &grid->local_cells[0];
-
-  if (first_cell->Type() == chi_mesh::CellType::SLAB)
+  if (not matrix_free)
   {
-    PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_agg_nl 1");
-    PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_P_max 4");
-    PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_grid_sweeps_coarse 1");
+    //The default HYPRE parameters used for polyhedra
+    //seemed to have caused a lot of trouble for Slab
+    //geometries. This section makes some custom options
+    //per cell type
+    auto first_cell = &grid->local_cells[0];
 
-    PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_grid_sweeps_coarse 1");
-    PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_max_levels 25");
-    PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_relax_type_all symmetric-SOR/Jacobi");
-    PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_coarsen_type HMIS");
-    PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_interp_type ext+i");
+    if (first_cell->Type() == chi_mesh::CellType::SLAB)
+    {
+      PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_agg_nl 1");
+      PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_P_max 4");
+      PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_grid_sweeps_coarse 1");
 
-    PetscOptionsInsertString(NULL,"-options_left");
-  }
-  if (first_cell->Type() == chi_mesh::CellType::POLYGON)
-  {
-    PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_strong_threshold 0.6");
+      PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_grid_sweeps_coarse 1");
+      PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_max_levels 25");
+      PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_relax_type_all symmetric-SOR/Jacobi");
+      PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_coarsen_type HMIS");
+      PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_interp_type ext+i");
 
-    //PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_agg_nl 1");
-    PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_P_max 4");
+      PetscOptionsInsertString(NULL,"-options_left");
+    }
+    if (first_cell->Type() == chi_mesh::CellType::POLYGON)
+    {
+      PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_strong_threshold 0.6");
 
-    PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_grid_sweeps_coarse 1");
-    PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_max_levels 25");
-    PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_relax_type_all symmetric-SOR/Jacobi");
-    PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_coarsen_type HMIS");
-    PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_interp_type ext+i");
+      //PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_agg_nl 1");
+      PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_P_max 4");
 
-    PetscOptionsInsertString(NULL,"-options_left");
-  }
-  if (first_cell->Type() == chi_mesh::CellType::POLYHEDRON)
-  {
-    PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_strong_threshold 0.8");
+      PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_grid_sweeps_coarse 1");
+      PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_max_levels 25");
+      PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_relax_type_all symmetric-SOR/Jacobi");
+      PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_coarsen_type HMIS");
+      PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_interp_type ext+i");
 
-    PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_agg_nl 1");
-    PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_P_max 4");
+      PetscOptionsInsertString(NULL,"-options_left");
+    }
+    if (first_cell->Type() == chi_mesh::CellType::POLYHEDRON)
+    {
+      PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_strong_threshold 0.8");
 
-    PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_grid_sweeps_coarse 1");
-    PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_max_levels 25");
-    PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_relax_type_all symmetric-SOR/Jacobi");
-    PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_coarsen_type HMIS");
-    PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_interp_type ext+i");
+      PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_agg_nl 1");
+      PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_P_max 4");
+
+      PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_grid_sweeps_coarse 1");
+      PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_max_levels 25");
+      PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_relax_type_all symmetric-SOR/Jacobi");
+      PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_coarsen_type HMIS");
+      PetscOptionsInsertString(NULL,"-pc_hypre_boomeramg_interp_type ext+i");
+    }
   }
   PetscOptionsInsertString(NULL,options_string.c_str());
   PCSetFromOptions(pc);
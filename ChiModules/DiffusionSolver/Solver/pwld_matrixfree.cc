@@ -0,0 +1,241 @@
+#include "diffusion_solver.h"
+
+#include "chi_log.h"
+extern ChiLog& chi_log;
+
+#include <set>
+
+//###################################################################
+/**Initializes the matrix-free MIP operator: the shell matrix, the
+ * preconditioner matrix and the scatter that gathers the owned dofs of
+ * this location, followed by the ghost dofs on the faces of neighboring
+ * cells owned by other locations, into a sequential vector. The reverse
+ * scatter adds the contributions to ghost rows back to their owners.*/
+void chi_diffusion::Solver::PWLD_InitMatrixFree()
+{
+  auto pwl_sdm = std::static_pointer_cast<SpatialDiscretization_PWLD>(this->discretization);
+
+  const unsigned int num_components = unknown_manager.unknowns.front().num_components;
+
+  PetscInt first_dof, end_dof;
+  VecGetOwnershipRange(x, &first_dof, &end_dof);
+  mf_first_dof = first_dof;
+
+  //============================================= Ghost dofs
+  std::set<PetscInt> ghost_dofs;
+  for (const auto& cell : grid->local_cells)
+    for (const auto& face : cell.faces)
+    {
+      if (not face.has_neighbor) continue;
+      if (grid->IsCellLocal(face.neighbor_id)) continue;
+
+      const auto& adj_cell = pwl_sdm->GetNeighborCell(face.neighbor_id);
+      for (uint64_t vid : face.vertex_ids)
+      {
+        const auto node = MapCellLocalNodeIDFromGlobalID(adj_cell, vid);
+        for (unsigned int c=0; c<num_components; ++c)
+          ghost_dofs.insert(static_cast<PetscInt>(
+            pwl_sdm->MapDOF(adj_cell, node, unknown_manager, 0, c)));
+      }
+    }//for face
+
+  //============================================= Local ordering
+  std::vector<PetscInt> global_indices;
+  global_indices.reserve(local_dof_count + ghost_dofs.size());
+  for (PetscInt i=first_dof; i<end_dof; ++i)
+    global_indices.push_back(i);
+
+  mf_ghost_local_index.clear();
+  for (PetscInt ghost_dof : ghost_dofs)
+  {
+    mf_ghost_local_index[ghost_dof] =
+      static_cast<PetscInt>(global_indices.size());
+    global_indices.push_back(ghost_dof);
+  }
+
+  //============================================= Create scatter
+  const auto num_local_indices = static_cast<PetscInt>(global_indices.size());
+  VecCreateSeq(PETSC_COMM_SELF, num_local_indices, &mf_x_local);
+  VecDuplicate(mf_x_local, &mf_y_local);
+
+  IS global_set;
+  ISCreateGeneral(PETSC_COMM_SELF, num_local_indices, global_indices.data(),
+                  PETSC_COPY_VALUES, &global_set);
+  VecScatterCreate(x, global_set, mf_x_local, nullptr, &mf_scatter);
+  ISDestroy(&global_set);
+
+  chi_log.Log(LOG_0VERBOSE_1)
+    << TextName() << ": Matrix-free operator with "
+    << ghost_dofs.size() << " ghost dofs on location.";
+
+  //============================================= Create shell matrix
+  MatCreateShell(PETSC_COMM_WORLD, static_cast<PetscInt>(local_dof_count),
+                                   static_cast<PetscInt>(local_dof_count),
+                                   static_cast<PetscInt>(global_dof_count),
+                                   static_cast<PetscInt>(global_dof_count),
+                                   this, &A);
+  MatShellSetOperation(A, MATOP_MULT,
+                       (void (*)()) chi_diffusion::MIPMatrixFreeMult);
+  MatShellSetOperation(A, MATOP_GET_DIAGONAL,
+                       (void (*)()) chi_diffusion::MIPMatrixFreeGetDiagonal);
+
+  //============================================= Preconditioner matrix
+  //The CELL_BLOCK preconditioner assembles only the cell self-coupling
+  //blocks of the operator, without the face couplings. Since each block
+  //is dense, block-Jacobi with the default ILU(0) sub-solver inverts them
+  //exactly. JACOBI only needs the diagonal of the shell matrix.
+  const auto pc_type = basic_options("matrix_free_pc").StringValue();
+  if (pc_type == "CELL_BLOCK")
+  {
+    std::vector<PetscInt> nnz_in_diag(local_dof_count, 0);
+    for (const auto& cell : grid->local_cells)
+    {
+      const size_t num_nodes = pwl_sdm->GetCellNumNodes(cell);
+      for (size_t i=0; i<num_nodes; ++i)
+        for (unsigned int c=0; c<num_components; ++c)
+        {
+          const int64_t ir = pwl_sdm->MapDOF(cell, i, unknown_manager, 0, c);
+          nnz_in_diag[ir - first_dof] = static_cast<PetscInt>(num_nodes);
+        }
+    }//for cell
+
+    MatCreate(PETSC_COMM_WORLD, &P);
+    MatSetSizes(P, static_cast<PetscInt>(local_dof_count),
+                   static_cast<PetscInt>(local_dof_count),
+                   static_cast<PetscInt>(global_dof_count),
+                   static_cast<PetscInt>(global_dof_count));
+    MatSetType(P, MATMPIAIJ);
+    MatMPIAIJSetPreallocation(P, 0, nnz_in_diag.data(), 0, nullptr);
+    MatSetOption(P, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE);
+    MatSetUp(P);
+  }
+  else if (pc_type != "JACOBI")
+    throw std::invalid_argument(
+      TextName() + ": Invalid matrix-free preconditioner, " + pc_type +
+      ", specified.");
+}
+
+//###################################################################
+/**Maps a global dof, owned or ghost, to its index in the sequential
+ * matrix-free vectors.*/
+PetscInt chi_diffusion::Solver::
+  MapMatrixFreeLocalIndex(PetscInt global_dof) const
+{
+  const PetscInt local_index = global_dof - mf_first_dof;
+  if (local_index >= 0 and local_index < static_cast<PetscInt>(local_dof_count))
+    return local_index;
+
+  return mf_ghost_local_index.at(global_dof);
+}
+
+//###################################################################
+/**Applies the PWLD MIP operator to x_in, recomputing the element blocks
+ * from the unit integrals, or computes its diagonal when diagonal_only
+ * is set, in which case x_in is not used.*/
+void chi_diffusion::Solver::
+  PWLD_MatrixFreeApply(Vec x_in, Vec y_out, bool diagonal_only)
+{
+  const bool gagg =
+    basic_options("discretization_method").StringValue() == "PWLD_MIP_GAGG";
+  const unsigned int first_component = gagg ? 0  : gi;
+  const int          num_groups      = gagg ? G : 1;
+
+  //============================================= Gather owned and ghost
+  //                                              values
+  const double* x_ref = nullptr;
+  if (not diagonal_only)
+  {
+    VecScatterBegin(mf_scatter, x_in, mf_x_local, INSERT_VALUES, SCATTER_FORWARD);
+    VecScatterEnd  (mf_scatter, x_in, mf_x_local, INSERT_VALUES, SCATTER_FORWARD);
+    VecGetArrayRead(mf_x_local, &x_ref);
+  }
+
+  VecSet(mf_y_local, 0.0);
+  double* y_ref;
+  VecGetArray(mf_y_local, &y_ref);
+
+  //============================================= Block actions
+  std::vector<PetscInt> local_rows;
+  std::vector<PetscInt> local_cols;
+
+  auto apply_block = [this,x_ref,y_ref,&local_rows,&local_cols]
+    (const std::vector<PetscInt>& rows,
+     const std::vector<PetscInt>& cols,
+     const std::vector<double>& values,
+     bool cell_block)
+  {
+    const size_t num_rows = rows.size();
+    const size_t num_cols = cols.size();
+
+    local_rows.resize(num_rows);
+    local_cols.resize(num_cols);
+    for (size_t i=0; i<num_rows; ++i)
+      local_rows[i] = MapMatrixFreeLocalIndex(rows[i]);
+    for (size_t j=0; j<num_cols; ++j)
+      local_cols[j] = MapMatrixFreeLocalIndex(cols[j]);
+
+    for (size_t i=0; i<num_rows; ++i)
+    {
+      double row_sum = 0.0;
+      for (size_t j=0; j<num_cols; ++j)
+        row_sum += values[i*num_cols + j]*x_ref[local_cols[j]];
+      y_ref[local_rows[i]] += row_sum;
+    }
+  };
+
+  auto diagonal_block = [this,y_ref]
+    (const std::vector<PetscInt>& rows,
+     const std::vector<PetscInt>& cols,
+     const std::vector<double>& values,
+     bool cell_block)
+  {
+    if (not cell_block) return;
+
+    const size_t num_rows = rows.size();
+    for (size_t i=0; i<num_rows; ++i)
+      y_ref[MapMatrixFreeLocalIndex(rows[i])] += values[i*num_rows + i];
+  };
+
+  MIPBlockFunction block_function;
+  if (diagonal_only) block_function = diagonal_block;
+  else               block_function = apply_block;
+
+  for (const auto& cell : grid->local_cells)
+    PWLD_ComputeCellBlocks(cell, first_component, gi, num_groups,
+                           block_function, false);
+
+  VecRestoreArray(mf_y_local, &y_ref);
+  if (not diagonal_only)
+    VecRestoreArrayRead(mf_x_local, &x_ref);
+
+  //============================================= Add contributions to their
+  //                                              owners
+  VecSet(y_out, 0.0);
+  VecScatterBegin(mf_scatter, mf_y_local, y_out, ADD_VALUES, SCATTER_REVERSE);
+  VecScatterEnd  (mf_scatter, mf_y_local, y_out, ADD_VALUES, SCATTER_REVERSE);
+}
+
+//###################################################################
+/**Shell matrix multiplication of the matrix-free MIP operator.*/
+PetscErrorCode chi_diffusion::MIPMatrixFreeMult(Mat A, Vec x, Vec y)
+{
+  chi_diffusion::Solver* solver;
+  MatShellGetContext(A, &solver);
+
+  solver->PWLD_MatrixFreeApply(x, y, false);
+
+  return 0;
+}
+
+//###################################################################
+/**Shell matrix diagonal of the matrix-free MIP operator, used by the
+ * Jacobi preconditioner.*/
+PetscErrorCode chi_diffusion::MIPMatrixFreeGetDiagonal(Mat A, Vec diagonal)
+{
+  chi_diffusion::Solver* solver;
+  MatShellGetContext(A, &solver);
+
+  solver->PWLD_MatrixFreeApply(nullptr, diagonal, true);
+
+  return 0;
+}
@@ -23,6 +23,9 @@ namespace chi_diffusion
     PetscInt n,
     PetscReal rnorm,
     KSPConvergedReason* convergedReason, void *monitordestroy);
+
+  PetscErrorCode MIPMatrixFreeMult(Mat A, Vec x, Vec y);
+  PetscErrorCode MIPMatrixFreeGetDiagonal(Mat A, Vec diagonal);
 }
 
 
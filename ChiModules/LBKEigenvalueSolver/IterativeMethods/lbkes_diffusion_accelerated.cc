@@ -0,0 +1,66 @@
+#include "../lbkes_k_eigenvalue_solver.h"
+
+#include "chi_log.h"
+extern ChiLog& chi_log;
+
+using namespace LinearBoltzmann;
+
+//###################################################################
+/**Power iteration in which every transport outer iteration is followed
+ * by the solution of a low-order diffusion eigenproblem that rebalances
+ * the flux, and hence the fission source, of the next outer. See
+ * LowOrderRebalance for the low-order problem.*/
+void KEigenvalueSolver::DiffusionAcceleratedIteration()
+{
+  chi_log.Log(LOG_0)
+      << "\n********** Solving k-eigenvalue problem with "
+      << "the Diffusion Accelerated Power Method.\n";
+
+  phi_old_local.assign(phi_old_local.size(), 1.0);
+
+  double k_eff_prev = k_eff;
+  double k_eff_change = 1.0;
+
+  InitializeOuterIterations();
+  InitLowOrderDiffusion();
+
+  std::vector<double> nodal_fission_old;
+
+  //================================================== Start outer iterations
+  int nit = 0;
+  bool converged = false;
+  while (nit < max_iterations)
+  {
+    CollapseFissionRate(phi_old_local, nodal_fission_old);
+    const double F_old = ComputeFissionProduction(phi_old_local);
+    const double k_old = k_eff;
+
+    TransportOuterIteration();
+
+    //======================================== Recompute k-eigenvalue
+    double F_new = ComputeFissionProduction();
+    k_eff = F_new / F_old * k_old;
+
+    //======================================== Rebalance
+    bool rebalanced = LowOrderRebalance(nodal_fission_old, k_old);
+    phi_old_local = phi_new_local;
+
+    //======================================== Check convergence, book-keeping
+    k_eff_change = fabs(k_eff - k_eff_prev) / k_eff;
+    k_eff_prev = k_eff;
+    nit += 1;
+
+    if (k_eff_change < std::max(tolerance, 1.0e-12))
+      converged = true;
+
+    LogOuterIteration(nit, k_eff_change, converged,
+                      rebalanced ? "" : " (rebalance rejected)");
+
+    if (converged) break;
+  }//for k iterations
+
+  CleanUpLowOrderDiffusion();
+  CleanUpOuterIterations();
+
+  LogSummary(k_eff_change);
+}
@@ -0,0 +1,205 @@
+#include "../lbkes_k_eigenvalue_solver.h"
+
+#include "ChiMath/chi_math.h"
+
+#include "chi_log.h"
+extern ChiLog& chi_log;
+
+#include <deque>
+#include <cmath>
+#include <sstream>
+#include <iomanip>
+
+using namespace LinearBoltzmann;
+
+//###################################################################
+/**Power iteration accelerated with Anderson mixing, also known as the
+ * Nonlinear Krylov Accelerator (NKA).
+ *
+ * One outer iteration, consisting of the fission source evaluation,
+ * the converged inner transport solve and a renormalization of the
+ * result to a fixed fission production, defines the fixed-point map
+ * \f$ G(\phi) \f$. Instead of taking \f$ \phi_{l+1} = G(\phi_l) \f$, as
+ * the power method does, the residuals \f$ f_l = G(\phi_l) - \phi_l \f$
+ * of the last `nka_depth` iterates are combined as
+ * \f[
+ *   \phi_{l+1} = G(\phi_l) - \sum_i \gamma_i \Delta G_i,
+ * \f]
+ * where \f$ \Delta G_i \f$ and \f$ \Delta f_i \f$ are differences of
+ * successive map values and residuals, and \f$ \gamma \f$ minimizes
+ * \f$ || f_l - \sum_i \gamma_i \Delta f_i ||_2 \f$. The small
+ * least-squares problem is solved with the normal equations, which only
+ * requires a single reduction per outer iteration.
+ *
+ * The accelerated iterate lives in the space of all flux moments since
+ * the inner solve needs a complete flux as its scattering source
+ * initial guess.*/
+void KEigenvalueSolver::NonlinearKrylovIteration()
+{
+  chi_log.Log(LOG_0)
+      << "\n********** Solving k-eigenvalue problem with "
+      << "Nonlinear Krylov Acceleration (depth "
+      << nka_depth << ").\n";
+
+  phi_old_local.assign(phi_old_local.size(), 1.0);
+
+  const size_t num_local_dofs = phi_old_local.size();
+
+  double k_eff_prev = k_eff;
+  double k_eff_change = 1.0;
+
+  InitializeOuterIterations();
+
+  //================================================== Normalization
+  std::vector<double> phi = phi_old_local;
+  const double production = ComputeFissionProduction(phi);
+  if (not (production > 0.0))
+  {
+    chi_log.Log(LOG_ALLERROR)
+        << "KEigenvalueSolver: The problem has no fission production.";
+    exit(EXIT_FAILURE);
+  }
+
+  std::vector<double> g_prev, f_prev;
+  std::deque<std::vector<double>> delta_f, delta_g;
+
+  //================================================== Start outer iterations
+  int nit = 0;
+  bool converged = false;
+  while (nit < max_iterations)
+  {
+    //======================================== Apply the fixed-point map
+    phi_old_local = phi;
+    phi_new_local = phi;
+
+    const double F_old = ComputeFissionProduction(phi);
+    TransportOuterIteration();
+    const double F_new = ComputeFissionProduction();
+
+    k_eff = F_new / F_old * k_eff;
+
+    std::vector<double> g = phi_new_local;
+    std::vector<double> f(num_local_dofs, 0.0);
+    const double scale = production / F_new;
+    for (size_t i=0; i<num_local_dofs; ++i)
+    {
+      g[i] *= scale;
+      f[i] = g[i] - phi[i];
+    }
+
+    //======================================== Update the history
+    if (not f_prev.empty())
+    {
+      for (size_t i=0; i<num_local_dofs; ++i)
+      {
+        f_prev[i] = f[i] - f_prev[i];
+        g_prev[i] = g[i] - g_prev[i];
+      }
+      delta_f.push_back(std::move(f_prev));
+      delta_g.push_back(std::move(g_prev));
+      if (delta_f.size() > nka_depth)
+      {
+        delta_f.pop_front();
+        delta_g.pop_front();
+      }
+    }
+
+    //======================================== Form the normal equations
+    //                                         and the residual norms in
+    //                                         a single reduction
+    const size_t m = delta_f.size();
+    std::vector<double> local_dots(m*m + m + 2, 0.0);
+    for (size_t i=0; i<m; ++i)
+    {
+      for (size_t j=0; j<=i; ++j)
+        local_dots[i*m + j] = chi_math::Dot(delta_f[i], delta_f[j]);
+      local_dots[m*m + i] = chi_math::Dot(delta_f[i], f);
+    }
+    local_dots[m*m + m]     = chi_math::Dot(f, f);
+    local_dots[m*m + m + 1] = chi_math::Dot(g, g);
+
+    std::vector<double> dots(local_dots.size(), 0.0);
+    MPI_Allreduce(local_dots.data(), dots.data(),
+                  static_cast<int>(dots.size()),
+                  MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+
+    const double residual = std::sqrt(dots[m*m + m]) /
+                            std::max(std::sqrt(dots[m*m + m + 1]), 1.0e-300);
+
+    //======================================== Anderson update
+    std::vector<double> phi_next = g;
+    bool accelerated = false;
+    if (m > 0)
+    {
+      MatDbl A(m, VecDbl(m, 0.0));
+      VecDbl gamma(m, 0.0);
+      double max_diag = 0.0;
+      for (size_t i=0; i<m; ++i)
+      {
+        for (size_t j=0; j<=i; ++j)
+          A[i][j] = A[j][i] = dots[i*m + j];
+        gamma[i] = dots[m*m + i];
+        max_diag = std::max(max_diag, A[i][i]);
+      }
+
+      if (max_diag > 0.0)
+      {
+        //Small Tikhonov term guarding against nearly dependent columns
+        for (size_t i=0; i<m; ++i) A[i][i] += 1.0e-12*max_diag;
+
+        chi_math::GaussElimination(A, gamma, static_cast<int>(m));
+
+        bool gamma_finite = true;
+        for (double v : gamma) gamma_finite = gamma_finite and std::isfinite(v);
+
+        if (gamma_finite)
+        {
+          for (size_t k=0; k<m; ++k)
+            for (size_t i=0; i<num_local_dofs; ++i)
+              phi_next[i] -= gamma[k] * delta_g[k][i];
+
+          const double F_next = ComputeFissionProduction(phi_next);
+          if (F_next > 0.0 and std::isfinite(F_next))
+          {
+            const double renorm = production / F_next;
+            for (auto& v : phi_next) v *= renorm;
+            accelerated = true;
+          }
+        }
+      }
+
+      //Fall back to the power iterate and restart the history
+      if (not accelerated)
+      {
+        phi_next = g;
+        delta_f.clear();
+        delta_g.clear();
+      }
+    }
+
+    f_prev = std::move(f);
+    g_prev = std::move(g);
+    phi = std::move(phi_next);
+
+    //======================================== Check convergence, book-keeping
+    k_eff_change = fabs(k_eff - k_eff_prev) / k_eff;
+    k_eff_prev = k_eff;
+    nit += 1;
+
+    if (k_eff_change < std::max(tolerance, 1.0e-12))
+      converged = true;
+
+    std::stringstream suffix;
+    suffix << "  residual " << std::setw(10) << residual
+           << ((m > 0 and not accelerated) ? " (restarted)" : "");
+    LogOuterIteration(nit, k_eff_change, converged, suffix.str());
+
+    if (converged) break;
+  }//for k iterations
+
+  //phi_new_local holds the last transport iterate, which is consistent
+  //with k_eff
+  CleanUpOuterIterations();
+
+  LogSummary(k_eff_change);
+}
@@ -13,6 +13,14 @@ using namespace LinearBoltzmann;
 //###################################################################
 /**Compute the total fission production in the problem.*/
 double KEigenvalueSolver::ComputeFissionProduction()
+{
+  return ComputeFissionProduction(phi_new_local);
+}
+
+//###################################################################
+/**Compute the total fission production of the given flux moments.*/
+double KEigenvalueSolver::
+  ComputeFissionProduction(const std::vector<double>& phi)
 {
   typedef SpatialDiscretization_FE  FE;
   const auto grid_fe_view = std::dynamic_pointer_cast<FE>(discretization);
@@ -50,7 +58,7 @@ double KEigenvalueSolver::ComputeFissionProduction()
       //=================================== Loop over groups
       for (size_t g = first_grp; g <= last_grp; ++g)
         local_production += xs->nu_sigma_f[g] *
-                            phi_new_local[uk_map + g] *
+                            phi[uk_map + g] *
                             IntV_ShapeI;
     }//for node
   }//for cell
@@ -0,0 +1,322 @@
+#include "../lbkes_k_eigenvalue_solver.h"
+
+#include "DiffusionSolver/Solver/diffusion_solver.h"
+
+#include "ChiMath/SpatialDiscretization/FiniteElement/PiecewiseLinear/pwl.h"
+
+#include <chi_log.h>
+#include <chi_mpi.h>
+
+extern ChiLog& chi_log;
+extern ChiMPI& chi_mpi;
+
+#include <cmath>
+
+using namespace LinearBoltzmann;
+
+//###################################################################
+/**Initializes the one-group PWLD MIP diffusion operator used by the
+ * low-order eigenproblem. The operator uses the same full Jacobi
+ * collapsed cross-sections as TGDSA. Its original diagonal is stored
+ * since every outer iteration replaces it by a corrected one.*/
+void KEigenvalueSolver::InitLowOrderDiffusion()
+{
+  auto dsolver = new chi_diffusion::Solver("KEigenLowOrder");
+  lo_solver = dsolver;
+
+  dsolver->regions.push_back(this->regions.back());
+  dsolver->discretization = discretization;
+
+  dsolver->basic_options["discretization_method"].SetStringValue("PWLD_MIP");
+  dsolver->basic_options["residual_tolerance"].SetFloatValue(lo_tolerance);
+  dsolver->basic_options["max_iters"].SetIntegerValue(1000);
+
+  dsolver->material_mode = DIFFUSION_MATERIALS_FROM_TRANSPORTXS_TTF_JFULL;
+  dsolver->operator_only = true;
+
+  //================================= Initialize boundaries
+  if (not dsolver->common_items_initialized)
+    dsolver->InitializeCommonItems();
+
+  typedef chi_mesh::sweep_management::BoundaryType SwpBndryType;
+  dsolver->boundaries.clear();
+  for (auto& lbs_bndry : sweep_boundaries)
+  {
+    if (lbs_bndry->Type() == SwpBndryType::REFLECTING)
+      dsolver->boundaries.push_back(new chi_diffusion::BoundaryReflecting());
+    else
+      dsolver->boundaries.push_back(new chi_diffusion::BoundaryDirichlet());
+  }
+
+  dsolver->G  = 1;
+  dsolver->gi = 0;
+
+  //================================= Initialize solver, assemble matrix A
+  //                                  but suppress solution
+  dsolver->Initialize(false);
+  dsolver->ExecuteS(false, true);
+
+  VecDuplicate(dsolver->x, &lo_diagonal);
+  MatGetDiagonal(dsolver->A, lo_diagonal);
+
+  //================================= Lumped nodal volumes
+  typedef SpatialDiscretization_FE  FE;
+  const auto grid_fe_view = std::dynamic_pointer_cast<FE>(discretization);
+
+  lo_node_volumes.clear();
+  lo_node_volumes.reserve(local_node_count);
+  for (const auto& cell : grid->local_cells)
+  {
+    const auto& fe_values = grid_fe_view->GetUnitIntegrals(cell);
+    const int num_nodes = cell_transport_views[cell.local_id].NumNodes();
+    for (int i = 0; i < num_nodes; ++i)
+      lo_node_volumes.push_back(fe_values.IntV_shapeI(i));
+  }
+}
+
+//###################################################################
+/**Cleans up the low-order diffusion operator.*/
+void KEigenvalueSolver::CleanUpLowOrderDiffusion()
+{
+  if (lo_diagonal != nullptr) VecDestroy(&lo_diagonal);
+  lo_diagonal = nullptr;
+
+  delete lo_solver;
+  lo_solver = nullptr;
+
+  lo_node_volumes.clear();
+  lo_node_volumes.shrink_to_fit();
+}
+
+//###################################################################
+/**Collapses the fission rate, \f$ \sum_g \nu\sigma_{f,g} \phi_{g,0} \f$,
+ * of the given flux moments to the nodes of the low-order operator.*/
+void KEigenvalueSolver::
+  CollapseFissionRate(const std::vector<double>& phi,
+                      std::vector<double>& nodal_fission)
+{
+  const size_t first_grp = groups.front().id;
+  const size_t last_grp = groups.back().id;
+
+  nodal_fission.assign(local_node_count, 0.0);
+
+  size_t index = 0;
+  for (const auto& cell : grid->local_cells)
+  {
+    const auto& transport_view = cell_transport_views[cell.local_id];
+    const auto& xs = material_xs[matid_to_xs_map[cell.material_id]];
+
+    const int num_nodes = transport_view.NumNodes();
+    for (int i = 0; i < num_nodes; ++i, ++index)
+    {
+      const size_t uk_map = transport_view.MapDOF(i, 0, 0);
+      for (size_t g = first_grp; g <= last_grp; ++g)
+        nodal_fission[index] += xs->nu_sigma_f[g] * phi[uk_map + g];
+    }
+  }
+}
+
+//###################################################################
+/**Rebalances phi_new_local with the solution of a low-order diffusion
+ * eigenproblem.
+ *
+ * With \f$ \Phi \f$ the group-summed scalar flux of the outer iterate
+ * just computed, \f$ F^l \f$ the nodal fission rate that drove it and
+ * \f$ k^l \f$ the eigenvalue it was divided by, a nodal closure term
+ * \f[
+ *   c = \frac{A\Phi - V F^l/k^l}{\Phi}
+ * \f]
+ * is computed, where \f$ A \f$ is the one-group diffusion operator and
+ * \f$ V \f$ the lumped nodal volumes. The corrected operator
+ * \f$ A - \mathrm{diag}(c) \f$ reproduces the transport balance of the
+ * current iterate exactly, so that the low-order eigenproblem
+ * \f[
+ *   (A - \mathrm{diag}(c)) \Phi = \frac{1}{\lambda} V \nu\Sigma_f \Phi
+ * \f]
+ * has the transport solution as fixed point. It is solved with an inner
+ * power iteration, which is cheap compared to a transport outer, after
+ * which every flux moment of a node is scaled by the ratio of the
+ * low-order and transport scalar fluxes and k_eff is set to
+ * \f$ \lambda \f$.
+ *
+ * The rebalance is rejected, leaving phi_new_local and k_eff untouched,
+ * if the corrected operator loses its positive diagonal or the low-order
+ * solution is not positive. Returns true if the rebalance was applied.*/
+bool KEigenvalueSolver::
+  LowOrderRebalance(const std::vector<double>& nodal_fission_old,
+                    const double k_old)
+{
+  auto dsolver = lo_solver;
+  const size_t num_nodes_local = lo_node_volumes.size();
+  const auto& V = lo_node_volumes;
+
+  const size_t first_grp = groups.front().id;
+  const size_t last_grp = groups.back().id;
+
+  //================================================== Collapse the iterate
+  std::vector<double> phi_ho(num_nodes_local, 0.0);
+  std::vector<double> nu_sigma_f(num_nodes_local, 0.0);
+  CollapseFissionRate(phi_new_local, nu_sigma_f);
+  {
+    size_t index = 0;
+    for (const auto& cell : grid->local_cells)
+    {
+      const auto& transport_view = cell_transport_views[cell.local_id];
+      const int num_nodes = transport_view.NumNodes();
+      for (int i = 0; i < num_nodes; ++i, ++index)
+      {
+        const size_t uk_map = transport_view.MapDOF(i, 0, 0);
+        for (size_t g = first_grp; g <= last_grp; ++g)
+          phi_ho[index] += phi_new_local[uk_map + g];
+
+        nu_sigma_f[index] = (phi_ho[index] > 0.0) ?
+                            nu_sigma_f[index] / phi_ho[index] : 0.0;
+      }
+    }
+  }
+
+  //================================================== Compute the closure
+  //                                                   and correct the
+  //                                                   diagonal
+  Vec diagonal;
+  VecDuplicate(lo_diagonal, &diagonal);
+
+  MatDiagonalSet(dsolver->A, lo_diagonal, INSERT_VALUES);
+  {
+    double* x_ref;
+    VecGetArray(dsolver->x, &x_ref);
+    for (size_t n = 0; n < num_nodes_local; ++n) x_ref[n] = phi_ho[n];
+    VecRestoreArray(dsolver->x, &x_ref);
+  }
+  MatMult(dsolver->A, dsolver->x, dsolver->b);
+
+  int local_valid = 1;
+  {
+    const double* Aphi_ref;
+    const double* diag_ref;
+    double* new_diag_ref;
+    VecGetArrayRead(dsolver->b, &Aphi_ref);
+    VecGetArrayRead(lo_diagonal, &diag_ref);
+    VecGetArray(diagonal, &new_diag_ref);
+    for (size_t n = 0; n < num_nodes_local; ++n)
+    {
+      double c = 0.0;
+      if (phi_ho[n] > 0.0)
+        c = (Aphi_ref[n] - V[n] * nodal_fission_old[n] / k_old) / phi_ho[n];
+
+      new_diag_ref[n] = diag_ref[n] - c;
+      if (not (new_diag_ref[n] > 0.0)) local_valid = 0;
+    }
+    VecRestoreArray(diagonal, &new_diag_ref);
+    VecRestoreArrayRead(lo_diagonal, &diag_ref);
+    VecRestoreArrayRead(dsolver->b, &Aphi_ref);
+  }
+
+  int valid = 0;
+  MPI_Allreduce(&local_valid, &valid, 1, MPI_INT, MPI_LAND, MPI_COMM_WORLD);
+  if (not valid)
+  {
+    VecDestroy(&diagonal);
+    return false;
+  }
+
+  MatDiagonalSet(dsolver->A, diagonal, INSERT_VALUES);
+  VecDestroy(&diagonal);
+  PCSetReusePreconditioner(dsolver->pc, PETSC_FALSE);
+  KSPSetOperators(dsolver->ksp, dsolver->A, dsolver->A);
+
+  //================================================== Low-order power
+  //                                                   iterations
+  auto ComputeProduction = [&V, &nu_sigma_f, num_nodes_local]
+    (const std::vector<double>& phi)
+  {
+    double local_production = 0.0;
+    for (size_t n = 0; n < num_nodes_local; ++n)
+      local_production += V[n] * nu_sigma_f[n] * phi[n];
+
+    double global_production = 0.0;
+    MPI_Allreduce(&local_production, &global_production, 1,
+                  MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    return global_production;
+  };
+
+  std::vector<double> phi_lo = phi_ho;
+  const double production_ho = ComputeProduction(phi_ho);
+  double production = production_ho;
+  double lambda = k_eff;
+
+  for (size_t it = 0; it < lo_max_iterations; ++it)
+  {
+    {
+      double* x_ref;
+      double* b_ref;
+      VecGetArray(dsolver->x, &x_ref);
+      VecGetArray(dsolver->b, &b_ref);
+      for (size_t n = 0; n < num_nodes_local; ++n)
+      {
+        x_ref[n] = phi_lo[n];
+        b_ref[n] = V[n] * nu_sigma_f[n] * phi_lo[n] / lambda;
+      }
+      VecRestoreArray(dsolver->b, &b_ref);
+      VecRestoreArray(dsolver->x, &x_ref);
+    }
+
+    KSPSolve(dsolver->ksp, dsolver->b, dsolver->x);
+
+    KSPConvergedReason reason;
+    KSPGetConvergedReason(dsolver->ksp, &reason);
+    if (reason < 0) return false;
+
+    {
+      const double* x_ref;
+      VecGetArrayRead(dsolver->x, &x_ref);
+      for (size_t n = 0; n < num_nodes_local; ++n) phi_lo[n] = x_ref[n];
+      VecRestoreArrayRead(dsolver->x, &x_ref);
+    }
+
+    const double production_new = ComputeProduction(phi_lo);
+    const double lambda_new = lambda * production_new / production;
+    const double lambda_change = std::fabs(lambda_new - lambda) / lambda_new;
+
+    lambda = lambda_new;
+    production = production_new;
+
+    if (lambda_change < lo_tolerance) break;
+  }
+
+  if (not (lambda > 0.0 and std::isfinite(lambda))) return false;
+
+  //================================================== Check positivity
+  for (size_t n = 0; n < num_nodes_local; ++n)
+    if (phi_ho[n] > 0.0 and not (phi_lo[n] > 0.0)) local_valid = 0;
+
+  MPI_Allreduce(&local_valid, &valid, 1, MPI_INT, MPI_LAND, MPI_COMM_WORLD);
+  if (not valid) return false;
+
+  //================================================== Prolong the low-order
+  //                                                   solution
+  const double normalization = production_ho / production;
+
+  size_t index = 0;
+  for (const auto& cell : grid->local_cells)
+  {
+    const auto& transport_view = cell_transport_views[cell.local_id];
+    const int num_nodes = transport_view.NumNodes();
+    for (int i = 0; i < num_nodes; ++i, ++index)
+    {
+      if (not (phi_ho[index] > 0.0)) continue;
+
+      const double ratio = normalization * phi_lo[index] / phi_ho[index];
+      for (size_t m = 0; m < num_moments; ++m)
+      {
+        const size_t uk_map = transport_view.MapDOF(i, m, 0);
+        for (size_t g = first_grp; g <= last_grp; ++g)
+          phi_new_local[uk_map + g] *= ratio;
+      }
+    }
+  }
+
+  k_eff = lambda;
+
+  return true;
+}
@@ -0,0 +1,139 @@
+#include "../lbkes_k_eigenvalue_solver.h"
+
+#include "chi_log.h"
+extern ChiLog& chi_log;
+
+#include "ChiTimer/chi_timer.h"
+extern ChiTimer chi_program_timer;
+
+#include <iomanip>
+
+namespace sweep_namespace = chi_mesh::sweep_management;
+typedef sweep_namespace::SchedulingAlgorithm SchedulingAlgorithm;
+
+using namespace LinearBoltzmann;
+
+//###################################################################
+/**Builds the sweep orderings, FLUDS, DSA operators, sweep chunks and
+ * sweep schedulers of all groupsets. None of these depend on the flux
+ * and are therefore built once, before the outer iterations, and kept
+ * alive until convergence.*/
+void KEigenvalueSolver::InitializeOuterIterations()
+{
+  sweep_chunks.clear();
+  sweep_schedulers.clear();
+  for (auto& groupset : groupsets)
+  {
+    ComputeSweepOrderings(groupset);
+    InitFluxDataStructures(groupset);
+
+    InitWGDSA(groupset);
+    InitTGDSA(groupset);
+
+    //======================================== Setup sweep chunk
+    sweep_chunks.push_back(SetSweepChunk(groupset));
+    sweep_schedulers.push_back(std::make_unique<MainSweepScheduler>(
+      SchedulingAlgorithm::DEPTH_OF_GRAPH,
+      groupset.angle_agg,
+      *sweep_chunks.back(),
+      options.num_sweep_threads));
+
+    if (groupset.log_sweep_events)
+      sweep_schedulers.back()->sweep_trace.Enable();
+  }
+}
+
+//###################################################################
+/**Performs a single outer iteration. The fission source is computed from
+ * phi_old_local and divided by k_eff, after which the scattering source of
+ * every groupset is converged. On return phi_new_local holds the new
+ * flux moments.*/
+void KEigenvalueSolver::TransportOuterIteration()
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+  for (size_t gs=0; gs<groupsets.size(); ++gs)
+  {
+    auto& groupset        = groupsets[gs];
+    auto& sweep_scheduler = *sweep_schedulers[gs];
+
+    //======================================== Precompute the fission source
+    q_moments_local.assign(q_moments_local.size(), 0.0);
+    SetSource(groupset, q_moments_local,
+              APPLY_AGS_FISSION_SOURCE |
+              APPLY_WGS_FISSION_SOURCE);
+
+    //normalize q by k_eff
+    for (auto& q : q_moments_local) q /= k_eff;
+
+    //======================================== Converge the scattering source
+    //                                         with a fixed fission source
+    if (groupset.iterative_method == IterativeMethod::CLASSICRICHARDSON)
+    {
+      ClassicRichardson(groupset, sweep_scheduler,
+                        APPLY_WGS_SCATTER_SOURCE |
+                        APPLY_AGS_SCATTER_SOURCE,
+                        options.verbose_inner_iterations);
+    }
+    else if (groupset.iterative_method == IterativeMethod::GMRES)
+    {
+      GMRES(groupset, sweep_scheduler,
+            APPLY_WGS_SCATTER_SOURCE,
+            APPLY_AGS_SCATTER_SOURCE,
+            options.verbose_inner_iterations);
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+  }//for groupset
+}
+
+//###################################################################
+/**Releases the items built by InitializeOuterIterations.*/
+void KEigenvalueSolver::CleanUpOuterIterations()
+{
+  sweep_schedulers.clear();
+  sweep_chunks.clear();
+  for (auto& groupset : groupsets)
+  {
+    CleanUpWGDSA(groupset);
+    CleanUpTGDSA(groupset);
+
+    ResetSweepOrderings(groupset);
+  }
+}
+
+//###################################################################
+/**Prints the summary of an outer iteration.*/
+void KEigenvalueSolver::LogOuterIteration(size_t nit, double k_eff_change,
+                                          bool converged,
+                                          const std::string& suffix)
+{
+  if (not options.verbose_outer_iterations) return;
+
+  double reactivity = (k_eff - 1.0) / k_eff;
+
+  std::stringstream k_iter_info;
+  k_iter_info
+      << chi_program_timer.GetTimeString() << " "
+      << "  Iteration " << std::setw(5) << nit
+      << "  k_eff " << std::setw(10) << k_eff
+      << "  k_eff change " << std::setw(10) << k_eff_change
+      << "  reactivity " << std::setw(10) << reactivity * 1e5
+      << suffix;
+  if (converged) k_iter_info << " CONVERGED\n";
+
+  chi_log.Log(LOG_0) << k_iter_info.str();
+}
+
+//###################################################################
+/**Prints the final k-eigenvalue.*/
+void KEigenvalueSolver::LogSummary(double k_eff_change)
+{
+  chi_log.Log(LOG_0) << "\n";
+  chi_log.Log(LOG_0)
+      << "        Final k-eigenvalue    :        "
+      << std::setprecision(6) << k_eff;
+  chi_log.Log(LOG_0)
+      << "        Final change          :        "
+      << std::setprecision(6) << k_eff_change;
+  chi_log.Log(LOG_0) << "\n";
+}
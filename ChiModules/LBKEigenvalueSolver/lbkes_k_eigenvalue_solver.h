@@ -6,9 +6,22 @@
 
 #include <string>
 
+namespace chi_diffusion
+{
+  class Solver;
+}
+
 namespace LinearBoltzmann
 {
 
+/**Outer iteration schemes available to the k-eigenvalue solver.*/
+enum class KEigenMethod : int
+{
+  POWER_ITERATION       = 1, ///< Unaccelerated power iteration
+  NONLINEAR_KRYLOV      = 2, ///< Anderson/NKA accelerated power iteration
+  DIFFUSION_ACCELERATED = 3  ///< Low-order diffusion eigenvalue rebalance
+};
+
 /**A k-eigenvalue linear boltzmann transport solver.*/
 class KEigenvalueSolver : public LinearBoltzmann::Solver
 {
@@ -20,6 +33,23 @@ public:
   size_t max_iterations = 1000;
   double tolerance = 1.0e-8;
 
+  KEigenMethod method = KEigenMethod::POWER_ITERATION;
+
+  /**Number of previous iterates used by the nonlinear Krylov method.*/
+  size_t nka_depth = 5;
+
+  /**Iterative parameters of the low-order diffusion eigenproblem.*/
+  size_t lo_max_iterations = 200;
+  double lo_tolerance = 1.0e-10;
+
+private:
+  std::vector<std::shared_ptr<SweepChunk>>         sweep_chunks;
+  std::vector<std::unique_ptr<MainSweepScheduler>> sweep_schedulers;
+
+  chi_diffusion::Solver* lo_solver = nullptr;
+  Vec                    lo_diagonal = nullptr;
+  std::vector<double>    lo_node_volumes;
+
 public:
   explicit KEigenvalueSolver(const std::string& in_text_name) :
     LinearBoltzmann::Solver(in_text_name) {}
@@ -28,9 +58,26 @@ public:
 
   // IterativeMethods
   void PowerIteration();
+  void NonlinearKrylovIteration();
+  void DiffusionAcceleratedIteration();
 
   // Iterative operations
   double ComputeFissionProduction();
+  double ComputeFissionProduction(const std::vector<double>& phi);
+
+  void InitializeOuterIterations();
+  void TransportOuterIteration();
+  void CleanUpOuterIterations();
+  void LogOuterIteration(size_t nit, double k_eff_change,
+                         bool converged, const std::string& suffix="");
+  void LogSummary(double k_eff_change);
+
+  void InitLowOrderDiffusion();
+  void CleanUpLowOrderDiffusion();
+  void CollapseFissionRate(const std::vector<double>& phi,
+                           std::vector<double>& nodal_fission);
+  bool LowOrderRebalance(const std::vector<double>& nodal_fission_old,
+                         double k_old);
 };
 
 }
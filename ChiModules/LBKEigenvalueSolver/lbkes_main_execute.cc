@@ -11,8 +11,20 @@ using namespace LinearBoltzmann;
 /**Execute a k-eigenvalue linear boltzmann solver.*/
 void KEigenvalueSolver::Execute()
 {
+  //======================================== Cross-sections may have been
+  //                                         changed since initialization
+  InitSourceOperators();
+
   //======================================== Solve the k-eigenvalue problem
-  PowerIteration();
+  switch (method)
+  {
+    case KEigenMethod::NONLINEAR_KRYLOV:
+      NonlinearKrylovIteration(); break;
+    case KEigenMethod::DIFFUSION_ACCELERATED:
+      DiffusionAcceleratedIteration(); break;
+    default:
+      PowerIteration();
+  }
 
   //======================================== Initialize the precursors
   if (options.use_precursors)
@@ -6,13 +6,54 @@
 #include <chi_log.h>
 extern ChiLog& chi_log;
 
-#define MAX_ITERATIONS  1
-#define TOLERANCE       2
+#define MAX_ITERATIONS    1
+#define TOLERANCE         2
+#define K_EIGEN_METHOD    3
+#define NKA_DEPTH         4
+#define LO_MAX_ITERATIONS 5
+#define LO_TOLERANCE      6
 
 using namespace LinearBoltzmann;
 
 //############################################################
-/**Set properties for the solver.*/
+/**Set properties for the solver.
+
+\param SolverIndex int Handle to the solver.
+\param PropertyIndex int Code for a specific property.
+
+##_
+
+###PropertyIndex\n
+MAX_ITERATIONS\n
+ Maximum number of outer iterations. Expects to be followed by an
+ integer greater than 0.\n\n
+
+TOLERANCE\n
+ Convergence tolerance on the change in k_eff. Expects to be followed by
+ a float in the range (0.0, 1.0].\n\n
+
+K_EIGEN_METHOD\n
+ Outer iteration scheme. Expects to be followed by one of:\n
+ - KEIGEN_POWER_ITERATION, unaccelerated power iteration (default),\n
+ - KEIGEN_NONLINEAR_KRYLOV, power iteration accelerated with Anderson
+   mixing (NKA),\n
+ - KEIGEN_DIFFUSION_ACCELERATED, power iteration rebalanced every outer
+   by a one-group diffusion eigenproblem.\n\n
+
+NKA_DEPTH\n
+ Number of previous iterates used by KEIGEN_NONLINEAR_KRYLOV. Expects to
+ be followed by an integer greater than 0. Default 5.\n\n
+
+LO_MAX_ITERATIONS\n
+ Maximum number of power iterations on the low-order eigenproblem of
+ KEIGEN_DIFFUSION_ACCELERATED. Expects to be followed by an integer
+ greater than 0. Default 200.\n\n
+
+LO_TOLERANCE\n
+ Convergence tolerance of the low-order eigenproblem and its linear
+ solves. Expects to be followed by a float in the range (0.0, 1.0].
+ Default 1.0e-10.\n\n
+*/
 int chiLBKESSetProperty(lua_State *L)
 {
   int num_args = lua_gettop(L);
@@ -69,6 +110,84 @@ int chiLBKESSetProperty(lua_State *L)
         << "LinearBoltzmann::KEigenvalueSolver: "
         << "tolerance set to " << buff << ".";
   }
+  else if (property == K_EIGEN_METHOD)
+  {
+    LuaCheckNilValue(__FUNCTION__, L, 3);
+    int method = lua_tointeger(L, 3);
+
+    if (method < static_cast<int>(KEigenMethod::POWER_ITERATION) or
+        method > static_cast<int>(KEigenMethod::DIFFUSION_ACCELERATED))
+    {
+      chi_log.Log(LOG_ALLERROR)
+          << __FUNCTION__ << ": Invalid k-eigenvalue method.";
+      exit(EXIT_FAILURE);
+    }
+    solver->method = static_cast<KEigenMethod>(method);
+
+    chi_log.Log(LOG_0)
+        << "LinearBoltzmann::KEigenvalueSolver: "
+        << "method set to " << method << ".";
+  }
+
+  else if (property == NKA_DEPTH)
+  {
+    LuaCheckNilValue(__FUNCTION__, L, 3);
+    int depth = lua_tointeger(L, 3);
+
+    if (depth <= 0)
+    {
+      chi_log.Log(LOG_ALLERROR)
+          << __FUNCTION__ << ": Invalid NKA depth. "
+          << "Must be greater than 0.";
+      exit(EXIT_FAILURE);
+    }
+    solver->nka_depth = static_cast<size_t>(depth);
+
+    chi_log.Log(LOG_0)
+        << "LinearBoltzmann::KEigenvalueSolver: "
+        << "nka_depth set to " << solver->nka_depth << ".";
+  }
+
+  else if (property == LO_MAX_ITERATIONS)
+  {
+    LuaCheckNilValue(__FUNCTION__, L, 3);
+    int max_iters = lua_tointeger(L, 3);
+
+    if (max_iters <= 0)
+    {
+      chi_log.Log(LOG_ALLERROR)
+          << __FUNCTION__ << ": Invalid lo_max_iterations value. "
+          << "Must be greater than 0.";
+      exit(EXIT_FAILURE);
+    }
+    solver->lo_max_iterations = static_cast<size_t>(max_iters);
+
+    chi_log.Log(LOG_0)
+        << "LinearBoltzmann::KEigenvalueSolver: "
+        << "lo_max_iterations set to " << solver->lo_max_iterations << ".";
+  }
+
+  else if (property == LO_TOLERANCE)
+  {
+    LuaCheckNilValue(__FUNCTION__, L, 3);
+    double tol = lua_tonumber(L, 3);
+
+    if (tol <= 0.0 or tol > 1.0)
+    {
+      chi_log.Log(LOG_ALLERROR)
+          << __FUNCTION__ << ": Invalid value for lo_tolerance. "
+          << "Must be in the range (0.0, 1.0].";
+      exit(EXIT_FAILURE);
+    }
+    solver->lo_tolerance = tol;
+
+    char buff[100];
+    sprintf(buff, "%.4e", tol);
+
+    chi_log.Log(LOG_0)
+        << "LinearBoltzmann::KEigenvalueSolver: "
+        << "lo_tolerance set to " << buff << ".";
+  }
   else
   {
     chi_log.Log(LOG_ALLERROR)
@@ -6,3 +6,11 @@ RegisterFunction(chiLBKESSetProperty);
 
 RegisterConstant(MAX_ITERATIONS, 1)
 RegisterConstant(TOLERANCE, 2)
+RegisterConstant(K_EIGEN_METHOD, 3)
+RegisterConstant(NKA_DEPTH, 4)
+RegisterConstant(LO_MAX_ITERATIONS, 5)
+RegisterConstant(LO_TOLERANCE, 6)
+
+RegisterConstant(KEIGEN_POWER_ITERATION, 1)
+RegisterConstant(KEIGEN_NONLINEAR_KRYLOV, 2)
+RegisterConstant(KEIGEN_DIFFUSION_ACCELERATED, 3)
@@ -1,4 +1,5 @@
 #include "LBSCurvilinear/lbs_curvilinear_sweepchunk_pwl.h"
+#include "LinearBoltzmannSolver/SweepChunks/lbs_sweepchunk_pwl_kernels.h"
 
 #include "ChiMath/Quadratures/curvilinear_angular_quadrature.h"
 
@@ -74,8 +75,8 @@ LBSCurvilinear::SweepChunkPWL::Sweep(chi_mesh::sweep_management::AngleSet* angle
 {
   if (!a_and_b_initialized)
   {
-    Amat.resize(max_num_cell_dofs, std::vector<double>(max_num_cell_dofs));
-    Atemp.resize(max_num_cell_dofs, std::vector<double>(max_num_cell_dofs));
+    Amat.resize(max_num_cell_dofs * max_num_cell_dofs, 0.0);
+    Atemp.resize(max_num_cell_dofs * max_num_cell_dofs, 0.0);
     b.resize(num_grps, std::vector<double>(max_num_cell_dofs, 0.0));
     source.resize(max_num_cell_dofs, 0.0);
     a_and_b_initialized = true;
@@ -149,7 +150,7 @@ LBSCurvilinear::SweepChunkPWL::Sweep(chi_mesh::sweep_management::AngleSet* angle
       // ============================================ Gradient matrix
       for (size_t i = 0; i < num_nodes; ++i)
         for (size_t j = 0; j < num_nodes; ++j)
-          Amat[i][j] = omega.Dot(G[i][j]) + fac_streaming_operator * Maux[i][j];
+          Amat[i * num_nodes + j] = omega.Dot(G[i][j]) + fac_streaming_operator * Maux[i][j];
 
 
       // ============================================ Source initialization
@@ -189,7 +190,7 @@ LBSCurvilinear::SweepChunkPWL::Sweep(chi_mesh::sweep_management::AngleSet* angle
                 const int j = fe_intgrl_values.FaceDofMapping(f,fj);
                 const double *psi = fluds->UpwindPsi(spls_index,in_face_counter,fj,0,angle_set_index);
                 const double mu_Nij = -mu * M_surf[f][i][j];
-                Amat[i][j] += mu_Nij;
+                Amat[i * num_nodes + j] += mu_Nij;
                 for (int gsg = 0; gsg < gs_ss_size; ++gsg)
                   b[gsg][i] += psi[gsg]*mu_Nij;
               }
@@ -206,7 +207,7 @@ LBSCurvilinear::SweepChunkPWL::Sweep(chi_mesh::sweep_management::AngleSet* angle
                 const int j = fe_intgrl_values.FaceDofMapping(f,fj);
                 const double *psi = fluds->NLUpwindPsi(preloc_face_counter,fj,0,angle_set_index);
                 const double mu_Nij = -mu * M_surf[f][i][j];
-                Amat[i][j] += mu_Nij;
+                Amat[i * num_nodes + j] += mu_Nij;
                 for (int gsg = 0; gsg < gs_ss_size; ++gsg)
                   b[gsg][i] += psi[gsg]*mu_Nij;
               }
@@ -241,7 +242,7 @@ LBSCurvilinear::SweepChunkPWL::Sweep(chi_mesh::sweep_management::AngleSet* angle
                                                           f, fj, gs_gi, gs_ss_begin,
                                                           surface_source_active);
                   const double mu_Nij = -mu * M_surf[f][i][j];
-                  Amat[i][j] += mu_Nij;
+                  Amat[i * num_nodes + j] += mu_Nij;
                   for (int gsg = 0; gsg < gs_ss_size; ++gsg)
                     b[gsg][i] += psi[gsg]*mu_Nij;
                 }
@@ -258,7 +259,7 @@ LBSCurvilinear::SweepChunkPWL::Sweep(chi_mesh::sweep_management::AngleSet* angle
                   const auto jr = grid_fe_view.MapDOFLocal(cell, j, unknown_manager, polar_level, gs_gi);
                   const double* psi = &psi_start[jr];
                   const double mu_Nij = -mu * M_surf[f][i][j];
-                  Amat[i][j] += mu_Nij;
+                  Amat[i * num_nodes + j] += mu_Nij;
                   for (int gsg = 0; gsg < gs_ss_size; ++gsg)
                     b[gsg][i] += psi[gsg]*mu_Nij;
                 }
@@ -292,12 +293,14 @@ LBSCurvilinear::SweepChunkPWL::Sweep(chi_mesh::sweep_management::AngleSet* angle
         for (size_t i = 0; i < num_nodes; ++i)
           for (size_t j = 0; j < num_nodes; ++j)
           {
-            Atemp[i][j] = Amat[i][j] + M[i][j] * sigma_tgr;
+            Atemp[i * num_nodes + j] = Amat[i * num_nodes + j] + M[i][j] * sigma_tgr;
             b[gsg][i] += M[i][j] * source[j];
           }
 
         // ============================= Solve system
-        chi_math::GaussElimination(Atemp, b[gsg], num_nodes);
+        LinearBoltzmann::sweep_kernels::GaussElimination(Atemp.data(),
+                                                         b[gsg].data(),
+                                                         num_nodes);
       }
 
 
@@ -48,6 +48,13 @@ public:
                 int in_max_num_cell_dofs);
 
   void Sweep(chi_mesh::sweep_management::AngleSet* angle_set) override;
+
+  /** The angular redistribution couples the directions of consecutive
+   *  angle sets through psi_sweep, hence they cannot be swept
+   *  concurrently. */
+  std::shared_ptr<chi_mesh::sweep_management::SweepChunk>
+    MakeWorkerChunk(std::vector<double>& worker_destination_phi) override
+  { return nullptr; }
 };
 
 #endif // LBS_CURVILINEAR_SWEEPCHUNK_PWL_H
@@ -178,8 +178,11 @@ void LBSGroupset::BuildSubsets()
 }
 
 //###################################################################
-/**Constructs the groupset subsets.*/
-void LBSGroupset::PrintSweepInfoFile(size_t ev_tag, const std::string& file_name)
+/**Writes the angle sets and the sweep trace of this groupset to a
+ * file. Only active when sweep event logging is enabled.*/
+void LBSGroupset::PrintSweepInfoFile(
+  const chi_mesh::sweep_management::SweepTrace& sweep_trace,
+  const std::string& file_name)
 {
   if (not log_sweep_events) return;
 
@@ -217,8 +220,8 @@ void LBSGroupset::PrintSweepInfoFile(size_t ev_tag, const std::string& file_name
     }
   }
 
-  //======================================== Print event history
-  ofile << chi_log.PrintEventHistory(ev_tag);
+  //======================================== Print sweep trace
+  sweep_trace.WriteRecords(ofile);
 
   ofile.close();
 }
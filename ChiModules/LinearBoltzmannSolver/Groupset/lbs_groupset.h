@@ -9,6 +9,7 @@
 #include "ChiMath/UnknownManager/unknown_manager.h"
 
 #include "ChiMesh/SweepUtilities/AngleAggregation/angleaggregation.h"
+#include "ChiMesh/SweepUtilities/SweepScheduler/sweep_trace.h"
 
 #include "../lbs_structs.h"
 
@@ -85,7 +86,9 @@ public:
                             LinearBoltzmann::GeometryType geometry_type);
   void BuildSubsets();
 public:
-  void PrintSweepInfoFile(size_t ev_tag,const std::string& file_name);
+  void PrintSweepInfoFile(
+    const chi_mesh::sweep_management::SweepTrace& sweep_trace,
+    const std::string& file_name);
 };
 
 #endif
@@ -165,8 +165,8 @@ bool LinearBoltzmann::Solver::GMRES(LBSGroupset& groupset,
       << "GMRES solver failed. "
       << "Reason: " << chi_physics::GetPETScConvergedReasonstring(reason);
 
-  SetSTLvectorFromPETScVec(groupset, phi_new, phi_new_local, WITH_DELAYED_PSI);
-  SetSTLvectorFromPETScVec(groupset, phi_new, phi_old_local, WITH_DELAYED_PSI);
+  SetSTLvectorsFromPETScVec(groupset, phi_new, phi_new_local, phi_old_local,
+                            WITH_DELAYED_PSI);
 
   //================================================== Perform final sweep
   //                                                   with converged phi and
@@ -230,7 +230,7 @@ bool LinearBoltzmann::Solver::GMRES(LBSGroupset& groupset,
           std::string("GS_") + std::to_string(groupset.id) +
           std::string("_SweepLog_") + std::to_string(chi_mpi.location_id) +
           std::string(".log");
-      groupset.PrintSweepInfoFile(sweep_scheduler.sweep_event_tag,
+      groupset.PrintSweepInfoFile(sweep_scheduler.sweep_trace,
                                   sweep_log_file_name);
     }
   }
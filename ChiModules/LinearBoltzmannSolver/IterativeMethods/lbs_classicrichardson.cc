@@ -66,9 +66,7 @@ ClassicRichardson(LBSGroupset& groupset,
       DisAssembleTGDSADeltaPhiVector(groupset, phi_new_local.data());
     }
 
-    double pw_change = ComputePiecewiseChange(groupset);
-
-    ScopedCopySTLvectors(groupset, phi_new_local, phi_old_local);
+    double pw_change = ComputePiecewiseChangeAndUpdate(groupset);
 
     double rho = sqrt(pw_change / pw_change_prev);
     pw_change_prev = pw_change;
@@ -107,13 +105,9 @@ ClassicRichardson(LBSGroupset& groupset,
 
       if (options.write_restart_data)
       {
-        if ((chi_program_timer.GetTime()/60000.0) >
-            last_restart_write+options.write_restart_interval)
-        {
-          last_restart_write = chi_program_timer.GetTime()/60000.0;
-          WriteRestartData(options.write_restart_folder_name,
-                           options.write_restart_file_base);
-        }
+        checkpoint_writer.Poll();
+        if (RestartWriteIntervalElapsed())
+          SubmitRestartCheckpoint();
       }//if write restart data
     }//print iterative info
 
@@ -153,7 +147,7 @@ ClassicRichardson(LBSGroupset& groupset,
           std::string("GS_") + std::to_string(groupset.id) +
           std::string("_SweepLog_") + std::to_string(chi_mpi.location_id) +
           std::string(".log");
-      groupset.PrintSweepInfoFile(sweep_scheduler.sweep_event_tag, sweep_log_file_name);
+      groupset.PrintSweepInfoFile(sweep_scheduler.sweep_trace, sweep_log_file_name);
     }
   }//print solution info
 
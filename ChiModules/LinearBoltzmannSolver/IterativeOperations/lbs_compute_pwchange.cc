@@ -1,48 +1,70 @@
 #include "../lbs_linear_boltzmann_solver.h"
 #include <ChiMesh/Cell/cell.h>
 
+namespace
+{
 //###################################################################
-/**Computes the point wise change between phi_new and phi_old.*/
-double LinearBoltzmann::Solver::ComputePiecewiseChange(LBSGroupset& groupset)
+/**Computes the point wise change between phi and phi_ref over a span
+ * of the flux-moment vectors, relative to the larger magnitude of the
+ * zeroth moments at each node and group. When copy_destination is not
+ * null, the entries of phi over the span are copied into it in the same
+ * pass, which may overwrite phi_ref since the zeroth moments of a node
+ * are read before any of its blocks are copied.*/
+double SpanPiecewiseChange(const LinearBoltzmann::FluxMomentSpan& span,
+                           size_t num_moments,
+                           const double* phi,
+                           const double* phi_ref,
+                           double* copy_destination)
 {
-  double pw_change = 0.0;
-  double sum_m0 = 0.0;
+  const size_t block_size = span.block_size;
+  const size_t num_nodes  = span.num_blocks/num_moments;
+  const size_t node_stride = num_moments*span.stride;
 
-  int gsi = groupset.groups[0].id;
-  int gsf = groupset.groups.back().id;
-  int deltag = groupset.groups.size();
+  std::vector<double> max_phi_m0(block_size, 0.0);
 
-  for (const auto& cell : grid->local_cells)
+  double pw_change = 0.0;
+  for (size_t n=0; n<num_nodes; ++n)
   {
-    auto& transport_view = cell_transport_views[cell.local_id];
+    const size_t node_first = span.first_index + n*node_stride;
+
+    for (size_t g=0; g<block_size; ++g)
+      max_phi_m0[g] = std::max(std::fabs(phi[node_first + g]),
+                               std::fabs(phi_ref[node_first + g]));
 
-    for (int i=0; i < cell.vertex_ids.size(); i++)
+    for (size_t m=0; m<num_moments; ++m)
     {
-      for (int m=0; m<num_moments; m++)
-      {
-        size_t mapping = transport_view.MapDOF(i,m,gsi);
-        double* phi_new_m = &phi_new_local.data()[mapping];
-        double* phi_old_m = &phi_old_local.data()[mapping];
+      const size_t first = node_first + m*span.stride;
 
-        for (int g=0; g<deltag; g++)
-        {
-          size_t map0 = transport_view.MapDOF(i,0,gsi+g);
+      for (size_t g=0; g<block_size; ++g)
+      {
+        const double max_phi   = max_phi_m0[g];
+        const double delta_phi = std::fabs(phi[first + g] - phi_ref[first + g]);
 
-          double abs_phi_m0     = fabs(phi_new_local[map0]);
-          double abs_phi_old_m0 = fabs(phi_old_local[map0]);
-          double max_phi = std::max(abs_phi_m0,abs_phi_old_m0);
+        if (max_phi >= std::numeric_limits<double>::min())
+          pw_change = std::max(delta_phi/max_phi,pw_change);
+        else
+          pw_change = std::max(delta_phi,pw_change);
+      }//for g
 
-          double delta_phi = std::fabs(phi_new_m[g] - phi_old_m[g]);
+      if (copy_destination != nullptr)
+        std::copy(phi + first, phi + first + block_size,
+                  copy_destination + first);
+    }//for m
+  }//for n
 
-          if (max_phi >= std::numeric_limits<double>::min())
-            pw_change = std::max(delta_phi/max_phi,pw_change);
-          else
-            pw_change = std::max(delta_phi,pw_change);
+  return pw_change;
+}
+}//namespace
 
-        }//for g
-      }//for m
-    }//for i
-  }//for c
+//###################################################################
+/**Computes the point wise change between phi_new and phi_old.*/
+double LinearBoltzmann::Solver::ComputePiecewiseChange(LBSGroupset& groupset)
+{
+  double pw_change = SpanPiecewiseChange(GetFluxMomentSpan(groupset),
+                                         num_moments,
+                                         phi_new_local.data(),
+                                         phi_old_local.data(),
+                                         nullptr);
 
 //  const real8 abs_phi_0 = fabs(phi_0);
 //  const real8 abs_old_phi_0 = fabs(old_phi_0);
@@ -56,4 +78,44 @@ double LinearBoltzmann::Solver::ComputePiecewiseChange(LBSGroupset& groupset)
   MPI_Allreduce(&pw_change,&global_pw_change,1,MPI_DOUBLE,MPI_MAX,MPI_COMM_WORLD);
 
   return global_pw_change;
-}
\ No newline at end of file
+}
+
+//###################################################################
+/**Computes the point wise change between phi_new and phi_old and,
+ * in the same pass, copies phi_new into phi_old over the groupset.
+ * Equivalent to ComputePiecewiseChange followed by ScopedCopySTLvectors.*/
+double LinearBoltzmann::Solver::
+  ComputePiecewiseChangeAndUpdate(LBSGroupset& groupset)
+{
+  double pw_change = SpanPiecewiseChange(GetFluxMomentSpan(groupset),
+                                         num_moments,
+                                         phi_new_local.data(),
+                                         phi_old_local.data(),
+                                         phi_old_local.data());
+
+  double global_pw_change = 0.0;
+
+  MPI_Allreduce(&pw_change,&global_pw_change,1,MPI_DOUBLE,MPI_MAX,MPI_COMM_WORLD);
+
+  return global_pw_change;
+}
+
+//###################################################################
+/**Computes the point wise change between phi_old and the flux
+ * moments, over all groups, of the previous across-groupset
+ * iteration.*/
+double LinearBoltzmann::Solver::
+  ComputeAGSPiecewiseChange(const std::vector<double>& ref_phi_prev)
+{
+  double pw_change = SpanPiecewiseChange(GetFluxMomentSpan(0, num_groups),
+                                         num_moments,
+                                         phi_old_local.data(),
+                                         ref_phi_prev.data(),
+                                         nullptr);
+
+  double global_pw_change = 0.0;
+
+  MPI_Allreduce(&pw_change,&global_pw_change,1,MPI_DOUBLE,MPI_MAX,MPI_COMM_WORLD);
+
+  return global_pw_change;
+}
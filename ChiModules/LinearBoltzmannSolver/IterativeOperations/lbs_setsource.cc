@@ -18,6 +18,9 @@ extern ChiLog& chi_log;
  *        the material source, across/within-group scattering,
  *        and across/within-groups fission.
  *
+ * The scattering and fission terms are evaluated with the precompiled
+ * per-material source operators, see MaterialSourceOperator, on the
+ * contiguous group blocks of each node and moment.
  * */
 void LinearBoltzmann::Solver::
   SetSource(LBSGroupset& groupset,
@@ -32,6 +35,13 @@ void LinearBoltzmann::Solver::
   const bool apply_wgs_fission_src = (source_flags & APPLY_WGS_FISSION_SOURCE);
   const bool apply_ags_fission_src = (source_flags & APPLY_AGS_FISSION_SOURCE);
 
+  const bool apply_scatter_src = apply_wgs_scatter_src or apply_ags_scatter_src;
+  const bool apply_fission_src = apply_wgs_fission_src or apply_ags_fission_src;
+
+  if (source_operators.size() != material_xs.size() or
+      source_operators_use_precursors != options.use_precursors)
+    InitSourceOperators();
+
   //================================================== Get group setup
   auto gs_i = static_cast<size_t>(groupset.groups[0].id);
   auto gs_f = static_cast<size_t>(groupset.groups.back().id);
@@ -63,7 +73,7 @@ void LinearBoltzmann::Solver::
       exit(EXIT_FAILURE);
     }
 
-    auto xs = material_xs[xs_id];
+    const auto& source_operator = source_operators[xs_id];
 
     //==================== Obtain src
     double* src = default_zero_src.data();
@@ -81,131 +91,60 @@ void LinearBoltzmann::Solver::
 
         size_t uk_map = full_cell_view.MapDOF(i, m, 0); //unknown map
 
-        //============================= Loop over groupset groups
-        for (size_t g = gs_i; g <= gs_f; ++g)
+        double* q = &destination_q[uk_map];
+        const double* phi = &phi_old_local[uk_map];
+
+        //============================= Material source
+        if (apply_mat_src)
         {
           if (not options.use_src_moments) //using regular material src
           {
-            if (apply_mat_src and ell == 0)
-              destination_q[uk_map + g] += src[g];
+            if (ell == 0)
+              for (size_t g = gs_i; g <= gs_f; ++g)
+                q[g] += src[g];
           }
-          else if (apply_mat_src)  //using ext_src_moments
-            destination_q[uk_map + g] += ext_src_moments_local[uk_map + g];
-
-          double inscatter_g = 0.0;
-          const bool moment_avail = (ell < xs->transfer_matrices.size());
-
-          //====================== Apply across-groupset scattering
-          if (moment_avail and apply_ags_scatter_src)
-          {
-            size_t num_transfers =
-                xs->transfer_matrices[ell].rowI_indices[g].size();
-
-            //=============== Loop over transfers
-            for (size_t t = 0; t < num_transfers; ++t)
-            {
-              size_t gprime =
-                  xs->transfer_matrices[ell].rowI_indices[g][t];
-
-              if ((gprime < gs_i) or (gprime > gs_f))
-              {
-                double sigma_sm = xs->transfer_matrices[ell].rowI_values[g][t];
-                inscatter_g += sigma_sm * phi_old_local[uk_map + gprime];
-              }
-            }
-          }//if moment_avail
-
-          //====================== Apply within-groupset scattering
-          if (moment_avail and apply_wgs_scatter_src)
+          else  //using ext_src_moments
           {
-            size_t num_transfers =
-                xs->transfer_matrices[ell].rowI_indices[g].size();
-
-            //=============== Loop over transfers
-            for (size_t t = 0; t < num_transfers; ++t)
-            {
-              size_t gprime = xs->transfer_matrices[ell].rowI_indices[g][t];
-              if ((gprime >= gs_i) and (gprime <= gs_f))
-              {
-                double sigma_sm = xs->transfer_matrices[ell].rowI_values[g][t];
-                inscatter_g += sigma_sm * phi_old_local[uk_map + gprime];
-              }
-            }
+            const double* ext_src = &ext_src_moments_local[uk_map];
+            for (size_t g = gs_i; g <= gs_f; ++g)
+              q[g] += ext_src[g];
           }
-          destination_q[uk_map + g] += inscatter_g;
+        }
 
-
-          double infission_g = 0.0;
-          const bool fission_avail = (xs->is_fissile and ell == 0);
-
-          //====================== Apply accross-groupset fission
-          if (fission_avail and apply_ags_fission_src)
-          {
-            //=============== Loop over groups
-            for (size_t gprime = first_grp; gprime <= last_grp; ++gprime)
-            {
-              if ((gprime < gs_i) or (gprime > gs_f))
-              {
-                //without delayed neutron precursors
-                if (not options.use_precursors)
-                  infission_g += xs->chi[g] *
-                                 xs->nu_sigma_f[gprime] *
-                                 phi_old_local[uk_map + gprime];
-
-                //with delayed neutron precursors
-                else
-                {
-                  //Prompt fission
-                  infission_g += xs->chi_prompt[g] *
-                                 xs->nu_prompt_sigma_f[gprime] *
-                                 phi_old_local[uk_map + gprime];
-
-                  //Delayed fission
-                  for (size_t j = 0; j < xs->num_precursors; ++j)
-                    infission_g += xs->chi_delayed[g][j] *
-                                   xs->precursor_yield[j] *
-                                   xs->nu_delayed_sigma_f[gprime] *
-                                   phi_old_local[uk_map + gprime];
-                }
-              }
-            }//for gprime
-          }//if zeroth moment
-
-          //====================== Apply within-groupset fission
-          if (fission_avail and apply_wgs_fission_src)
+        //============================= Scattering
+        if (apply_scatter_src and ell < source_operator.transfer.size())
+        {
+          const auto& S = source_operator.transfer[ell];
+          for (size_t g = gs_i; g <= gs_f; ++g)
+            q[g] += S.ApplyRow(g, phi, gs_i, gs_f,
+                               apply_wgs_scatter_src,
+                               apply_ags_scatter_src);
+        }
+
+        //============================= Fission
+        if (apply_fission_src and source_operator.is_fissile and ell == 0)
+        {
+          const size_t num_terms = source_operator.fission_chi.size();
+          for (size_t t = 0; t < num_terms; ++t)
           {
-            //=============== Loop over groups
-            for (size_t gprime = first_grp; gprime <= last_grp; ++gprime)
-            {
-              if ((gprime >= gs_i) and (gprime <= gs_f))
-              {
-                //without delayed neutron precursors
-                if (not options.use_precursors)
-                  infission_g += xs->chi[g] *
-                                 xs->nu_sigma_f[gprime] *
-                                 phi_old_local[uk_map + gprime];
-
-                //with delayed neutron precursors
-                else
-                {
-                  //Prompt fission
-                  infission_g += xs->chi_prompt[g] *
-                                 xs->nu_prompt_sigma_f[gprime] *
-                                 phi_old_local[uk_map + gprime];
-
-                  //Delayed fission
-                  for (size_t j = 0; j < xs->num_precursors; ++j)
-                    infission_g += xs->chi_delayed[g][j] *
-                                   xs->precursor_yield[j] *
-                                   xs->nu_delayed_sigma_f[gprime] *
-                                   phi_old_local[uk_map + gprime];
-                }
-              }
-            }
+            const double* chi = source_operator.fission_chi[t].data();
+            const double* nu_sigma_f =
+              source_operator.fission_nu_sigma_f[t].data();
+
+            //Fission rate within and across the groupset
+            double fission_rate = 0.0;
+            if (apply_wgs_fission_src)
+              fission_rate += source_kernels::
+                DotRange(nu_sigma_f, phi, gs_i, gs_f + 1);
+            if (apply_ags_fission_src)
+              fission_rate +=
+                source_kernels::DotRange(nu_sigma_f, phi, first_grp, gs_i) +
+                source_kernels::DotRange(nu_sigma_f, phi, gs_f + 1, last_grp + 1);
+
+            for (size_t g = gs_i; g <= gs_f; ++g)
+              q[g] += chi[g] * fission_rate;
           }
-          destination_q[uk_map + g] += infission_g;
-
-        }//for g
+        }
       }//for m
     }//for dof i
   }//for cell
@@ -1,4 +1,5 @@
 #include "lbs_sweepchunk_pwl.h"
+#include "lbs_sweepchunk_pwl_kernels.h"
 
 #include "chi_log.h"
 extern ChiLog& chi_log;
@@ -9,6 +10,8 @@ extern ChiMPI& chi_mpi;
 #include "ChiMath/chi_math.h"
 extern ChiMath& chi_math_handler;
 
+#include <algorithm>
+
 //###################################################################
 /**Constructor.*/
 LinearBoltzmann::SweepChunkPWL::
@@ -34,23 +37,96 @@ LinearBoltzmann::SweepChunkPWL::
                       num_grps(in_groupset.groups.size()),
                       max_num_cell_dofs(in_max_num_cell_dofs),
                       save_angular_flux(!destination_psi.empty()),
-                      a_and_b_initialized(false)
+                      a_and_b_initialized(false),
+                      outflow_mutex(std::make_shared<std::mutex>())
 {}
 
 //###################################################################
-/**Actual sweep function*/
+/**Creates a worker copy of this chunk that writes its flux moments
+ * to the supplied vector. The worker shares the source moments, the
+ * angular flux destination and the outflow tallies with this chunk.*/
+std::shared_ptr<chi_mesh::sweep_management::SweepChunk>
+  LinearBoltzmann::SweepChunkPWL::
+  MakeWorkerChunk(std::vector<double>& worker_destination_phi)
+{
+  auto worker = std::make_shared<SweepChunkPWL>(grid_view,
+                                                grid_fe_view,
+                                                grid_transport_view,
+                                                worker_destination_phi,
+                                                GetDestinationPsi(),
+                                                q_moments,
+                                                groupset,
+                                                xsections,
+                                                num_moms,
+                                                max_num_cell_dofs);
+  worker->outflow_mutex = outflow_mutex;
+
+  return worker;
+}
+
+//###################################################################
+/**Actual sweep function. Each cell is dispatched to a sweep kernel
+ * specialized on the number of cell nodes, with a dynamically sized
+ * kernel as fallback.*/
 void LinearBoltzmann::SweepChunkPWL::
   Sweep(chi_mesh::sweep_management::AngleSet *angle_set)
 {
   if (!a_and_b_initialized)
   {
-    Amat.resize(max_num_cell_dofs, std::vector<double>(max_num_cell_dofs));
-    Atemp.resize(max_num_cell_dofs, std::vector<double>(max_num_cell_dofs));
+    Amat.resize(max_num_cell_dofs * max_num_cell_dofs, 0.0);
+    Atemp.resize(max_num_cell_dofs * max_num_cell_dofs * num_grps, 0.0);
     b.resize(num_grps, std::vector<double>(max_num_cell_dofs, 0.0));
-    source.resize(max_num_cell_dofs, 0.0);
+    b_grp.resize(max_num_cell_dofs * num_grps, 0.0);
+    source.resize(max_num_cell_dofs * num_grps, 0.0);
     a_and_b_initialized = true;
   }
 
+  const auto spds = angle_set->GetSPDS();
+
+  int deploc_face_counter = -1;
+  int preloc_face_counter = -1;
+
+  // ========================================================== Loop over each cell
+  size_t num_loc_cells = spds->spls.item_id.size();
+  for (size_t spls_index = 0; spls_index < num_loc_cells; ++spls_index)
+  {
+    const int cell_local_id = spds->spls.item_id[spls_index];
+    const auto& cell = grid_view->local_cells[cell_local_id];
+    const int num_nodes = grid_transport_view[cell.local_id].NumNodes();
+
+    switch (sweep_kernels::KernelNodeCount(cell.SubType(), num_nodes))
+    {
+      case 2: SweepCell<2>(angle_set, spls_index,
+                           deploc_face_counter, preloc_face_counter); break;
+      case 3: SweepCell<3>(angle_set, spls_index,
+                           deploc_face_counter, preloc_face_counter); break;
+      case 4: SweepCell<4>(angle_set, spls_index,
+                           deploc_face_counter, preloc_face_counter); break;
+      case 8: SweepCell<8>(angle_set, spls_index,
+                           deploc_face_counter, preloc_face_counter); break;
+      default:
+              SweepCell<0>(angle_set, spls_index,
+                           deploc_face_counter, preloc_face_counter); break;
+    }
+  } // for cell
+}//Sweep
+
+//###################################################################
+/**Sweeps a single cell for all the angles in the angle set. When N>0
+ * the angular cell matrix is a stack-resident N x N array and the local
+ * solves have compile-time bounds. N=0 uses the runtime number of nodes.
+ *
+ * All the groups of the groupset subset are solved together in a single
+ * batched solve. The per-group matrices, sources and solutions are stored
+ * node-major with the group as the innermost, contiguous index, e.g. the
+ * solution for node i and group gsg is b_grp[i*gs_ss_size + gsg].*/
+template<int N>
+void LinearBoltzmann::SweepChunkPWL::
+  SweepCell(chi_mesh::sweep_management::AngleSet *angle_set,
+            const size_t spls_index,
+            int& deploc_face_counter,
+            int& preloc_face_counter)
+{
   const auto spds = angle_set->GetSPDS();
   const auto fluds = angle_set->fluds;
   const bool surface_source_active = IsSurfaceSourceActive();
@@ -62,256 +138,270 @@ void LinearBoltzmann::SweepChunkPWL::
   const int gs_ss_begin = subset.first;
   const int gs_gi = groupset.groups[gs_ss_begin].id; // Groupset subset first group number
 
-  int deploc_face_counter = -1;
-  int preloc_face_counter = -1;
-
   auto const& d2m_op = groupset.quadrature->GetDiscreteToMomentOperator();
   auto const& m2d_op = groupset.quadrature->GetMomentToDiscreteOperator();
 
-  // ========================================================== Loop over each cell
-  size_t num_loc_cells = spds->spls.item_id.size();
-  for (size_t spls_index = 0; spls_index < num_loc_cells; ++spls_index)
+  const int cell_local_id = spds->spls.item_id[spls_index];
+  const auto& cell = grid_view->local_cells[cell_local_id];
+  const auto& fe_intgrl_values = grid_fe_view.GetUnitIntegrals(cell);
+  const auto num_faces = cell.faces.size();
+  const int num_nodes = (N > 0)? N : static_cast<int>(fe_intgrl_values.NumNodes());
+  auto& transport_view = grid_transport_view[cell.local_id];
+  const int xs_mapping = transport_view.XSMapping();
+  const auto& sigma_tg = xsections[xs_mapping]->sigma_t;
+
+  // =================================================== Cell scratch
+  if (face_mu_values.size() < num_faces)
   {
-    const int cell_local_id = spds->spls.item_id[spls_index];
-    const auto& cell = grid_view->local_cells[cell_local_id];
-    const auto& fe_intgrl_values = grid_fe_view.GetUnitIntegrals(cell);
-    const auto num_faces = cell.faces.size();
-    const int num_nodes = static_cast<int>(fe_intgrl_values.NumNodes());
-    auto& transport_view = grid_transport_view[cell.local_id];
-    const int xs_mapping = transport_view.XSMapping();
-    const auto& sigma_tg = xsections[xs_mapping]->sigma_t;
-    std::vector<bool> face_incident_flags(num_faces, false);
-    std::vector<double> face_mu_values(num_faces, 0.0);
-
-    // =================================================== Get Cell matrices
-    const auto& G           = fe_intgrl_values.GetIntV_shapeI_gradshapeJ();
-    const auto& M           = fe_intgrl_values.GetIntV_shapeI_shapeJ();
-    const auto& M_surf      = fe_intgrl_values.GetIntS_shapeI_shapeJ();
-    const auto& IntS_shapeI = fe_intgrl_values.GetIntS_shapeI();
-
-    // =================================================== Loop over angles in set
-    const int ni_deploc_face_counter = deploc_face_counter;
-    const int ni_preloc_face_counter = preloc_face_counter;
-    const size_t as_num_angles = angle_set->angles.size();
-    for (size_t angle_set_index = 0; angle_set_index<as_num_angles; ++angle_set_index)
-    {
-      deploc_face_counter = ni_deploc_face_counter;
-      preloc_face_counter = ni_preloc_face_counter;
-      const int angle_num = angle_set->angles[angle_set_index];
-      const chi_mesh::Vector3& omega = groupset.quadrature->omegas[angle_num];
-      const double wt = groupset.quadrature->weights[angle_num];
+    face_incident_flags.resize(num_faces, 0);
+    face_mu_values.resize(num_faces, 0.0);
+  }
+  std::fill_n(face_incident_flags.begin(), num_faces, 0);
 
-      // ============================================ Gradient matrix
-      for (int i = 0; i < num_nodes; ++i)
-        for (int j = 0; j < num_nodes; ++j)
-          Amat[i][j] = omega.Dot(G[i][j]);
+  double Amat_fixed[(N > 0)? N * N : 1];
+  double* const Am  = (N > 0)? Amat_fixed : Amat.data();
+  double* const At  = Atemp.data();
+  double* const src = source.data();
+  double* const bg  = b_grp.data();
 
-      for (int gsg = 0; gsg < gs_ss_size; ++gsg)
-        b[gsg].assign(num_nodes, 0.0);
+  // =================================================== Get Cell matrices
+  const auto& G           = fe_intgrl_values.GetIntV_shapeI_gradshapeJ();
+  const auto& M           = fe_intgrl_values.GetIntV_shapeI_shapeJ();
+  const auto& M_surf      = fe_intgrl_values.GetIntS_shapeI_shapeJ();
+  const auto& IntS_shapeI = fe_intgrl_values.GetIntS_shapeI();
 
-      // ============================================ Surface integrals
-      int in_face_counter = -1;
-      for (int f = 0; f < num_faces; ++f)
-      {
-        const auto& face = cell.faces[f];
-        const double mu = omega.Dot(face.normal);
-        face_mu_values[f] = mu;
+  // =================================================== Loop over angles in set
+  const int ni_deploc_face_counter = deploc_face_counter;
+  const int ni_preloc_face_counter = preloc_face_counter;
+  const size_t as_num_angles = angle_set->angles.size();
+  for (size_t angle_set_index = 0; angle_set_index<as_num_angles; ++angle_set_index)
+  {
+    deploc_face_counter = ni_deploc_face_counter;
+    preloc_face_counter = ni_preloc_face_counter;
+    const int angle_num = angle_set->angles[angle_set_index];
+    const chi_mesh::Vector3& omega = groupset.quadrature->omegas[angle_num];
+    const double wt = groupset.quadrature->weights[angle_num];
+
+    // ============================================ Gradient matrix
+    for (int i = 0; i < num_nodes; ++i)
+      for (int j = 0; j < num_nodes; ++j)
+        Am[i * num_nodes + j] = omega.Dot(G[i][j]);
+
+    std::fill(bg, bg + num_nodes * gs_ss_size, 0.0);
 
-        if (mu < 0.0) // Upwind
+    // ============================================ Surface integrals
+    int in_face_counter = -1;
+    for (int f = 0; f < num_faces; ++f)
+    {
+      const auto& face = cell.faces[f];
+      const double mu = omega.Dot(face.normal);
+      face_mu_values[f] = mu;
+
+      if (mu < 0.0) // Upwind
+      {
+        face_incident_flags[f] = true;
+        const bool local = transport_view.IsFaceLocal(f);
+        const bool boundary = not face.has_neighbor;
+        const size_t num_face_indices = face.vertex_ids.size();
+        if (local)
         {
-          face_incident_flags[f] = true;
-          const bool local = transport_view.IsFaceLocal(f);
-          const bool boundary = not face.has_neighbor;
-          const size_t num_face_indices = face.vertex_ids.size();
-          if (local)
+          in_face_counter++;
+          for (int fi = 0; fi < num_face_indices; ++fi)
           {
-            in_face_counter++;
-            for (int fi = 0; fi < num_face_indices; ++fi)
+            const int i = fe_intgrl_values.FaceDofMapping(f,fi);
+            for (int fj = 0; fj < num_face_indices; ++fj)
             {
-              const int i = fe_intgrl_values.FaceDofMapping(f,fi);
-              for (int fj = 0; fj < num_face_indices; ++fj)
-              {
-                const int j = fe_intgrl_values.FaceDofMapping(f,fj);
-                const double *psi = fluds->UpwindPsi(spls_index,in_face_counter,fj,0,angle_set_index);
-                const double mu_Nij = -mu * M_surf[f][i][j];
-                Amat[i][j] += mu_Nij;
-                for (int gsg = 0; gsg < gs_ss_size; ++gsg)
-                  b[gsg][i] += psi[gsg]*mu_Nij;
-              }
+              const int j = fe_intgrl_values.FaceDofMapping(f,fj);
+              const double *psi = fluds->UpwindPsi(spls_index,in_face_counter,fj,0,angle_set_index);
+              const double mu_Nij = -mu * M_surf[f][i][j];
+              Am[i * num_nodes + j] += mu_Nij;
+              for (int gsg = 0; gsg < gs_ss_size; ++gsg)
+                bg[i * gs_ss_size + gsg] += psi[gsg]*mu_Nij;
             }
           }
-          else if (not boundary)
+        }
+        else if (not boundary)
+        {
+          preloc_face_counter++;
+          for (int fi = 0; fi < num_face_indices; ++fi)
           {
-            preloc_face_counter++;
-            for (int fi = 0; fi < num_face_indices; ++fi)
+            const int i = fe_intgrl_values.FaceDofMapping(f,fi);
+            for (int fj = 0; fj < num_face_indices; ++fj)
             {
-              const int i = fe_intgrl_values.FaceDofMapping(f,fi);
-              for (int fj = 0; fj < num_face_indices; ++fj)
-              {
-                const int j = fe_intgrl_values.FaceDofMapping(f,fj);
-                const double *psi = fluds->NLUpwindPsi(preloc_face_counter,fj,0,angle_set_index);
-                const double mu_Nij = -mu * M_surf[f][i][j];
-                Amat[i][j] += mu_Nij;
-                for (int gsg = 0; gsg < gs_ss_size; ++gsg)
-                  b[gsg][i] += psi[gsg]*mu_Nij;
-              }
+              const int j = fe_intgrl_values.FaceDofMapping(f,fj);
+              const double *psi = fluds->NLUpwindPsi(preloc_face_counter,fj,0,angle_set_index);
+              const double mu_Nij = -mu * M_surf[f][i][j];
+              Am[i * num_nodes + j] += mu_Nij;
+              for (int gsg = 0; gsg < gs_ss_size; ++gsg)
+                bg[i * gs_ss_size + gsg] += psi[gsg]*mu_Nij;
             }
           }
-          else
+        }
+        else
+        {
+          // This counter update-logic is for mapping an incident boundary
+          // condition. Because it is cheap, the cell faces was mapped to a
+          // corresponding boundary during initialization and is
+          // independent of angle. Accessing things like reflective boundary
+          // angular fluxes (and complex boundary conditions), requires the
+          // more general bndry_face_counter.
+          const uint64_t bndry_index = face.neighbor_id;
+          for (int fi = 0; fi < num_face_indices; ++fi)
           {
-            // This counter update-logic is for mapping an incident boundary
-            // condition. Because it is cheap, the cell faces was mapped to a
-            // corresponding boundary during initialization and is
-            // independent of angle. Accessing things like reflective boundary
-            // angular fluxes (and complex boundary conditions), requires the
-            // more general bndry_face_counter.
-            const uint64_t bndry_index = face.neighbor_id;
-            for (int fi = 0; fi < num_face_indices; ++fi)
+            const int i = fe_intgrl_values.FaceDofMapping(f,fi);
+            for (int fj = 0; fj < num_face_indices; ++fj)
             {
-              const int i = fe_intgrl_values.FaceDofMapping(f,fi);
-              for (int fj = 0; fj < num_face_indices; ++fj)
-              {
-                const int j = fe_intgrl_values.FaceDofMapping(f,fj);
-                const double *psi = angle_set->PsiBndry(bndry_index,
-                                                        angle_num,
-                                                        cell.local_id,
-                                                        f, fj, gs_gi, gs_ss_begin,
-                                                        surface_source_active);
-                const double mu_Nij = -mu * M_surf[f][i][j];
-                Amat[i][j] += mu_Nij;
-                for (int gsg = 0; gsg < gs_ss_size; ++gsg)
-                  b[gsg][i] += psi[gsg]*mu_Nij;
-              }
+              const int j = fe_intgrl_values.FaceDofMapping(f,fj);
+              const double *psi = angle_set->PsiBndry(bndry_index,
+                                                      angle_num,
+                                                      cell.local_id,
+                                                      f, fj, gs_gi, gs_ss_begin,
+                                                      surface_source_active);
+              const double mu_Nij = -mu * M_surf[f][i][j];
+              Am[i * num_nodes + j] += mu_Nij;
+              for (int gsg = 0; gsg < gs_ss_size; ++gsg)
+                bg[i * gs_ss_size + gsg] += psi[gsg]*mu_Nij;
             }
           }
-        } // if upwind
-      } // for f
+        }
+      } // if upwind
+    } // for f
 
-      // ========================================== Looping over groups
-      for (int gsg = 0; gsg < gs_ss_size; ++gsg)
+    // ========================================== Source moments
+    for (int i = 0; i < num_nodes; ++i)
+    {
+      double* src_i = &src[i * gs_ss_size];
+      std::fill(src_i, src_i + gs_ss_size, 0.0);
+      for (int m = 0; m < num_moms; ++m)
       {
-        const int g = gs_gi+gsg;
+        const double m2d = m2d_op[m][angle_num];
+        const double* q_im = &q_moments[transport_view.MapDOF(i, m, gs_gi)];
+        for (int gsg = 0; gsg < gs_ss_size; ++gsg)
+          src_i[gsg] += m2d*q_im[gsg];
+      }
+    }
 
-        // ============================= Contribute source moments
-        for (int i = 0; i < num_nodes; ++i)
+    // ========================================== Mass Matrix and Source
+    const double* sigma_t = &sigma_tg[gs_gi];
+    for (int i = 0; i < num_nodes; ++i)
+    {
+      double* b_i = &bg[i * gs_ss_size];
+      for (int j = 0; j < num_nodes; ++j)
+      {
+        const double Mij = M[i][j];
+        const double Aij = Am[i * num_nodes + j];
+        const double* src_j = &src[j * gs_ss_size];
+        double* A_ij = &At[(i * num_nodes + j) * gs_ss_size];
+        for (int gsg = 0; gsg < gs_ss_size; ++gsg)
         {
-          double temp_src = 0.0;
-          for (int m = 0; m < num_moms; ++m)
-          {
-            const size_t ir = transport_view.MapDOF(i, m, g);
-            temp_src += m2d_op[m][angle_num]*q_moments[ir];
-          }
-          source[i] = temp_src;
+          A_ij[gsg] = Aij + Mij*sigma_t[gsg];
+          b_i[gsg] += Mij*src_j[gsg];
         }
+      }
+    }
 
-        // ============================= Mass Matrix and Source
-        const double sigma_tgr = sigma_tg[g];
-        for (int i = 0; i < num_nodes; ++i)
-        {
-          double temp = 0.0;
-          for (int j = 0; j < num_nodes; ++j)
-          {
-            const double Mij = M[i][j];
-            Atemp[i][j] = Amat[i][j] + Mij*sigma_tgr;
-            temp += Mij*source[j];
-          }
-          b[gsg][i] += temp;
-        }
+    // ========================================== Solve all groups at once
+    sweep_kernels::GaussEliminationBatched<N>(At, bg, num_nodes, gs_ss_size);
 
-        // ============================= Solve system
-        chi_math::GaussElimination(Atemp, b[gsg], num_nodes);
+    // ============================= Accumulate flux
+    for (int m = 0; m < num_moms; ++m)
+    {
+      const double wn_d2m = d2m_op[m][angle_num];
+      for (int i = 0; i < num_nodes; ++i)
+      {
+        const size_t ir = transport_view.MapDOF(i, m, gs_gi);
+        for (int gsg = 0; gsg < gs_ss_size; ++gsg)
+          output_phi[ir + gsg] += wn_d2m * bg[i * gs_ss_size + gsg];
       }
+    }
 
-      // ============================= Accumulate flux
-      for (int m = 0; m < num_moms; ++m)
-      {
-        const double wn_d2m = d2m_op[m][angle_num];
+    // ============================= Moment callbacks
+    // Callbacks expect the per-group solution layout of b
+    if (not moment_callbacks.empty())
+    {
+      for (int gsg = 0; gsg < gs_ss_size; ++gsg)
         for (int i = 0; i < num_nodes; ++i)
-        {
-          const size_t ir = transport_view.MapDOF(i, m, gs_gi);
-          for (int gsg = 0; gsg < gs_ss_size; ++gsg)
-            output_phi[ir + gsg] += wn_d2m * b[gsg][i];
-        }
-      }
+          b[gsg][i] = bg[i * gs_ss_size + gsg];
 
       for (auto& callback : moment_callbacks)
         callback(this, angle_set);
+    }
 
-      // ============================= Save angular fluxes if needed
-      if (save_angular_flux)
+    // ============================= Save angular fluxes if needed
+    if (save_angular_flux)
+    {
+      const auto& psi_uk_man = groupset.psi_uk_man;
+      for (int i = 0; i < num_nodes; ++i)
       {
-        const auto& psi_uk_man = groupset.psi_uk_man;
-        for (int i = 0; i < num_nodes; ++i)
-        {
-          int64_t ir = grid_fe_view.MapDOFLocal(cell,i,psi_uk_man,angle_num,0);
-          for (int gsg = 0; gsg < gs_ss_size; ++gsg)
-            output_psi[ir + gsg] = b[gsg][i];
-        }//for i
-      }//if save psi
+        int64_t ir = grid_fe_view.MapDOFLocal(cell,i,psi_uk_man,angle_num,0);
+        for (int gsg = 0; gsg < gs_ss_size; ++gsg)
+          output_psi[ir + gsg] = bg[i * gs_ss_size + gsg];
+      }//for i
+    }//if save psi
 
-      int out_face_counter = -1;
-      for (int f = 0; f < num_faces; ++f)
-      {
-        if (face_incident_flags[f]) continue;
-        double mu = face_mu_values[f];
+    int out_face_counter = -1;
+    for (int f = 0; f < num_faces; ++f)
+    {
+      if (face_incident_flags[f]) continue;
+      double mu = face_mu_values[f];
 
-        // ============================= Set flags and counters
-        out_face_counter++;
-        const auto& face = cell.faces[f];
-        const bool local = transport_view.IsFaceLocal(f);
-        const bool boundary = not face.has_neighbor;
-        const size_t num_face_indices = face.vertex_ids.size();
-        const std::vector<double>& IntF_shapeI = IntS_shapeI[f];
+      // ============================= Set flags and counters
+      out_face_counter++;
+      const auto& face = cell.faces[f];
+      const bool local = transport_view.IsFaceLocal(f);
+      const bool boundary = not face.has_neighbor;
+      const size_t num_face_indices = face.vertex_ids.size();
+      const std::vector<double>& IntF_shapeI = IntS_shapeI[f];
 
-        if (local)
+      if (local)
+      {
+        for (int fi = 0; fi < num_face_indices; ++fi)
+        {
+          const int i = fe_intgrl_values.FaceDofMapping(f,fi);
+          double *psi = fluds->OutgoingPsi(spls_index, out_face_counter, fi, angle_set_index);
+          for (int gsg = 0; gsg < gs_ss_size; ++gsg)
+            psi[gsg] = bg[i * gs_ss_size + gsg];
+        }
+      }
+      else if (not boundary)
+      {
+        deploc_face_counter++;
+        for (int fi = 0; fi < num_face_indices; ++fi)
+        {
+          const int i = fe_intgrl_values.FaceDofMapping(f,fi);
+          double *psi = fluds->NLOutgoingPsi(deploc_face_counter, fi, angle_set_index);
+          for (int gsg = 0; gsg < gs_ss_size; ++gsg)
+            psi[gsg] = bg[i * gs_ss_size + gsg];
+        }
+      }
+      else // Store outgoing reflecting Psi
+      {
+        const uint64_t bndry_index = face.neighbor_id;
+        if (angle_set->ref_boundaries[bndry_index]->IsReflecting())
         {
           for (int fi = 0; fi < num_face_indices; ++fi)
           {
             const int i = fe_intgrl_values.FaceDofMapping(f,fi);
-            double *psi = fluds->OutgoingPsi(spls_index, out_face_counter, fi, angle_set_index);
+            double *psi = angle_set->ReflectingPsiOutBoundBndry(bndry_index, angle_num,
+                                                                cell.local_id, f,
+                                                                fi, gs_ss_begin);
             for (int gsg = 0; gsg < gs_ss_size; ++gsg)
-              psi[gsg] = b[gsg][i];
+              psi[gsg] = bg[i * gs_ss_size + gsg];
           }
         }
-        else if (not boundary)
+        else
         {
-          deploc_face_counter++;
+          std::lock_guard<std::mutex> outflow_lock(*outflow_mutex);
           for (int fi = 0; fi < num_face_indices; ++fi)
           {
             const int i = fe_intgrl_values.FaceDofMapping(f,fi);
-            double *psi = fluds->NLOutgoingPsi(deploc_face_counter, fi, angle_set_index);
+
             for (int gsg = 0; gsg < gs_ss_size; ++gsg)
-              psi[gsg] = b[gsg][i];
+              transport_view.AddOutflow(gs_gi + gsg,
+                                        wt*mu*bg[i * gs_ss_size + gsg]*IntF_shapeI[i]);
           }
         }
-        else // Store outgoing reflecting Psi
-        {
-          const uint64_t bndry_index = face.neighbor_id;
-          if (angle_set->ref_boundaries[bndry_index]->IsReflecting())
-          {
-            for (int fi = 0; fi < num_face_indices; ++fi)
-            {
-              const int i = fe_intgrl_values.FaceDofMapping(f,fi);
-              double *psi = angle_set->ReflectingPsiOutBoundBndry(bndry_index, angle_num,
-                                                                  cell.local_id, f,
-                                                                  fi, gs_ss_begin);
-              for (int gsg = 0; gsg < gs_ss_size; ++gsg)
-                psi[gsg] = b[gsg][i];
-            }
-          }
-          else
-          {
-            for (int fi = 0; fi < num_face_indices; ++fi)
-            {
-              const int i = fe_intgrl_values.FaceDofMapping(f,fi);
-
-              for (int gsg = 0; gsg < gs_ss_size; ++gsg)
-                transport_view.AddOutflow(gs_gi + gsg,
-                                          wt*mu*b[gsg][i]*IntF_shapeI[i]);
-            }
-          }
-        }//bndry
-      }//for face
-    } // for n
-  } // for cell
-}//Sweep
\ No newline at end of file
+      }//bndry
+    }//for face
+  } // for n
+}
@@ -9,6 +9,8 @@
 
 #include "LinearBoltzmannSolver/lbs_linear_boltzmann_solver.h"
 
+#include <mutex>
+
 typedef std::vector<std::shared_ptr<chi_physics::TransportCrossSections>> TCrossSections;
 
 namespace LinearBoltzmann
@@ -31,11 +33,20 @@ protected:
 
   //Runtime params
   bool a_and_b_initialized;
-  std::vector<std::vector<double>> Amat;
-  std::vector<std::vector<double>> Atemp;
-  std::vector<double> source;
+  std::vector<double> Amat;  ///< Flat row-major, used by dynamic kernel
+  std::vector<double> Atemp; ///< Per-group matrices, group innermost
+  std::vector<double> source;///< Per-group sources, group innermost
+  std::vector<double> b_grp; ///< Per-group solutions, group innermost
+  std::vector<char> face_incident_flags; ///< Upwind flags of the current cell
+  std::vector<double> face_mu_values;    ///< Face mu of the current cell
+
+  /**Guards the cell outflow tallies, which are shared between this chunk
+   * and all of its worker chunks.*/
+  std::shared_ptr<std::mutex> outflow_mutex;
 
 public:
+  /**Per-group cell solution, b[gsg][i]. Only populated
+   * for use by the moment callbacks.*/
   std::vector<std::vector<double>> b;
 
   SweepChunkPWL(std::shared_ptr<chi_mesh::MeshContinuum> grid_ptr,
@@ -50,6 +61,16 @@ public:
                 int in_max_num_cell_dofs);
 
   void Sweep(chi_mesh::sweep_management::AngleSet* angle_set) override;
+
+  std::shared_ptr<chi_mesh::sweep_management::SweepChunk>
+    MakeWorkerChunk(std::vector<double>& worker_destination_phi) override;
+
+protected:
+  template<int N>
+  void SweepCell(chi_mesh::sweep_management::AngleSet* angle_set,
+                 size_t spls_index,
+                 int& deploc_face_counter,
+                 int& preloc_face_counter);
 };
 }
 
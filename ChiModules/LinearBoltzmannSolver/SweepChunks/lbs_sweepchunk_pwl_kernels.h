@@ -0,0 +1,126 @@
+#ifndef LBS_SWEEPCHUNK_PWL_KERNELS_H
+#define LBS_SWEEPCHUNK_PWL_KERNELS_H
+
+#include "ChiMesh/Cell/cell.h"
+
+namespace LinearBoltzmann
+{
+namespace sweep_kernels
+{
+
+//###################################################################
+/**Returns the compile-time kernel size to use for a cell of the given
+ * sub-type, or 0 if the dynamically sized kernel must be used. The
+ * number of nodes is checked against the sub-type so that discretizations
+ * with a different node layout always fall back to the dynamic kernel.*/
+inline int KernelNodeCount(const chi_mesh::CellType cell_sub_type,
+                           const int num_nodes)
+{
+  int expected_num_nodes = 0;
+  switch (cell_sub_type)
+  {
+    case chi_mesh::CellType::SLAB:          expected_num_nodes = 2; break;
+    case chi_mesh::CellType::TRIANGLE:      expected_num_nodes = 3; break;
+    case chi_mesh::CellType::QUADRILATERAL: expected_num_nodes = 4; break;
+    case chi_mesh::CellType::TETRAHEDRON:   expected_num_nodes = 4; break;
+    case chi_mesh::CellType::HEXAHEDRON:    expected_num_nodes = 8; break;
+    default: break;
+  }
+
+  return (expected_num_nodes == num_nodes)? expected_num_nodes : 0;
+}
+
+//###################################################################
+/**Gauss elimination without pivoting on a flat, row-major, n x n matrix.
+ * The solution overwrites b and A is destroyed.*/
+inline void GaussElimination(double* A, double* b, const int n)
+{
+  // Forward elimination
+  for (int i = 0; i < n - 1; ++i)
+  {
+    const double* ai = &A[i * n];
+    const double bi = b[i];
+    const double factor = 1.0 / ai[i];
+    for (int j = i + 1; j < n; ++j)
+    {
+      double* aj = &A[j * n];
+      const double val = aj[i] * factor;
+      b[j] -= val * bi;
+      for (int k = i + 1; k < n; ++k)
+        aj[k] -= val * ai[k];
+    }
+  }
+
+  // Back substitution
+  for (int i = n - 1; i >= 0; --i)
+  {
+    const double* ai = &A[i * n];
+    double bi = b[i];
+    for (int j = i + 1; j < n; ++j)
+      bi -= ai[j] * b[j];
+    b[i] = bi / ai[i];
+  }
+}
+
+//###################################################################
+/**Batched Gauss elimination without pivoting for num_lanes independent
+ * n x n systems, one per group. Entry (i,j) of lane l is stored at
+ * A[(i*n + j)*num_lanes + l] and entry i of the right-hand side at
+ * b[i*num_lanes + l], i.e. the group index is the innermost, contiguous
+ * index. Every innermost loop therefore runs over contiguous lanes with
+ * no dependencies between iterations, which allows the compiler to
+ * vectorize it for the target instruction set. The solution overwrites
+ * b and A is destroyed.*/
+template<int N>
+inline void GaussEliminationBatched(double* __restrict A,
+                                    double* __restrict b,
+                                    const int n,
+                                    const int num_lanes)
+{
+  const int nn = (N > 0)? N : n;
+  const int L  = num_lanes;
+
+  // Forward elimination
+  for (int i = 0; i < nn - 1; ++i)
+  {
+    const double* aii = &A[(i * nn + i) * L];
+    const double* bi  = &b[i * L];
+    for (int j = i + 1; j < nn; ++j)
+    {
+      double* aji = &A[(j * nn + i) * L];
+      double* bj  = &b[j * L];
+      for (int l = 0; l < L; ++l)
+        aji[l] /= aii[l];
+      for (int l = 0; l < L; ++l)
+        bj[l] -= aji[l] * bi[l];
+      for (int k = i + 1; k < nn; ++k)
+      {
+        const double* aik = &A[(i * nn + k) * L];
+        double*       ajk = &A[(j * nn + k) * L];
+        for (int l = 0; l < L; ++l)
+          ajk[l] -= aji[l] * aik[l];
+      }
+    }
+  }
+
+  // Back substitution
+  for (int i = nn - 1; i >= 0; --i)
+  {
+    double* bi = &b[i * L];
+    for (int j = i + 1; j < nn; ++j)
+    {
+      const double* aij = &A[(i * nn + j) * L];
+      const double* bj  = &b[j * L];
+      for (int l = 0; l < L; ++l)
+        bi[l] -= aij[l] * bj[l];
+    }
+    const double* aii = &A[(i * nn + i) * L];
+    for (int l = 0; l < L; ++l)
+      bi[l] /= aii[l];
+  }
+}
+
+}//namespace sweep_kernels
+}//namespace LinearBoltzmann
+
+#endif
@@ -62,17 +62,17 @@ PetscErrorCode LinearBoltzmann::
   if (context->solver.options.verbose_inner_iterations)
     chi_log.Log(LOG_0) << iter_info.str() << std::endl;
 
-  const double SIXTY_SECOND_INTERVAL = 60000.0; //time in milliseconds
   if (context->groupset.iterative_method == IterativeMethod::GMRES or
       context->groupset.iterative_method == IterativeMethod::GMRES_CYCLES)
   {
+    if (context->solver.options.write_restart_data)
+      context->solver.checkpoint_writer.Poll();
+
     if (context->last_iteration == n)
     {
       if (context->solver.options.write_restart_data)
       {
-        if ((chi_program_timer.GetTime()/SIXTY_SECOND_INTERVAL) >
-          context->solver.last_restart_write +
-          context->solver.options.write_restart_interval)
+        if (context->solver.RestartWriteIntervalElapsed())
         {
           Vec phi_new;
           KSPBuildSolution(ksp, nullptr,&phi_new);
@@ -82,11 +82,7 @@ PetscErrorCode LinearBoltzmann::
                                      context->solver.phi_old_local,
                                      WITH_DELAYED_PSI);
 
-          context->solver.last_restart_write =
-            chi_program_timer.GetTime()/SIXTY_SECOND_INTERVAL;
-          context->solver.WriteRestartData(
-            context->solver.options.write_restart_folder_name,
-            context->solver.options.write_restart_file_base);
+          context->solver.SubmitRestartCheckpoint();
         }
       }
     }
@@ -41,6 +41,9 @@ void LinearBoltzmann::Solver::Initialize()
   //================================================== Initialize materials
   InitMaterials(unique_material_ids);
 
+  //================================================== Precompile sources
+  InitSourceOperators();
+
   //================================================== Init spatial discretization
   InitializeSpatialDiscretization();
 
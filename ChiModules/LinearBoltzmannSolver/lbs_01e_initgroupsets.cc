@@ -21,5 +21,12 @@ void LinearBoltzmann::Solver::InitializeGroupsets()
     groupset.BuildMomDiscOperator(options.scattering_order,
                                   options.geometry_type);
     groupset.BuildSubsets();
+
+    //================================================== DSA solvers kept from
+    //                                                   a previous solve
+    //                                                   refer to the old
+    //                                                   discretization
+    ReleaseWGDSA(groupset);
+    ReleaseTGDSA(groupset);
   }//for groupset
 }
\ No newline at end of file
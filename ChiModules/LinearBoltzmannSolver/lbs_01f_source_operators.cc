@@ -0,0 +1,130 @@
+#include "lbs_linear_boltzmann_solver.h"
+
+#include "chi_log.h"
+extern ChiLog& chi_log;
+
+#include <map>
+
+//###################################################################
+/**Flattens a transfer matrix, keeping only rows and columns of the
+ * first num_groups groups. Duplicate entries are summed.*/
+LinearBoltzmann::FlatTransferMatrix::
+  FlatTransferMatrix(const chi_math::SparseMatrix& S, size_t num_groups)
+{
+  //================================================== Sort rows
+  std::vector<std::map<size_t, double>> rows(num_groups);
+  size_t num_nonzeros = 0;
+  size_t band_size = 0;
+  for (size_t g=0; g<std::min(num_groups, S.rowI_indices.size()); ++g)
+  {
+    for (size_t t=0; t<S.rowI_indices[g].size(); ++t)
+    {
+      const size_t gp = S.rowI_indices[g][t];
+      if (gp < num_groups)
+        rows[g][gp] += S.rowI_values[g][t];
+    }
+    num_nonzeros += rows[g].size();
+    if (not rows[g].empty())
+      band_size += rows[g].rbegin()->first - rows[g].begin()->first + 1;
+  }
+
+  banded = (band_size <= 2*num_nonzeros);
+
+  //================================================== Fill storage
+  row_offsets.assign(num_groups + 1, 0);
+  if (banded) row_begin.assign(num_groups, 0);
+
+  for (size_t g=0; g<num_groups; ++g)
+  {
+    const auto& row = rows[g];
+    row_offsets[g] = values.size();
+    if (row.empty()) continue;
+
+    if (banded)
+    {
+      const size_t b = row.begin()->first;
+      const size_t e = row.rbegin()->first + 1;
+      row_begin[g] = static_cast<uint32_t>(b);
+      values.resize(values.size() + (e - b), 0.0);
+      for (const auto& entry : row)
+        values[row_offsets[g] + entry.first - b] = entry.second;
+    }
+    else
+    {
+      for (const auto& entry : row)
+      {
+        columns.push_back(static_cast<uint32_t>(entry.first));
+        values.push_back(entry.second);
+      }
+    }
+  }
+  row_offsets[num_groups] = values.size();
+}
+
+//###################################################################
+/**Precompiles the source operator of a material.*/
+LinearBoltzmann::MaterialSourceOperator::
+  MaterialSourceOperator(const chi_physics::TransportCrossSections& xs,
+                         size_t num_groups,
+                         bool use_precursors)
+{
+  for (const auto& S : xs.transfer_matrices)
+    transfer.emplace_back(S, num_groups);
+
+  is_fissile = xs.is_fissile;
+  if (not is_fissile) return;
+
+  auto Truncate = [num_groups](const std::vector<double>& v)
+  {
+    std::vector<double> t(num_groups, 0.0);
+    std::copy_n(v.begin(), std::min(num_groups, v.size()), t.begin());
+    return t;
+  };
+
+  if (not use_precursors)
+  {
+    fission_chi.push_back(Truncate(xs.chi));
+    fission_nu_sigma_f.push_back(Truncate(xs.nu_sigma_f));
+    return;
+  }
+
+  //Prompt fission
+  fission_chi.push_back(Truncate(xs.chi_prompt));
+  fission_nu_sigma_f.push_back(Truncate(xs.nu_prompt_sigma_f));
+
+  //Delayed fission, with the spectra of all precursors combined
+  std::vector<double> chi_delayed(num_groups, 0.0);
+  for (size_t g=0; g<std::min(num_groups, xs.chi_delayed.size()); ++g)
+    for (size_t j=0; j<xs.num_precursors; ++j)
+      chi_delayed[g] += xs.chi_delayed[g][j] * xs.precursor_yield[j];
+
+  fission_chi.push_back(chi_delayed);
+  fission_nu_sigma_f.push_back(Truncate(xs.nu_delayed_sigma_f));
+}
+
+//###################################################################
+/**Precompiles the source operators of all materials. Since the
+ * operators are built from the cross-sections at this point, they are
+ * rebuilt at the start of every Execute so that cross-sections changed
+ * in place between solves are picked up.*/
+void LinearBoltzmann::Solver::InitSourceOperators()
+{
+  source_operators.clear();
+  source_operators.reserve(material_xs.size());
+  for (const auto& xs : material_xs)
+    source_operators.emplace_back(*xs, num_groups, options.use_precursors);
+
+  source_operators_use_precursors = options.use_precursors;
+
+  size_t num_banded = 0, num_matrices = 0;
+  for (const auto& op : source_operators)
+    for (const auto& S : op.transfer)
+    {
+      num_banded += S.banded? 1 : 0;
+      ++num_matrices;
+    }
+
+  chi_log.Log(LOG_0VERBOSE_1)
+    << "Source operators initialized. " << num_banded << " of "
+    << num_matrices << " transfer matrices use banded storage.";
+}
@@ -18,27 +18,41 @@ extern ChiConsole&  chi_console;
 /**Execute the solver.*/
 void LinearBoltzmann::Solver::Execute()
 {
-  MPI_Barrier(MPI_COMM_WORLD);
-  for (auto& groupset : groupsets)
+  //================================================== Cross-sections may
+  //                                                   have been changed
+  //                                                   since initialization
+  InitSourceOperators();
+
+  if (options.ags_max_iterations > 1 or
+      options.ags_scheme != AGSScheme::GAUSS_SEIDEL or
+      options.ags_two_grid)
+    SolveAcrossGroupsets();
+  else
   {
-    chi_log.Log(LOG_0)
-      << "\n********* Initializing Groupset " << groupset.id
-      << "\n" << std::endl;
+    //================================================== Single pass over
+    //                                                   the groupsets
+    MPI_Barrier(MPI_COMM_WORLD);
+    for (auto& groupset : groupsets)
+    {
+      chi_log.Log(LOG_0)
+        << "\n********* Initializing Groupset " << groupset.id
+        << "\n" << std::endl;
 
-    ComputeSweepOrderings(groupset);
-    InitFluxDataStructures(groupset);
+      ComputeSweepOrderings(groupset);
+      InitFluxDataStructures(groupset);
 
-    InitWGDSA(groupset);
-    InitTGDSA(groupset);
+      InitWGDSA(groupset);
+      InitTGDSA(groupset);
 
-    SolveGroupset(groupset);
+      SolveGroupset(groupset);
 
-    CleanUpWGDSA(groupset);
-    CleanUpTGDSA(groupset);
+      CleanUpWGDSA(groupset);
+      CleanUpTGDSA(groupset);
 
-    ResetSweepOrderings(groupset);
+      ResetSweepOrderings(groupset);
 
-    MPI_Barrier(MPI_COMM_WORLD);
+      MPI_Barrier(MPI_COMM_WORLD);
+    }
   }
 
   if (options.use_precursors)
@@ -59,26 +73,16 @@ void LinearBoltzmann::Solver::SolveGroupset(LBSGroupset& groupset)
   auto sweep_chunk = SetSweepChunk(groupset);
   MainSweepScheduler sweep_scheduler(SchedulingAlgorithm::DEPTH_OF_GRAPH,
                                      groupset.angle_agg,
-                                     *sweep_chunk);
+                                     *sweep_chunk,
+                                     options.num_sweep_threads);
+
+  if (groupset.log_sweep_events)
+    sweep_scheduler.sweep_trace.Enable();
 
   q_moments_local.assign(q_moments_local.size(), 0.0);
 
-  if (groupset.iterative_method == IterativeMethod::CLASSICRICHARDSON)
-  {
-    ClassicRichardson(groupset, sweep_scheduler,
-                      APPLY_MATERIAL_SOURCE |
-                      APPLY_AGS_SCATTER_SOURCE | APPLY_WGS_SCATTER_SOURCE |
-                      APPLY_AGS_FISSION_SOURCE | APPLY_WGS_FISSION_SOURCE,
-                      options.verbose_inner_iterations);
-  }
-  else if (groupset.iterative_method == IterativeMethod::GMRES)
-  {
-    GMRES(groupset, sweep_scheduler,
-          APPLY_WGS_SCATTER_SOURCE | APPLY_WGS_FISSION_SOURCE,  //lhs_scope
-          APPLY_MATERIAL_SOURCE | APPLY_AGS_SCATTER_SOURCE |
-          APPLY_AGS_FISSION_SOURCE,                             //rhs_scope
-          options.verbose_inner_iterations);
-  }
+  SolveGroupset(groupset, sweep_scheduler,
+                APPLY_AGS_SCATTER_SOURCE | APPLY_AGS_FISSION_SOURCE);
 
   if (options.write_restart_data)
     WriteRestartData(options.write_restart_folder_name,
@@ -90,3 +94,30 @@ void LinearBoltzmann::Solver::SolveGroupset(LBSGroupset& groupset)
     << chi_console.GetMemoryUsageInMB() << " MB";
 }
 
+
+
+//###################################################################
+/**Converges the within-groupset sources of a groupset with its
+ * iterative method. The material source and the across-groupset sources
+ * selected by ags_source_flags are added to the contents of
+ * q_moments_local, which the caller can use to supply precomputed
+ * sources.*/
+void LinearBoltzmann::Solver::SolveGroupset(LBSGroupset& groupset,
+                                            MainSweepScheduler& sweep_scheduler,
+                                            SourceFlags ags_source_flags)
+{
+  if (groupset.iterative_method == IterativeMethod::CLASSICRICHARDSON)
+  {
+    ClassicRichardson(groupset, sweep_scheduler,
+                      APPLY_MATERIAL_SOURCE | ags_source_flags |
+                      APPLY_WGS_SCATTER_SOURCE | APPLY_WGS_FISSION_SOURCE,
+                      options.verbose_inner_iterations);
+  }
+  else if (groupset.iterative_method == IterativeMethod::GMRES)
+  {
+    GMRES(groupset, sweep_scheduler,
+          APPLY_WGS_SCATTER_SOURCE | APPLY_WGS_FISSION_SOURCE,  //lhs_scope
+          APPLY_MATERIAL_SOURCE | ags_source_flags,             //rhs_scope
+          options.verbose_inner_iterations);
+  }
+}
\ No newline at end of file
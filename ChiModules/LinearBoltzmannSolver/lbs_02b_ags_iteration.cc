@@ -0,0 +1,168 @@
+#include "lbs_linear_boltzmann_solver.h"
+#include "IterativeMethods/lbs_iterativemethods.h"
+
+#include "DiffusionSolver/Solver/diffusion_solver.h"
+
+#include "chi_log.h"
+extern ChiLog&     chi_log;
+
+#include "ChiTimer/chi_timer.h"
+extern ChiTimer chi_program_timer;
+
+#include "ChiConsole/chi_console.h"
+extern ChiConsole&  chi_console;
+
+#include <iomanip>
+
+//###################################################################
+/**Iterates over all groupsets until the across-groupset (AGS) sources
+ * have converged.
+ *
+ * In the Gauss-Seidel scheme every groupset solve uses the latest flux
+ * of all other groupsets, in the Jacobi scheme the across-groupset
+ * sources of all groupsets are computed from the flux of the previous
+ * AGS iteration before any groupset is solved. Since all groupsets are
+ * revisited, their sweep orderings, FLUDS, DSA solvers and schedulers
+ * are built once and kept alive for the duration of the iterations.
+ *
+ * The optional two-grid acceleration follows every AGS iteration with a
+ * one-group diffusion solve for the error caused by the lagged
+ * across-groupset scattering, which is then distributed over the groups
+ * with the infinite medium error spectrum.*/
+void LinearBoltzmann::Solver::SolveAcrossGroupsets()
+{
+  source_event_tag = chi_log.GetRepeatingEventTag("Set Source");
+
+  const bool jacobi = (options.ags_scheme == AGSScheme::JACOBI);
+
+  //================================================== Initialize groupsets
+  std::vector<std::shared_ptr<SweepChunk>> sweep_chunks;
+  std::vector<std::unique_ptr<MainSweepScheduler>> sweep_schedulers;
+
+  MPI_Barrier(MPI_COMM_WORLD);
+  for (auto& groupset : groupsets)
+  {
+    chi_log.Log(LOG_0)
+      << "\n********* Initializing Groupset " << groupset.id
+      << "\n" << std::endl;
+
+    ComputeSweepOrderings(groupset);
+    InitFluxDataStructures(groupset);
+
+    InitWGDSA(groupset);
+    InitTGDSA(groupset);
+
+    sweep_chunks.push_back(SetSweepChunk(groupset));
+    sweep_schedulers.push_back(std::make_unique<MainSweepScheduler>(
+      SchedulingAlgorithm::DEPTH_OF_GRAPH,
+      groupset.angle_agg,
+      *sweep_chunks.back(),
+      options.num_sweep_threads));
+
+    if (groupset.log_sweep_events)
+      sweep_schedulers.back()->sweep_trace.Enable();
+  }
+
+  if (options.ags_two_grid)
+    InitAGSTwoGrid();
+
+  chi_log.Log(LOG_0)
+    << "\n********** Solving across groupsets with "
+    << (jacobi ? "Jacobi" : "Gauss-Seidel")
+    << (options.ags_two_grid ? " and two-grid acceleration" : "")
+    << ".\n";
+
+  //================================================== AGS iterations
+  const SourceFlags ags_flags = APPLY_AGS_SCATTER_SOURCE |
+                                APPLY_AGS_FISSION_SOURCE;
+
+  std::vector<double> phi_prev_ags;
+  std::vector<double> q_ags;
+
+  bool converged = false;
+  for (int k = 0; k < options.ags_max_iterations; ++k)
+  {
+    phi_prev_ags = phi_old_local;
+
+    //======================================== Jacobi sources
+    if (jacobi)
+    {
+      q_ags.assign(q_moments_local.size(), 0.0);
+      for (auto& groupset : groupsets)
+        SetSource(groupset, q_ags, ags_flags);
+    }
+
+    //======================================== Solve groupsets
+    MPI_Barrier(MPI_COMM_WORLD);
+    for (size_t gs=0; gs<groupsets.size(); ++gs)
+    {
+      auto& groupset        = groupsets[gs];
+      auto& sweep_scheduler = *sweep_schedulers[gs];
+
+      if (jacobi)
+      {
+        q_moments_local = q_ags;
+        SolveGroupset(groupset, sweep_scheduler, NO_FLAGS_SET);
+      }
+      else
+      {
+        q_moments_local.assign(q_moments_local.size(), 0.0);
+        SolveGroupset(groupset, sweep_scheduler, ags_flags);
+      }
+
+      MPI_Barrier(MPI_COMM_WORLD);
+    }
+
+    //======================================== Two-grid correction
+    if (options.ags_two_grid)
+    {
+      AssembleAGSTwoGridDeltaPhiVector(phi_prev_ags, phi_old_local);
+      ((chi_diffusion::Solver*)ags_tg_solver)->ExecuteS(true,false);
+      DisAssembleAGSTwoGridDeltaPhiVector(phi_old_local);
+      DisAssembleAGSTwoGridDeltaPhiVector(phi_new_local);
+    }
+
+    //======================================== Check convergence
+    double pw_change = ComputeAGSPiecewiseChange(phi_prev_ags);
+
+    if (pw_change < std::max(options.ags_tolerance, 1.0e-12))
+      converged = true;
+
+    if (options.verbose_outer_iterations)
+    {
+      std::stringstream iter_info;
+      iter_info
+        << chi_program_timer.GetTimeString() << " "
+        << "AGS Iteration " << std::setw(5) << k
+        << " Point-wise change " << std::setw(14) << pw_change;
+      if (converged) iter_info << " CONVERGED\n";
+
+      chi_log.Log(LOG_0) << iter_info.str();
+    }
+
+    if (converged) break;
+  }//for AGS iteration
+
+  if (options.write_restart_data)
+    WriteRestartData(options.write_restart_folder_name,
+                     options.write_restart_file_base);
+
+  //================================================== Clean up
+  if (options.ags_two_grid)
+    CleanUpAGSTwoGrid();
+
+  sweep_schedulers.clear();
+  sweep_chunks.clear();
+  for (auto& groupset : groupsets)
+  {
+    CleanUpWGDSA(groupset);
+    CleanUpTGDSA(groupset);
+
+    ResetSweepOrderings(groupset);
+  }
+
+  chi_log.Log(LOG_0)
+    << "Across-groupset solve complete.           Process memory = "
+    << std::setprecision(3)
+    << chi_console.GetMemoryUsageInMB() << " MB";
+}
@@ -20,6 +20,7 @@ typedef chi_mesh::sweep_management::AngleSetGroup TAngleSetGroup;
 extern ChiConsole&  chi_console;
 
 #include <iomanip>
+#include <sys/stat.h>
 
 //###################################################################
 /**Initializes the sweep ordering for the given groupset.*/
@@ -77,6 +78,10 @@ void LinearBoltzmann::Solver::ComputeSweepOrderings(LBSGroupset& groupset) const
 }
 
 
+//###################################################################
+/**Computes one sweep ordering per direction. Directions with identical
+ * dependency structures share a single SPDS, optionally read from and
+ * written to the sweep ordering cache.*/
 void LinearBoltzmann::Solver::ComputeSweepOrderingsAngleAggSingle(LBSGroupset& groupset) const
 {
   if (options.verbose_inner_iterations)
@@ -84,15 +89,37 @@ void LinearBoltzmann::Solver::ComputeSweepOrderingsAngleAggSingle(LBSGroupset& g
       << chi_program_timer.GetTimeString()
       << " Computing Sweep ordering - Angle aggregation: Single";
 
-  for (const auto& omega : groupset.quadrature->omegas)
+  //============================================= Cache file
+  std::string cache_file_name;
+  if (options.sweep_ordering_cache)
   {
-    const auto new_swp_order =
-      chi_mesh::sweep_management::
-      CreateSweepOrder(omega,
-                       this->grid,
-                       groupset.allow_cycles);
-    groupset.sweep_orderings.emplace_back(new_swp_order);
+    const auto& folder_name = options.sweep_ordering_cache_folder_name;
+
+    typedef struct stat Stat;
+    Stat st;
+    if (chi_mpi.location_id == 0)
+      if (stat(folder_name.c_str(),&st) != 0) //if not exist, make it
+        if ( (mkdir(folder_name.c_str(),S_IRWXU | S_IRWXG | S_IRWXO) != 0) and
+             (errno != EEXIST) )
+          chi_log.Log(LOG_0WARNING)
+            << "Failed to create sweep ordering cache directory: "
+            << folder_name;
+
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    cache_file_name = folder_name + std::string("/") +
+                      options.sweep_ordering_cache_file_base +
+                      std::to_string(chi_mpi.location_id) +
+                      (groupset.allow_cycles ? ".c.spds" : ".spds");
   }
+
+  groupset.sweep_orderings =
+    chi_mesh::sweep_management::
+    CreateUniqueSweepOrders(groupset.quadrature->omegas,
+                            this->grid,
+                            groupset.allow_cycles,
+                            options.sweep_distributed_tdg,
+                            cache_file_name);
 }
 
 
@@ -159,7 +186,8 @@ void LinearBoltzmann::Solver::ComputeSweepOrderingsAngleAggPolar(LBSGroupset& gr
           chi_mesh::sweep_management::
           CreateSweepOrder(product_quadrature->omegas[dir_idx],
                            this->grid,
-                           groupset.allow_cycles);
+                           groupset.allow_cycles,
+                           options.sweep_distributed_tdg);
         groupset.sweep_orderings.emplace_back(new_swp_order);
       }
       //=========================================== BOTTOM HEMISPHERE
@@ -170,7 +198,8 @@ void LinearBoltzmann::Solver::ComputeSweepOrderingsAngleAggPolar(LBSGroupset& gr
           chi_mesh::sweep_management::
           CreateSweepOrder(product_quadrature->omegas[dir_idx],
                            this->grid,
-                           groupset.allow_cycles);
+                           groupset.allow_cycles,
+                           options.sweep_distributed_tdg);
         groupset.sweep_orderings.emplace_back(new_swp_order);
       }
     }//if product quadrature
@@ -217,7 +246,8 @@ void LinearBoltzmann::Solver::ComputeSweepOrderingsAngleAggAzimuthal(LBSGroupset
             chi_mesh::sweep_management::
             CreateSweepOrder(product_quadrature->omegas[dir_idx],
                              this->grid,
-                             groupset.allow_cycles);
+                             groupset.allow_cycles,
+                           options.sweep_distributed_tdg);
           groupset.sweep_orderings.emplace_back(new_swp_order);
         }
     }
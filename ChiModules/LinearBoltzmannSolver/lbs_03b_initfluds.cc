@@ -57,6 +57,12 @@ void LinearBoltzmann::Solver::InitFluxDataStructures(LBSGroupset& groupset)
   else
     InitAngleAggSingle(groupset);
 
+  //================================================== Communication mode
+  if (options.use_persistent_sweep_comm)
+    for (auto& angle_set_group : groupset.angle_agg.angle_set_groups)
+      for (auto& angle_set : angle_set_group.angle_sets)
+        angle_set->SetUsePersistentRequests(true);
+
   if (options.verbose_inner_iterations)
     chi_log.Log(LOG_0)
       << chi_program_timer.GetTimeString()
@@ -22,6 +22,7 @@ typedef chi_mesh::sweep_management::AngleSet TAngleSet;
 typedef chi_mesh::sweep_management::AngleSetGroup TAngleSetGroup;
 
 #include <iomanip>
+#include <map>
 
 //###################################################################
 /**Initializes angle aggregation for a groupset.*/
@@ -32,6 +33,12 @@ void LinearBoltzmann::Solver::InitAngleAggSingle(LBSGroupset& groupset)
       << chi_program_timer.GetTimeString()
       << " Initializing angle aggregation: Single";
 
+  //Angles that share a sweep ordering also share the slot and dof
+  //mappings of its PRIMARY_FLUDS. Their angle sets only get their own
+  //psi storage, through an AUX_FLUDS.
+  typedef chi_mesh::sweep_management::SPDS SPDS;
+  std::map<SPDS*, chi_mesh::sweep_management::PRIMARY_FLUDS*> spds_primary_fluds;
+
   if (groupset.quadrature->type == chi_math::AngularQuadratureType::ProductQuadrature)
   {
     auto product_quadrature =
@@ -78,7 +85,15 @@ void LinearBoltzmann::Solver::InitAngleAggSingle(LBSGroupset& groupset)
 
 
             chi_mesh::sweep_management::FLUDS* fluds;
-            if (make_primary)
+            const auto spds = groupset.sweep_orderings[angle_num].get();
+            if (make_primary and spds_primary_fluds.count(spds) > 0)
+            {
+              make_primary = false;
+              primary_fluds = spds_primary_fluds[spds];
+              fluds = new chi_mesh::sweep_management::
+              AUX_FLUDS(*primary_fluds,groupset.grp_subset_sizes[gs_ss]);
+            }
+            else if (make_primary)
             {
               make_primary = false;
               primary_fluds = new chi_mesh::sweep_management::
@@ -95,6 +110,7 @@ void LinearBoltzmann::Solver::InitAngleAggSingle(LBSGroupset& groupset)
               primary_fluds->InitializeAlphaElements(groupset.sweep_orderings[angle_num]);
               primary_fluds->InitializeBetaElements(groupset.sweep_orderings[angle_num]);
 
+              spds_primary_fluds[spds] = primary_fluds;
               fluds = primary_fluds;
             }
             else
@@ -144,7 +160,15 @@ void LinearBoltzmann::Solver::InitAngleAggSingle(LBSGroupset& groupset)
             angle_indices.push_back(angle_num);
 
             chi_mesh::sweep_management::FLUDS* fluds;
-            if (make_primary)
+            const auto spds = groupset.sweep_orderings[angle_num].get();
+            if (make_primary and spds_primary_fluds.count(spds) > 0)
+            {
+              make_primary = false;
+              primary_fluds = spds_primary_fluds[spds];
+              fluds = new chi_mesh::sweep_management::
+              AUX_FLUDS(*primary_fluds,groupset.grp_subset_sizes[gs_ss]);
+            }
+            else if (make_primary)
             {
               make_primary = false;
               primary_fluds = new chi_mesh::sweep_management::
@@ -161,6 +185,7 @@ void LinearBoltzmann::Solver::InitAngleAggSingle(LBSGroupset& groupset)
               primary_fluds->InitializeAlphaElements(groupset.sweep_orderings[angle_num]);
               primary_fluds->InitializeBetaElements(groupset.sweep_orderings[angle_num]);
 
+              spds_primary_fluds[spds] = primary_fluds;
               fluds = primary_fluds;
             }
             else
@@ -216,7 +241,15 @@ void LinearBoltzmann::Solver::InitAngleAggSingle(LBSGroupset& groupset)
           angle_indices.push_back(n);
 
           chi_mesh::sweep_management::FLUDS* fluds;
-          if (make_primary)
+          const auto spds = groupset.sweep_orderings[n].get();
+          if (make_primary and spds_primary_fluds.count(spds) > 0)
+          {
+            make_primary = false;
+            primary_fluds = spds_primary_fluds[spds];
+            fluds = new chi_mesh::sweep_management::
+            AUX_FLUDS(*primary_fluds,groupset.grp_subset_sizes[gs_ss]);
+          }
+          else if (make_primary)
           {
             make_primary = false;
             primary_fluds = new chi_mesh::sweep_management::
@@ -247,6 +280,7 @@ void LinearBoltzmann::Solver::InitAngleAggSingle(LBSGroupset& groupset)
               exit(EXIT_FAILURE);
             }
 
+            spds_primary_fluds[spds] = primary_fluds;
             fluds = primary_fluds;
           }
           else
@@ -9,10 +9,24 @@ extern ChiLog& chi_log;
 extern ChiPhysics&  chi_physics_handler;
 
 //###################################################################
-/**Initializes the Within-Group DSA solver. */
+/**Initializes the Within-Group DSA solver. A solver kept from a
+ * previous solve is reused, with its matrix and preconditioner rebuilt
+ * according to the DSA rebuild policy.*/
 void LinearBoltzmann::Solver::InitWGDSA(LBSGroupset& groupset)
 {
-  if (groupset.apply_wgdsa)
+  if (groupset.apply_wgdsa and groupset.wgdsa_solver != nullptr)
+  {
+    auto dsolver = (chi_diffusion::Solver*)groupset.wgdsa_solver;
+
+    if (options.dsa_rebuild_policy == DSARebuildPolicy::NEVER) return;
+    if (not dsolver->MaterialDataChanged()) return;
+
+    chi_log.Log(LOG_0)
+      << "WGDSA: Cross-sections changed, rebuilding operator.";
+    delta_phi_local.assign(local_node_count * groupset.groups.size(), 0.0);
+    dsolver->ExecuteS(false, true);
+  }
+  else if (groupset.apply_wgdsa)
   {
     //================================= Initialize unknowns
     chi_math::UnknownManager scalar_uk_man;
@@ -47,6 +61,8 @@ void LinearBoltzmann::Solver::InitWGDSA(LBSGroupset& groupset)
     dsolver->basic_options["discretization_method"].SetStringValue("PWLD_MIP_GAGG");
     dsolver->basic_options["residual_tolerance"].SetFloatValue(groupset.wgdsa_tol);
     dsolver->basic_options["max_iters"].SetIntegerValue(groupset.wgdsa_max_iters);
+    dsolver->basic_options["matrix_free"].SetBoolValue(options.dsa_matrix_free);
+    dsolver->basic_options["matrix_free_pc"].SetStringValue(options.dsa_matrix_free_pc);
 
     dsolver->options_string     = groupset.wgdsa_string;
     dsolver->material_mode = DIFFUSION_MATERIALS_FROM_TRANSPORTXS_TTF;
@@ -88,18 +104,27 @@ void LinearBoltzmann::Solver::InitWGDSA(LBSGroupset& groupset)
     bool supress_solver   = true;    //Suppress the solving
     dsolver->Initialize(verbose);
     dsolver->ExecuteS(supress_assembly,supress_solver);
-
-    delta_phi_local.resize(0);
-    delta_phi_local.shrink_to_fit();
   }//if wgdsa
 }
 
 //###################################################################
-/**Cleans up memory consuming items. */
+/**Cleans up memory consuming items after a solve. The solver is kept
+ * for the next solve unless the DSA rebuild policy is ALWAYS.*/
 void LinearBoltzmann::Solver::CleanUpWGDSA(LBSGroupset& groupset)
 {
-  if (groupset.apply_wgdsa)
-    delete groupset.wgdsa_solver;
+  if (options.dsa_rebuild_policy == DSARebuildPolicy::ALWAYS)
+    ReleaseWGDSA(groupset);
+}
+
+//###################################################################
+/**Deletes the Within-Group DSA solver and its work vector.*/
+void LinearBoltzmann::Solver::ReleaseWGDSA(LBSGroupset& groupset)
+{
+  delete (chi_diffusion::Solver*)groupset.wgdsa_solver;
+  groupset.wgdsa_solver = nullptr;
+
+  delta_phi_local.clear();
+  delta_phi_local.shrink_to_fit();
 }
 
 //###################################################################
@@ -111,8 +136,7 @@ void LinearBoltzmann::Solver::AssembleWGDSADeltaPhiVector(LBSGroupset& groupset,
   int gsi = groupset.groups[0].id;
   int gss = groupset.groups.size();
 
-  delta_phi_local.clear();
-  delta_phi_local.resize(local_node_count * gss, 0.0);
+  delta_phi_local.assign(local_node_count * gss, 0.0);
 
   int index = -1;
   for (const auto& cell : grid->local_cells)
@@ -171,7 +195,4 @@ void LinearBoltzmann::Solver::DisAssembleWGDSADeltaPhiVector(LBSGroupset& groups
 
     }//for dof
   }//for cell
-
-  delta_phi_local.resize(0);
-  delta_phi_local.shrink_to_fit();
 }
\ No newline at end of file
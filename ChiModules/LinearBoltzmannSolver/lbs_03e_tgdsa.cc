@@ -9,10 +9,24 @@ extern ChiLog& chi_log;
 extern ChiPhysics&  chi_physics_handler;
 
 //###################################################################
-/**Initializes the Within-Group DSA solver. */
+/**Initializes the Two-Grid DSA solver. A solver kept from a previous
+ * solve is reused, with its matrix and preconditioner rebuilt according
+ * to the DSA rebuild policy.*/
 void LinearBoltzmann::Solver::InitTGDSA(LBSGroupset& groupset)
 {
-  if (groupset.apply_tgdsa)
+  if (groupset.apply_tgdsa and groupset.tgdsa_solver != nullptr)
+  {
+    auto dsolver = (chi_diffusion::Solver*)groupset.tgdsa_solver;
+
+    if (options.dsa_rebuild_policy == DSARebuildPolicy::NEVER) return;
+    if (not dsolver->MaterialDataChanged()) return;
+
+    chi_log.Log(LOG_0)
+      << "TGDSA: Cross-sections changed, rebuilding operator.";
+    delta_phi_local.assign(local_node_count, 0.0);
+    dsolver->ExecuteS(false, true);
+  }
+  else if (groupset.apply_tgdsa)
   {
     chi_math::UnknownManager scalar_uk_man;
     scalar_uk_man.AddUnknown(chi_math::UnknownType::SCALAR);
@@ -50,6 +64,8 @@ void LinearBoltzmann::Solver::InitTGDSA(LBSGroupset& groupset)
     dsolver->basic_options["discretization_method"].SetStringValue("PWLD_MIP");
     dsolver->basic_options["residual_tolerance"].SetFloatValue(groupset.tgdsa_tol);
     dsolver->basic_options["max_iters"].SetIntegerValue(groupset.tgdsa_max_iters);
+    dsolver->basic_options["matrix_free"].SetBoolValue(options.dsa_matrix_free);
+    dsolver->basic_options["matrix_free_pc"].SetStringValue(options.dsa_matrix_free_pc);
 
     dsolver->options_string     = groupset.tgdsa_string;
     if (groupset.apply_wgdsa)
@@ -84,18 +100,27 @@ void LinearBoltzmann::Solver::InitTGDSA(LBSGroupset& groupset)
     bool supress_solver   = true;    //Suppress the solving
     dsolver->Initialize(verbose);
     dsolver->ExecuteS(supress_assembly,supress_solver);
-
-    delta_phi_local.resize(0);
-    delta_phi_local.shrink_to_fit();
-  }//if wgdsa
+  }//if tgdsa
 }
 
 //###################################################################
-/**Cleans up memory consuming items. */
+/**Cleans up memory consuming items after a solve. The solver is kept
+ * for the next solve unless the DSA rebuild policy is ALWAYS.*/
 void LinearBoltzmann::Solver::CleanUpTGDSA(LBSGroupset& groupset)
 {
-  if (groupset.apply_tgdsa)
-    delete groupset.tgdsa_solver;
+  if (options.dsa_rebuild_policy == DSARebuildPolicy::ALWAYS)
+    ReleaseTGDSA(groupset);
+}
+
+//###################################################################
+/**Deletes the Two-Grid DSA solver and its work vector.*/
+void LinearBoltzmann::Solver::ReleaseTGDSA(LBSGroupset& groupset)
+{
+  delete (chi_diffusion::Solver*)groupset.tgdsa_solver;
+  groupset.tgdsa_solver = nullptr;
+
+  delta_phi_local.clear();
+  delta_phi_local.shrink_to_fit();
 }
 
 //###################################################################
@@ -107,7 +132,7 @@ void LinearBoltzmann::Solver::AssembleTGDSADeltaPhiVector(LBSGroupset& groupset,
   int gsi = groupset.groups[0].id;
   int gss = groupset.groups.size();
 
-  delta_phi_local.resize(local_node_count, 0.0);
+  delta_phi_local.assign(local_node_count, 0.0);
 
   int index = -1;
   for (const auto& cell : grid->local_cells)
@@ -184,7 +209,4 @@ void LinearBoltzmann::Solver::DisAssembleTGDSADeltaPhiVector(LBSGroupset& groups
 
     }//for dof
   }//for cell
-
-  delta_phi_local.resize(0);
-  delta_phi_local.shrink_to_fit();
 }
\ No newline at end of file
@@ -0,0 +1,180 @@
+#include "lbs_linear_boltzmann_solver.h"
+
+#include "../DiffusionSolver/Solver/diffusion_solver.h"
+
+#include "chi_log.h"
+extern ChiLog& chi_log;
+
+#include "ChiPhysics/chi_physics.h"
+extern ChiPhysics&  chi_physics_handler;
+
+//###################################################################
+/**Initializes the two-grid diffusion solver for the across-groupset
+ * iterations. The cross-sections are collapsed with the partial Jacobi
+ * spectrum for Gauss-Seidel and the full Jacobi spectrum for Jacobi
+ * iterations.*/
+void LinearBoltzmann::Solver::InitAGSTwoGrid()
+{
+  chi_math::UnknownManager scalar_uk_man;
+  scalar_uk_man.AddUnknown(chi_math::UnknownType::SCALAR);
+
+  //================================= Initialize field function
+  ags_delta_phi_local.resize(local_node_count, 0.0);
+  std::string text_name = std::string("AGS_Sum_Sigma_s_DeltaPhi");
+
+  auto deltaphi_ff = std::make_shared<chi_physics::FieldFunction>(
+    text_name,                                    //Text name
+    discretization,                               //Spatial Discretization
+    &ags_delta_phi_local,                         //Data vector
+    scalar_uk_man);                               //Unknown manager
+
+  chi_physics_handler.fieldfunc_stack.push_back(deltaphi_ff);
+  field_functions.push_back(deltaphi_ff);
+
+  //================================= Set diffusion solver
+  auto dsolver = new chi_diffusion::Solver("AGSTG");
+  ags_tg_solver = dsolver;
+
+  dsolver->regions.push_back(this->regions.back());
+  dsolver->discretization = discretization;
+
+  dsolver->basic_options["discretization_method"].SetStringValue("PWLD_MIP");
+  dsolver->basic_options["residual_tolerance"].
+    SetFloatValue(options.ags_two_grid_tolerance);
+  dsolver->basic_options["max_iters"].
+    SetIntegerValue(options.ags_two_grid_max_iterations);
+
+  if (options.ags_scheme == AGSScheme::JACOBI)
+    dsolver->material_mode = DIFFUSION_MATERIALS_FROM_TRANSPORTXS_TTF_JFULL;
+  else
+    dsolver->material_mode = DIFFUSION_MATERIALS_FROM_TRANSPORTXS_TTF_JPART;
+  dsolver->q_field = deltaphi_ff;
+
+  //================================= Initialize boundaries
+  if (not dsolver->common_items_initialized)
+    dsolver->InitializeCommonItems();
+
+  typedef chi_mesh::sweep_management::BoundaryType SwpBndryType;
+  dsolver->boundaries.clear();
+  for (auto& lbs_bndry : sweep_boundaries)
+  {
+    if (lbs_bndry->Type() == SwpBndryType::REFLECTING)
+      dsolver->boundaries.push_back(new chi_diffusion::BoundaryReflecting());
+    else
+      dsolver->boundaries.push_back(new chi_diffusion::BoundaryDirichlet());
+  }
+
+  dsolver->G  = 1;
+  dsolver->gi = 0;
+
+  //================================= Initialize solver, assemble matrix A
+  //                                  but suppress solution
+  dsolver->Initialize(false);
+  dsolver->ExecuteS(false, true);
+}
+
+//###################################################################
+/**Cleans up the two-grid diffusion solver.*/
+void LinearBoltzmann::Solver::CleanUpAGSTwoGrid()
+{
+  delete ags_tg_solver;
+  ags_tg_solver = nullptr;
+
+  ags_delta_phi_local.resize(0);
+  ags_delta_phi_local.shrink_to_fit();
+}
+
+//###################################################################
+/**Assembles the residual of the lagged across-groupset scattering on
+ * the first moment. For Gauss-Seidel iterations only scattering from
+ * groupsets solved later is lagged, for Jacobi iterations scattering
+ * from all other groupsets is.*/
+void LinearBoltzmann::Solver::
+  AssembleAGSTwoGridDeltaPhiVector(const std::vector<double>& ref_phi_prev,
+                                   const std::vector<double>& ref_phi_new)
+{
+  const bool jacobi = (options.ags_scheme == AGSScheme::JACOBI);
+
+  //================================= Map groups to their groupset
+  std::vector<int> group_gs_i(num_groups, 0);
+  std::vector<int> group_gs_f(num_groups, 0);
+  for (const auto& groupset : groupsets)
+    for (const auto& group : groupset.groups)
+    {
+      group_gs_i[group.id] = groupset.groups.front().id;
+      group_gs_f[group.id] = groupset.groups.back().id;
+    }
+
+  ags_delta_phi_local.assign(local_node_count, 0.0);
+
+  int index = -1;
+  for (const auto& cell : grid->local_cells)
+  {
+    auto& transport_view = cell_transport_views[cell.local_id];
+
+    int xs_id = matid_to_xs_map[cell.material_id];
+    chi_math::SparseMatrix& S = material_xs[xs_id]->transfer_matrices[0];
+
+    for (int i=0; i < cell.vertex_ids.size(); i++)
+    {
+      index++;
+      size_t mapping = transport_view.MapDOF(i,0,0);
+
+      const double* phi_prev_mapped = &ref_phi_prev[mapping];
+      const double* phi_new_mapped  = &ref_phi_new[mapping];
+
+      for (int g=0; g<num_groups; g++)
+      {
+        double R_g = 0.0;
+        int num_transfers = S.rowI_indices[g].size();
+        for (int j=0; j<num_transfers; j++)
+        {
+          int gp = S.rowI_indices[g][j];
+
+          const bool lagged = jacobi ?
+            (gp < group_gs_i[g] or gp > group_gs_f[g]) :
+            (gp > group_gs_f[g]);
+          if (not lagged)
+            continue;
+
+          double delta_phi = phi_new_mapped[gp] - phi_prev_mapped[gp];
+
+          R_g += S.rowI_values[g][j] * delta_phi;
+        }
+        ags_delta_phi_local[index] += R_g;
+      }//for g
+    }//for dof
+  }//for cell
+}
+
+//###################################################################
+/**Distributes the two-grid error over the groups of the first moment
+ * of ref_phi.*/
+void LinearBoltzmann::Solver::
+  DisAssembleAGSTwoGridDeltaPhiVector(std::vector<double>& ref_phi)
+{
+  const bool jacobi = (options.ags_scheme == AGSScheme::JACOBI);
+
+  auto tg_solver = (chi_diffusion::Solver*)ags_tg_solver;
+
+  int index = -1;
+  for (const auto& cell : grid->local_cells)
+  {
+    auto& transport_view = cell_transport_views[cell.local_id];
+
+    int xs_id = matid_to_xs_map[cell.material_id];
+    const auto& xs = material_xs[xs_id];
+    const std::vector<double>& xi_g = jacobi ? xs->xi_Jfull : xs->xi_Jpart;
+
+    for (int i=0; i < cell.vertex_ids.size(); i++)
+    {
+      index++;
+      size_t mapping = transport_view.MapDOF(i,0,0);
+
+      double* phi_mapped = &ref_phi[mapping];
+
+      for (int g=0; g<num_groups; g++)
+        phi_mapped[g] += tg_solver->pwld_phi_local[index]*xi_g[g];
+    }//for dof
+  }//for cell
+}
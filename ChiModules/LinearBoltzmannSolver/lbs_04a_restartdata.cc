@@ -1,4 +1,5 @@
 #include "lbs_linear_boltzmann_solver.h"
+#include "lbs_bulk_io.h"
 
 #include "ChiMath/SpatialDiscretization/FiniteElement/PiecewiseLinear/pwl.h"
 
@@ -7,15 +8,23 @@
 extern ChiLog& chi_log;
 extern ChiMPI& chi_mpi;
 
+#include "ChiTimer/chi_timer.h"
+extern ChiTimer chi_program_timer;
+
 #include <sys/stat.h>
 #include <fstream>
 #include <cstring>
 
 //###################################################################
-/**Writes phi_old to restart file.*/
+/**Writes phi_old to restart file. The values are block-written after a
+ * bulk_io header, compressed when options.write_restart_compressed is set.*/
 void LinearBoltzmann::Solver::WriteRestartData(std::string folder_name,
                                                std::string file_base)
 {
+  //======================================== Complete background writes
+  //                                         to the same files
+  checkpoint_writer.Wait();
+
   typedef struct stat Stat;
   Stat st;
 
@@ -46,25 +55,13 @@ void LinearBoltzmann::Solver::WriteRestartData(std::string folder_name,
   std::string file_name = folder_name + std::string("/") +
                           file_base + std::string(location_cstr);
 
-  std::ofstream ofile;
-  ofile.open(file_name, std::ios::out | std::ios::binary | std::ios::trunc);
-
-  if (not ofile.is_open())
+  if (not bulk_io::WriteRestartFile(file_name, phi_old_local,
+                                    options.write_restart_compressed))
   {
     chi_log.Log(LOG_ALLERROR)
       << "Failed to create restart file: " << file_name;
-    ofile.close();
     location_succeeded = false;
   }
-  else
-  {
-    size_t phi_old_size = phi_old_local.size();
-    ofile.write((char*)&phi_old_size, sizeof(size_t));
-    for (auto val : phi_old_local)
-      ofile.write((char*)&val, sizeof(double));
-
-    ofile.close();
-  }
 
   //======================================== Wait for all processes
   //                                         then check success status
@@ -91,7 +88,39 @@ void LinearBoltzmann::Solver::WriteRestartData(std::string folder_name,
 }
 
 //###################################################################
-/**Read phi_old from restart file.*/
+/**Determines whether the restart write interval has elapsed. Location 0
+ * decides and broadcasts the decision so that all locations submit the
+ * same sequence of checkpoints. Resets the interval when it returns
+ * true.*/
+bool LinearBoltzmann::Solver::RestartWriteIntervalElapsed()
+{
+  const double MINUTE = 60000.0; //time in milliseconds
+  int elapsed = ((chi_program_timer.GetTime()/MINUTE) >
+                 last_restart_write + options.write_restart_interval)? 1 : 0;
+
+  MPI_Bcast(&elapsed, 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+  if (elapsed)
+    last_restart_write = chi_program_timer.GetTime()/MINUTE;
+
+  return elapsed;
+}
+
+//###################################################################
+/**Snapshots phi_old and hands it to the background checkpoint writer.
+ * Unlike WriteRestartData this does not synchronize the locations, the
+ * files are written while iterations continue.*/
+void LinearBoltzmann::Solver::SubmitRestartCheckpoint()
+{
+  checkpoint_writer.Submit(options.write_restart_folder_name,
+                           options.write_restart_file_base,
+                           phi_old_local,
+                           options.write_restart_compressed);
+}
+
+//###################################################################
+/**Read phi_old from restart file. Files in the legacy format, a size
+ * followed by the raw values, are also accepted.*/
 void LinearBoltzmann::Solver::ReadRestartData(std::string folder_name,
                                               std::string file_base)
 {
@@ -111,12 +140,36 @@ void LinearBoltzmann::Solver::ReadRestartData(std::string folder_name,
 
   std::ifstream ifile;
   ifile.open(file_name, std::ios::in | std::ios::binary );
+  bool file_compressed = false;
 
   if (not ifile.is_open())
   {
     ifile.close();
     location_succeeded = false;
   }
+  else if (bulk_io::ReadHeader(ifile, bulk_io::FileType::RESTART_PHI,
+                               file_compressed))
+  {
+    uint64_t number_of_unknowns;
+    ifile.read((char*)&number_of_unknowns, sizeof(uint64_t));
+
+    if (not ifile or number_of_unknowns != phi_old_local.size())
+      location_succeeded = false;
+    else
+    {
+      std::vector<double> temp_phi_old(phi_old_local.size(),0.0);
+
+      bulk_io::BlockReader reader(ifile, sizeof(double));
+      if (reader.Read(temp_phi_old.data(),
+                      number_of_unknowns*sizeof(double)) and
+          reader.Finish())
+        phi_old_local = std::move(temp_phi_old);
+      else
+        location_succeeded = false;
+    }
+
+    ifile.close();
+  }
   else
   {
     size_t number_of_unknowns;
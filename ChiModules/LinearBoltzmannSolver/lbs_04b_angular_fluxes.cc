@@ -1,4 +1,5 @@
 #include "lbs_linear_boltzmann_solver.h"
+#include "lbs_bulk_io.h"
 
 #include "ChiMath/SpatialDiscretization/FiniteElement/PiecewiseLinear/pwl.h"
 
@@ -11,10 +12,18 @@ extern ChiMPI& chi_mpi;
 #include <cstring>
 
 //###################################################################
-/**Writes the groupset's angular fluxes to file.*/
+/**Writes the groupset's angular fluxes to file.
+ *
+ * After the bulk_io header the file contains the sizes
+ * (num_local_nodes, num_angles, num_groups, num_local_dofs,
+ * num_local_cells as uint64), an index array with a
+ * (cell_global_id, num_nodes) pair per local cell and the angular flux
+ * values, ordered by cell, node, angle and group. Both arrays are
+ * block-written and optionally compressed.*/
 void LinearBoltzmann::Solver::
   WriteGroupsetAngularFluxes(const LBSGroupset& groupset,
-                             const std::string& file_base)
+                             const std::string& file_base,
+                             bool compress/*=false*/)
 {
   std::string file_name =
     file_base + std::to_string(chi_mpi.location_id) + ".data";
@@ -33,85 +42,103 @@ void LinearBoltzmann::Solver::
     return;
   }
 
-  //============================================= Write header
-  std::string header_info =
-    "Chi-Tech LinearBoltzmann::Groupset angular flux file\n"
-    "Header size: 320 bytes\n"
-    "Structure(type-info):\n"
-    "size_t-num_local_nodes\n"
-    "size_t-num_angles\n"
-    "size_t-num_groups\n"
-    "size_t-num_records\n"
-    "Each record:\n"
-    "size_t-cell_global_id\n"
-    "unsigned int-node_number\n"
-    "unsigned int-angle_num\n"
-    "unsigned int-group_num\n"
-    "double-angular_flux\n";
-
-  int header_size = (int)header_info.length();
-
-  char header_bytes[320];
-  memset(header_bytes, '-', 320);
-  strncpy(header_bytes, header_info.c_str(),std::min(header_size,319));
-  header_bytes[319]='\0';
-
-  file << header_bytes;
-
   //============================================= Get relevant items
   auto NODES_ONLY = ChiMath::UNITARY_UNKNOWN_MANAGER;
   auto fe = std::dynamic_pointer_cast<SpatialDiscretization_PWLD>(discretization);
   if (not fe)
   {
     file.close();
-    chi_log.Log(LOG_ALLWARNING) << "Angular flux file reading cancelled "
+    chi_log.Log(LOG_ALLWARNING) << "Angular flux file writing cancelled "
                                    "because a spatial discretization has not "
                                    "been initialized.";
     return;
   }
 
-  size_t num_local_nodes = discretization->GetNumLocalDOFs(NODES_ONLY);
-  size_t num_angles      = groupset.quadrature->abscissae.size();
-  size_t num_groups      = groupset.groups.size();
-  size_t num_local_dofs  = psi_new_local[groupset.id].size();
-  auto   dof_handler     = groupset.psi_uk_man;
+  uint64_t num_local_nodes = discretization->GetNumLocalDOFs(NODES_ONLY);
+  uint64_t num_angles      = groupset.quadrature->abscissae.size();
+  uint64_t num_groups      = groupset.groups.size();
+  uint64_t num_local_dofs  = psi_new_local[groupset.id].size();
+  uint64_t num_local_cells = grid->local_cells.size();
+  auto     dof_handler     = groupset.psi_uk_man;
+  const auto& psi          = psi_new_local[groupset.id];
+
+  if (num_local_dofs != num_local_nodes*num_angles*num_groups)
+  {
+    file.close();
+    chi_log.Log(LOG_ALLWARNING) << "Angular flux file writing cancelled "
+                                   "because the groupset's angular fluxes "
+                                   "are not stored.";
+    return;
+  }
+
+  //============================================= Write header and sizes
+  bulk_io::WriteHeader(file, bulk_io::FileType::GROUPSET_PSI, compress);
 
-  //============================================= Write num_ quantities
-  file.write((char*)&num_local_nodes,sizeof(size_t));
-  file.write((char*)&num_angles     ,sizeof(size_t));
-  file.write((char*)&num_groups     ,sizeof(size_t));
-  file.write((char*)&num_local_dofs ,sizeof(size_t));
+  file.write((char*)&num_local_nodes,sizeof(uint64_t));
+  file.write((char*)&num_angles     ,sizeof(uint64_t));
+  file.write((char*)&num_groups     ,sizeof(uint64_t));
+  file.write((char*)&num_local_dofs ,sizeof(uint64_t));
+  file.write((char*)&num_local_cells,sizeof(uint64_t));
 
-  //============================================= Write per dof data
-  size_t dof_count=0;
+  //============================================= Write cell index
+  bulk_io::BlockWriter index_writer(file, compress, sizeof(uint64_t));
   for (const auto& cell : grid->local_cells)
   {
     const auto cell_fe_mapping = fe->GetCellMappingFE(cell.local_id);
+    const uint64_t num_nodes = cell_fe_mapping->num_nodes;
 
-    for (unsigned int i=0; i<cell_fe_mapping->num_nodes; ++i)
-      for (unsigned int n=0; n<num_angles; ++n)
-        for (unsigned int g=0; g<num_groups; ++g)
-        {
-          if (++dof_count > num_local_dofs) goto close_file;
+    index_writer.Append(cell.global_id);
+    index_writer.Append(num_nodes);
+  }
+  index_writer.Finish();
 
-          uint64_t dof_map = fe->MapDOFLocal(cell,i,dof_handler,n,g);
-          double value = psi_new_local[groupset.id][dof_map];
+  //============================================= Write angular fluxes
+  //The per-node (angle,group) values are contiguous in the
+  //unknown manager's layout, this is checked per node and a
+  //value-by-value gather is used otherwise.
+  const size_t num_node_values = num_angles*num_groups;
+  std::vector<double> node_values(num_node_values, 0.0);
 
-          file.write((char*)&cell.global_id,sizeof(size_t));
-          file.write((char*)&i             ,sizeof(unsigned int));
-          file.write((char*)&n             ,sizeof(unsigned int));
-          file.write((char*)&g             ,sizeof(unsigned int));
-          file.write((char*)&value         ,sizeof(double));
-        }
+  bulk_io::BlockWriter psi_writer(file, compress, sizeof(double));
+  for (const auto& cell : grid->local_cells)
+  {
+    const auto cell_fe_mapping = fe->GetCellMappingFE(cell.local_id);
+
+    for (unsigned int i=0; i<cell_fe_mapping->num_nodes; ++i)
+    {
+      const uint64_t first = fe->MapDOFLocal(cell,i,dof_handler,0,0);
+      const uint64_t last  = fe->MapDOFLocal(cell,i,dof_handler,
+                                             num_angles-1,num_groups-1);
+      const bool group_stride_1 = (num_groups < 2) or
+        (fe->MapDOFLocal(cell,i,dof_handler,0,1) == first + 1);
+      const bool angle_stride_G = (num_angles < 2) or
+        (fe->MapDOFLocal(cell,i,dof_handler,1,0) == first + num_groups);
+
+      if (last - first + 1 == num_node_values and
+          group_stride_1 and angle_stride_G)
+        psi_writer.Append(&psi[first], num_node_values*sizeof(double));
+      else
+      {
+        size_t k=0;
+        for (unsigned int n=0; n<num_angles; ++n)
+          for (unsigned int g=0; g<num_groups; ++g)
+            node_values[k++] = psi[fe->MapDOFLocal(cell,i,dof_handler,n,g)];
+        psi_writer.Append(node_values.data(), num_node_values*sizeof(double));
+      }
+    }
   }
+  psi_writer.Finish();
 
   //============================================= Clean-up
-  close_file:
+  if (not file)
+    chi_log.Log(LOG_ALLWARNING)
+      << __FUNCTION__ << "Failed writing " << file_name;
   file.close();
 }
 
 //###################################################################
-/**Prints the groupset's angular fluxes to file.*/
+/**Reads the groupset's angular fluxes from file. Both the block-written
+ * format and the legacy per-value record format are accepted.*/
 void LinearBoltzmann::Solver::
   ReadGroupsetAngularFluxes(LBSGroupset& groupset,
                             const std::string& file_base)
@@ -156,8 +183,113 @@ void LinearBoltzmann::Solver::
   size_t file_num_groups     ;
   size_t file_num_local_dofs ;
 
+  //============================================= Block-written format
+  bool file_compressed = false;
+  if (bulk_io::ReadHeader(file, bulk_io::FileType::GROUPSET_PSI,
+                          file_compressed))
+  {
+    chi_log.Log() << "Reading angular flux file " << file_name;
+    uint64_t file_num_local_cells = 0;
+    file.read((char*)&file_num_local_nodes, sizeof(uint64_t));
+    file.read((char*)&file_num_angles     , sizeof(uint64_t));
+    file.read((char*)&file_num_groups     , sizeof(uint64_t));
+    file.read((char*)&file_num_local_dofs , sizeof(uint64_t));
+    file.read((char*)&file_num_local_cells, sizeof(uint64_t));
+
+    if (not file or
+        file_num_local_nodes != num_local_nodes or
+        file_num_angles      != num_angles      or
+        file_num_groups      != num_groups      or
+        file_num_local_dofs  != num_local_dofs  or
+        file_num_local_cells != grid->local_cells.size())
+    {
+      chi_log.Log(LOG_ALL)
+        << "Incompatible DOF data found in file " << file_name;
+      file.close();
+      return;
+    }
+
+    //====================================== Read cell index
+    std::vector<std::pair<uint64_t,uint64_t>> cell_index(file_num_local_cells);
+    bulk_io::BlockReader index_reader(file, sizeof(uint64_t));
+    bool index_complete = true;
+    for (auto& [cell_global_id, num_nodes] : cell_index)
+      if (not index_reader.Read(cell_global_id) or
+          not index_reader.Read(num_nodes))
+      {
+        index_complete = false;
+        break;
+      }
+
+    if (not index_reader.Finish() or not index_complete)
+    {
+      chi_log.Log(LOG_ALL) << "Corrupt cell index in file " << file_name;
+      file.close();
+      return;
+    }
+
+    for (const auto& [cell_global_id, num_nodes] : cell_index)
+    {
+      if (not grid->IsCellLocal(cell_global_id) or
+          num_nodes != static_cast<uint64_t>(
+            fe->GetCellMappingFE(grid->cells[cell_global_id].local_id)->num_nodes))
+      {
+        chi_log.Log(LOG_ALL) << "Incompatible cell data found in file "
+                             << file_name;
+        file.close();
+        return;
+      }
+    }
+
+    //====================================== Read angular fluxes
+    //Values are decoded into a temporary so that psi is left untouched
+    //when the file turns out to be corrupt
+    const size_t num_node_values = num_angles*num_groups;
+    std::vector<double> node_values(num_node_values, 0.0);
+    std::vector<double> file_psi(psi);
+
+    bulk_io::BlockReader psi_reader(file, sizeof(double));
+    for (const auto& [cell_global_id, num_nodes] : cell_index)
+    {
+      const auto& cell = grid->cells[cell_global_id];
+
+      for (unsigned int i=0; i<num_nodes; ++i)
+      {
+        if (not psi_reader.Read(node_values.data(),
+                                num_node_values*sizeof(double)))
+        {
+          chi_log.Log(LOG_ALL) << "Corrupt angular flux data in file "
+                               << file_name;
+          file.close();
+          return;
+        }
+
+        size_t k=0;
+        for (unsigned int n=0; n<num_angles; ++n)
+          for (unsigned int g=0; g<num_groups; ++g)
+            file_psi[fe->MapDOFLocal(cell,i,dof_handler,n,g)] = node_values[k++];
+      }
+    }
+
+    if (not psi_reader.Finish())
+    {
+      chi_log.Log(LOG_ALL) << "Corrupt angular flux data in file "
+                           << file_name;
+      file.close();
+      return;
+    }
+
+    psi = std::move(file_psi);
+
+    chi_log.Log(LOG_ALL) << "Number of cells read: " << cell_index.size();
+
+    file.close();
+    return;
+  }
+
 
-  //============================================= Read header
+  //============================================= Legacy format
+  //                                              Read header
   chi_log.Log() << "Reading angular flux file " << file_name;
   char header_bytes[320]; header_bytes[319] = '\0';
   file.read(header_bytes,319);
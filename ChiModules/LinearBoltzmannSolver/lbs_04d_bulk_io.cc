@@ -0,0 +1,223 @@
+#include "lbs_bulk_io.h"
+
+#include "chi_misc_utils.h"
+
+#include <cstring>
+#include <algorithm>
+
+//###################################################################
+/**Writes the fixed size file header.*/
+void LinearBoltzmann::bulk_io::
+  WriteHeader(std::ofstream& file, FileType file_type, bool compressed)
+{
+  FileHeader header;
+  header.file_type  = static_cast<uint32_t>(file_type);
+  header.compressed = compressed? 1 : 0;
+
+  file.write((char*)&header, sizeof(FileHeader));
+}
+
+//###################################################################
+/**Reads and checks the file header. If the file does not start with the
+ * format's magic string the stream is rewound to the beginning and false
+ * is returned, which allows callers to fall back to legacy formats.*/
+bool LinearBoltzmann::bulk_io::
+  ReadHeader(std::ifstream& file, FileType file_type, bool& compressed)
+{
+  const FileHeader reference;
+  FileHeader header;
+
+  file.read((char*)&header, sizeof(FileHeader));
+
+  if (not file or
+      std::memcmp(header.magic, reference.magic, sizeof(header.magic)) != 0 or
+      header.version != FORMAT_VERSION or
+      header.file_type != static_cast<uint32_t>(file_type))
+  {
+    file.clear();
+    file.seekg(0, std::ios::beg);
+    return false;
+  }
+
+  compressed = (header.compressed != 0);
+  return true;
+}
+
+//###################################################################
+/**Writes a restart file holding the size of phi followed by its values.
+ * Performs no logging or communication so that it can be called from
+ * an I/O thread. Returns false if the file could not be written.*/
+bool LinearBoltzmann::bulk_io::
+  WriteRestartFile(const std::string& file_name,
+                   const std::vector<double>& phi,
+                   bool compress)
+{
+  std::ofstream ofile;
+  ofile.open(file_name, std::ios::out | std::ios::binary | std::ios::trunc);
+
+  if (not ofile.is_open()) return false;
+
+  WriteHeader(ofile, FileType::RESTART_PHI, compress);
+
+  uint64_t phi_size = phi.size();
+  ofile.write((char*)&phi_size, sizeof(uint64_t));
+
+  BlockWriter writer(ofile, compress, sizeof(double));
+  writer.Append(phi.data(), phi_size*sizeof(double));
+  writer.Finish();
+
+  const bool succeeded = static_cast<bool>(ofile);
+  ofile.close();
+
+  return succeeded;
+}
+
+//###################################################################
+/**Constructor.*/
+LinearBoltzmann::bulk_io::BlockWriter::
+  BlockWriter(std::ofstream& in_file, bool in_compress, size_t in_element_size) :
+  file(in_file),
+  compress(in_compress),
+  element_size(in_element_size)
+{
+  buffer.reserve(BLOCK_SIZE);
+}
+
+//###################################################################
+/**Appends bytes to the current block, writing out every block that
+ * fills up.*/
+void LinearBoltzmann::bulk_io::BlockWriter::
+  Append(const void* data, size_t num_bytes)
+{
+  const char* bytes = static_cast<const char*>(data);
+  while (num_bytes > 0)
+  {
+    const size_t num_copy = std::min(num_bytes, BLOCK_SIZE - buffer.size());
+    buffer.insert(buffer.end(), bytes, bytes + num_copy);
+    bytes     += num_copy;
+    num_bytes -= num_copy;
+
+    if (buffer.size() == BLOCK_SIZE) FlushBlock();
+  }
+}
+
+//###################################################################
+/**Writes the current block, compressed if requested and beneficial.*/
+void LinearBoltzmann::bulk_io::BlockWriter::FlushBlock()
+{
+  if (buffer.empty()) return;
+
+  const auto raw_size = static_cast<uint32_t>(buffer.size());
+
+  std::vector<char> compressed_block;
+  if (compress)
+    compressed_block = chi_misc_utils::CompressBlock(buffer.data(),
+                                                     buffer.size(),
+                                                     element_size);
+
+  if (compress and compressed_block.size() < buffer.size())
+  {
+    const auto stored_size = static_cast<uint32_t>(compressed_block.size());
+    file.write((char*)&raw_size, sizeof(uint32_t));
+    file.write((char*)&stored_size, sizeof(uint32_t));
+    file.write(compressed_block.data(), stored_size);
+  }
+  else
+  {
+    file.write((char*)&raw_size, sizeof(uint32_t));
+    file.write((char*)&raw_size, sizeof(uint32_t));
+    file.write(buffer.data(), raw_size);
+  }
+
+  buffer.clear();
+}
+
+//###################################################################
+/**Writes the remaining data and the array terminator.*/
+void LinearBoltzmann::bulk_io::BlockWriter::Finish()
+{
+  FlushBlock();
+
+  const uint32_t zero = 0;
+  file.write((char*)&zero, sizeof(uint32_t));
+  file.write((char*)&zero, sizeof(uint32_t));
+}
+
+//###################################################################
+/**Constructor.*/
+LinearBoltzmann::bulk_io::BlockReader::
+  BlockReader(std::ifstream& in_file, size_t in_element_size) :
+  file(in_file),
+  element_size(in_element_size)
+{}
+
+//###################################################################
+/**Reads the next block into the buffer. Returns false at the end of the
+ * array or if the block is corrupt.*/
+bool LinearBoltzmann::bulk_io::BlockReader::LoadBlock()
+{
+  if (done) return false;
+
+  uint32_t raw_size = 0;
+  uint32_t stored_size = 0;
+  file.read((char*)&raw_size, sizeof(uint32_t));
+  file.read((char*)&stored_size, sizeof(uint32_t));
+  if (not file) {done = true; return false;}
+  if (raw_size == 0) {done = true; return false;}
+  if (raw_size > BLOCK_SIZE or stored_size > raw_size)
+  {done = true; return false;}
+
+  buffer.resize(raw_size);
+  buffer_pos = 0;
+
+  if (stored_size == raw_size)
+  {
+    file.read(buffer.data(), raw_size);
+    return static_cast<bool>(file);
+  }
+
+  std::vector<char> stored(stored_size);
+  file.read(stored.data(), stored_size);
+  if (not file) return false;
+
+  return chi_misc_utils::DecompressBlock(stored.data(), stored_size,
+                                         buffer.data(), raw_size,
+                                         element_size);
+}
+
+//###################################################################
+/**Reads num_bytes into dest. Returns false if the array ends early or
+ * is corrupt.*/
+bool LinearBoltzmann::bulk_io::BlockReader::Read(void* dest, size_t num_bytes)
+{
+  char* bytes = static_cast<char*>(dest);
+  while (num_bytes > 0)
+  {
+    if (buffer_pos == buffer.size())
+      if (not LoadBlock()) return false;
+
+    const size_t num_copy = std::min(num_bytes, buffer.size() - buffer_pos);
+    std::memcpy(bytes, buffer.data() + buffer_pos, num_copy);
+    buffer_pos += num_copy;
+    bytes      += num_copy;
+    num_bytes  -= num_copy;
+  }
+  return true;
+}
+
+//###################################################################
+/**Consumes the array terminator. Returns false if unread data
+ * remains.*/
+bool LinearBoltzmann::bulk_io::BlockReader::Finish()
+{
+  if (buffer_pos != buffer.size()) return false;
+  if (done) return true;
+
+  uint32_t raw_size = 0;
+  uint32_t stored_size = 0;
+  file.read((char*)&raw_size, sizeof(uint32_t));
+  file.read((char*)&stored_size, sizeof(uint32_t));
+  done = true;
+
+  return static_cast<bool>(file) and raw_size == 0;
+}
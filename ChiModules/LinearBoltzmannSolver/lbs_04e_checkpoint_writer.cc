@@ -0,0 +1,182 @@
+#include "lbs_checkpoint_writer.h"
+#include "lbs_bulk_io.h"
+
+#include "chi_log.h"
+extern ChiLog& chi_log;
+extern ChiMPI& chi_mpi;
+
+#include <sys/stat.h>
+#include <cstdio>
+#include <fstream>
+
+//###################################################################
+/**Completes any outstanding checkpoint and stops the I/O thread.*/
+LinearBoltzmann::CheckpointWriter::~CheckpointWriter()
+{
+  int mpi_finalized = 0;
+  MPI_Finalized(&mpi_finalized);
+  if (not mpi_finalized) Wait();
+
+  {
+    std::lock_guard<std::mutex> lock(io_mutex);
+    io_shutdown = true;
+  }
+  io_cv.notify_all();
+
+  if (io_thread.joinable()) io_thread.join();
+}
+
+//###################################################################
+/**Snapshots phi and schedules it to be written to
+ * `<folder_name>/<file_base><location_id>.r`. If the previous checkpoint
+ * has not been committed yet this call first waits for it.*/
+void LinearBoltzmann::CheckpointWriter::
+  Submit(const std::string& folder_name,
+         const std::string& file_base,
+         const std::vector<double>& phi,
+         bool compress)
+{
+  Wait();
+
+  if (not io_thread.joinable())
+    io_thread = std::thread(&CheckpointWriter::IOThreadLoop, this);
+
+  {
+    std::lock_guard<std::mutex> lock(io_mutex);
+    staging_buffer.assign(phi.begin(), phi.end());
+    job_folder_name = folder_name;
+    job_file_base   = file_base;
+    job_file_name   = folder_name + "/" + file_base +
+                      std::to_string(chi_mpi.location_id) + ".r";
+    job_compress    = compress;
+    job_written     = false;
+    job_succeeded   = false;
+    job_pending     = true;
+  }
+  io_cv.notify_all();
+}
+
+//###################################################################
+/**Progresses the current checkpoint without blocking. Should be called
+ * regularly, e.g. once per iteration, by all locations.*/
+void LinearBoltzmann::CheckpointWriter::Poll()
+{
+  if (not job_pending) return;
+
+  if (not commit_pending)
+  {
+    std::unique_lock<std::mutex> lock(io_mutex);
+    if (not job_written) return;
+    lock.unlock();
+
+    StartCommit();
+  }
+
+  int commit_done = 0;
+  MPI_Test(&commit_request, &commit_done, MPI_STATUS_IGNORE);
+  if (commit_done) FinalizeCommit();
+}
+
+//###################################################################
+/**Blocks until the current checkpoint, if any, has been written and
+ * committed.*/
+void LinearBoltzmann::CheckpointWriter::Wait()
+{
+  if (not job_pending) return;
+
+  if (not commit_pending)
+  {
+    std::unique_lock<std::mutex> lock(io_mutex);
+    io_cv.wait(lock, [this]{return job_written;});
+    lock.unlock();
+
+    StartCommit();
+  }
+
+  MPI_Wait(&commit_request, MPI_STATUS_IGNORE);
+  FinalizeCommit();
+}
+
+//###################################################################
+/**Starts the reduction of the locations' success flags.*/
+void LinearBoltzmann::CheckpointWriter::StartCommit()
+{
+  commit_local_flag = job_succeeded? 1 : 0;
+  MPI_Iallreduce(&commit_local_flag,   //Send buffer
+                 &commit_global_flag,  //Recv buffer
+                 1,                    //count
+                 MPI_INT,              //Data type
+                 MPI_LAND,             //Operation - Logical and
+                 MPI_COMM_WORLD,       //Communicator
+                 &commit_request);
+  commit_pending = true;
+}
+
+//###################################################################
+/**Writes the commit marker once all locations have succeeded.*/
+void LinearBoltzmann::CheckpointWriter::FinalizeCommit()
+{
+  commit_pending = false;
+  {
+    std::lock_guard<std::mutex> lock(io_mutex);
+    job_pending = false;
+  }
+  ++checkpoint_count;
+
+  if (not commit_global_flag)
+  {
+    chi_log.Log(LOG_0ERROR)
+      << "Failed to write restart data: "
+      << job_folder_name + "/" + job_file_base + "X.r";
+    return;
+  }
+
+  if (chi_mpi.location_id == 0)
+  {
+    std::ofstream marker(job_folder_name + "/" + job_file_base + ".commit",
+                         std::ios::out | std::ios::trunc);
+    marker << checkpoint_count << "\n";
+    marker.close();
+  }
+
+  chi_log.Log(LOG_0)
+    << "Successfully wrote restart data: "
+    << job_folder_name + "/" + job_file_base + "X.r";
+}
+
+//###################################################################
+/**Body of the I/O thread. Writes each staged checkpoint to a temporary
+ * file, which is renamed over the restart file only once it has been
+ * completely written.*/
+void LinearBoltzmann::CheckpointWriter::IOThreadLoop()
+{
+  std::unique_lock<std::mutex> lock(io_mutex);
+  while (true)
+  {
+    io_cv.wait(lock, [this]{return io_shutdown or
+                                   (job_pending and not job_written);});
+    if (io_shutdown) return;
+
+    const std::string folder_name = job_folder_name;
+    const std::string file_name   = job_file_name;
+    const bool compress           = job_compress;
+    lock.unlock();
+
+    //staging_buffer is not modified while a job is pending
+    const std::string temp_file_name = file_name + ".tmp";
+
+    mkdir(folder_name.c_str(), S_IRWXU | S_IRWXG | S_IRWXO);
+
+    bool succeeded = bulk_io::WriteRestartFile(temp_file_name,
+                                               staging_buffer,
+                                               compress);
+    if (succeeded)
+      succeeded = (std::rename(temp_file_name.c_str(),
+                               file_name.c_str()) == 0);
+
+    lock.lock();
+    job_succeeded = succeeded;
+    job_written   = true;
+    io_cv.notify_all();
+  }
+}
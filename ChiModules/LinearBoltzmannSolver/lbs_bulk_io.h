@@ -0,0 +1,93 @@
+#ifndef LBS_BULK_IO_H
+#define LBS_BULK_IO_H
+
+#include <fstream>
+#include <vector>
+#include <cstdint>
+#include <string>
+
+namespace LinearBoltzmann
+{
+/**Utilities for the block-written binary checkpoint format used by the
+ * restart and angular flux files.
+ *
+ * A file starts with a fixed 32 byte FileHeader. It is followed by one or
+ * more arrays, each written by a BlockWriter as a sequence of blocks.
+ * Every block starts with its raw and stored sizes (two uint32) followed
+ * by the stored bytes. A stored size equal to the raw size denotes an
+ * uncompressed block. An array is terminated by a block with a raw size
+ * of zero.*/
+namespace bulk_io
+{
+  enum class FileType : uint32_t
+  {
+    RESTART_PHI       = 1,
+    GROUPSET_PSI      = 2
+  };
+
+  const uint32_t FORMAT_VERSION = 1;
+  const size_t   BLOCK_SIZE     = size_t(1) << 20;
+
+  struct FileHeader
+  {
+    char     magic[8] = {'C','H','I','B','U','L','K','\0'};
+    uint32_t version      = FORMAT_VERSION;
+    uint32_t file_type    = 0;
+    uint32_t compressed   = 0;
+    uint32_t reserved[3]  = {0,0,0};
+  };
+
+  void WriteHeader(std::ofstream& file, FileType file_type, bool compressed);
+  bool ReadHeader(std::ifstream& file, FileType file_type, bool& compressed);
+
+  bool WriteRestartFile(const std::string& file_name,
+                        const std::vector<double>& phi,
+                        bool compress);
+
+  //###################################################################
+  /**Streams an array of fixed-size elements to file in blocks of
+   * BLOCK_SIZE bytes, optionally compressing each block.*/
+  class BlockWriter
+  {
+  private:
+    std::ofstream&    file;
+    const bool        compress;
+    const size_t      element_size;
+    std::vector<char> buffer;
+
+    void FlushBlock();
+  public:
+    BlockWriter(std::ofstream& in_file, bool in_compress, size_t in_element_size);
+
+    void Append(const void* data, size_t num_bytes);
+    template<typename T> void Append(const T& value)
+    { Append(&value, sizeof(T)); }
+
+    void Finish();
+  };
+
+  //###################################################################
+  /**Reads back an array written by a BlockWriter.*/
+  class BlockReader
+  {
+  private:
+    std::ifstream&    file;
+    const size_t      element_size;
+    std::vector<char> buffer;
+    size_t            buffer_pos = 0;
+    bool              done = false;
+
+    bool LoadBlock();
+  public:
+    BlockReader(std::ifstream& in_file, size_t in_element_size);
+
+    bool Read(void* dest, size_t num_bytes);
+    template<typename T> bool Read(T& value)
+    { return Read(&value, sizeof(T)); }
+
+    bool Finish();
+  };
+}//namespace bulk_io
+}//namespace LinearBoltzmann
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef LBS_CHECKPOINT_WRITER_H
+#define LBS_CHECKPOINT_WRITER_H
+
+#include "chi_mpi.h"
+
+#include <vector>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace LinearBoltzmann
+{
+//###################################################################
+/**Writes restart checkpoints in the background.
+ *
+ * Submit() snapshots the flux moments into a staging buffer and hands it
+ * to a dedicated I/O thread, which writes the location's restart file
+ * while the solver continues iterating. The file is written under a
+ * temporary name and renamed once complete. When all locations have
+ * finished, a non-blocking reduction of their success flags is performed
+ * and location 0 writes a commit marker, `<folder>/<file_base>.commit`,
+ * holding the number of the checkpoint. Only the main thread performs MPI
+ * calls, progressing the reduction in Poll() or Wait().
+ *
+ * Every location must submit the same sequence of checkpoints.*/
+class CheckpointWriter
+{
+private:
+  std::thread             io_thread;
+  std::mutex              io_mutex;
+  std::condition_variable io_cv;
+  bool                    io_shutdown = false;
+
+  //====================================== Staged checkpoint
+  bool                    job_pending   = false;
+  bool                    job_written   = false;
+  bool                    job_succeeded = false;
+  std::string             job_folder_name;
+  std::string             job_file_base;
+  std::string             job_file_name;
+  bool                    job_compress  = false;
+  std::vector<double>     staging_buffer;
+
+  //====================================== Global commit
+  bool                    commit_pending = false;
+  MPI_Request             commit_request = MPI_REQUEST_NULL;
+  int                     commit_local_flag  = 0;
+  int                     commit_global_flag = 0;
+  uint64_t                checkpoint_count   = 0;
+
+public:
+  CheckpointWriter() = default;
+  ~CheckpointWriter();
+
+  CheckpointWriter(const CheckpointWriter&) = delete;
+  CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+  void Submit(const std::string& folder_name,
+              const std::string& file_base,
+              const std::vector<double>& phi,
+              bool compress);
+  void Poll();
+  void Wait();
+
+private:
+  void IOThreadLoop();
+  void StartCommit();
+  void FinalizeCommit();
+};
+
+}//namespace LinearBoltzmann
+
+#endif
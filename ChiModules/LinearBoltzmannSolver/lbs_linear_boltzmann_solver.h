@@ -8,6 +8,8 @@
 #include "ChiPhysics/PhysicsMaterial/material_property_isotropic_mg_src.h"
 #include "ChiMath/SpatialDiscretization/spatial_discretization.h"
 #include "lbs_structs.h"
+#include "lbs_checkpoint_writer.h"
+#include "lbs_source_operator.h"
 #include "ChiMesh/SweepUtilities/sweep_namespace.h"
 #include "ChiMesh/SweepUtilities/SweepBoundary/sweep_boundaries.h"
 #include "ChiMath/SparseMatrix/chi_math_sparse_matrix.h"
@@ -59,6 +61,7 @@ protected:
 
 public:
   double last_restart_write=0.0;
+  CheckpointWriter checkpoint_writer;
   LinearBoltzmann::Options options;    //In chi_npt_structs.h
 
   size_t num_moments;
@@ -70,6 +73,8 @@ public:
   std::vector<LBSGroupset> groupsets;
   std::vector<std::shared_ptr<chi_physics::TransportCrossSections>> material_xs;
   std::vector<std::shared_ptr<chi_physics::IsotropicMultiGrpSource>> material_srcs;
+  std::vector<MaterialSourceOperator> source_operators;
+  bool source_operators_use_precursors = false;
   std::vector<int> matid_to_xs_map;
   std::vector<int> matid_to_src_map;
 
@@ -96,6 +101,8 @@ public:
   std::vector<double> q_moments_local, ext_src_moments_local;
   std::vector<double> phi_new_local, phi_old_local;
   std::vector<double> delta_phi_local;
+  std::vector<double> ags_delta_phi_local;
+  chi_physics::Solver* ags_tg_solver = nullptr;
   std::vector<std::vector<double>> psi_new_local;
   std::vector<double> precursor_new_local;
 
@@ -120,10 +127,17 @@ public:
   virtual void InitializeParrays();
   //01e
   void InitializeGroupsets();
+  //01f
+  void InitSourceOperators();
 
   //02
   void Execute() override;
   void SolveGroupset(LBSGroupset& groupset);
+  void SolveGroupset(LBSGroupset& groupset,
+                     MainSweepScheduler& sweep_scheduler,
+                     SourceFlags ags_source_flags);
+  //02b
+  void SolveAcrossGroupsets();
 
   //03a
   void ComputeSweepOrderings(LBSGroupset& groupset) const;
@@ -143,6 +157,7 @@ public:
   void DisAssembleWGDSADeltaPhiVector(LBSGroupset& groupset,
                                       double *ref_phi_new);
   void CleanUpWGDSA(LBSGroupset& groupset);
+  void ReleaseWGDSA(LBSGroupset& groupset);
   //03e
   void InitTGDSA(LBSGroupset& groupset);
   void AssembleTGDSADeltaPhiVector(LBSGroupset& groupset, double *ref_phi_old,
@@ -150,17 +165,27 @@ public:
   void DisAssembleTGDSADeltaPhiVector(LBSGroupset& groupset,
                                       double *ref_phi_new);
   void CleanUpTGDSA(LBSGroupset& groupset);
+  void ReleaseTGDSA(LBSGroupset& groupset);
   //03f
   void ResetSweepOrderings(LBSGroupset& groupset);
+  //03g
+  void InitAGSTwoGrid();
+  void AssembleAGSTwoGridDeltaPhiVector(const std::vector<double>& ref_phi_prev,
+                                        const std::vector<double>& ref_phi_new);
+  void DisAssembleAGSTwoGridDeltaPhiVector(std::vector<double>& ref_phi);
+  void CleanUpAGSTwoGrid();
 
   //04 File IO
   //04a
   void WriteRestartData(std::string folder_name, std::string file_base);
   void ReadRestartData(std::string folder_name, std::string file_base);
+  bool RestartWriteIntervalElapsed();
+  void SubmitRestartCheckpoint();
 
   //05
   void WriteGroupsetAngularFluxes(const LBSGroupset& groupset,
-                                  const std::string& file_base);
+                                  const std::string& file_base,
+                                  bool compress=false);
   void ReadGroupsetAngularFluxes(LBSGroupset& groupset,
                                  const std::string& file_base);
 
@@ -177,6 +202,8 @@ public:
                          std::vector<double>&  destination_q,
                          SourceFlags source_flags);
   double ComputePiecewiseChange(LBSGroupset& groupset);
+  double ComputePiecewiseChangeAndUpdate(LBSGroupset& groupset);
+  double ComputeAGSPiecewiseChange(const std::vector<double>& ref_phi_prev);
   virtual std::shared_ptr<SweepChunk> SetSweepChunk(LBSGroupset& groupset);
   bool ClassicRichardson(LBSGroupset& groupset,
                          MainSweepScheduler& sweep_scheduler,
@@ -189,12 +216,19 @@ public:
              bool log_info = true);
 
   //Vector assembly
+  FluxMomentSpan GetFluxMomentSpan(size_t first_group,
+                                   size_t span_num_groups) const;
+  FluxMomentSpan GetFluxMomentSpan(const LBSGroupset& groupset) const;
   void SetPETScVecFromSTLvector(LBSGroupset& groupset, Vec x,
                                 const std::vector<double>& y,
                                 bool with_delayed_psi= false);
   void SetSTLvectorFromPETScVec(LBSGroupset& groupset, Vec x_src,
                                 std::vector<double>& y,
                                 bool with_delayed_psi= false);
+  void SetSTLvectorsFromPETScVec(LBSGroupset& groupset, Vec x_src,
+                                 std::vector<double>& y,
+                                 std::vector<double>& z,
+                                 bool with_delayed_psi= false);
   void ScopedCopySTLvectors(LBSGroupset& groupset,
                             const std::vector<double>& x_src,
                             std::vector<double>& y);
@@ -0,0 +1,135 @@
+#ifndef LBS_SOURCE_OPERATOR_H
+#define LBS_SOURCE_OPERATOR_H
+
+#include "ChiPhysics/PhysicsMaterial/transportxsections/material_property_transportxsections.h"
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+namespace LinearBoltzmann
+{
+namespace source_kernels
+{
+//###################################################################
+/**Dot product of two contiguous arrays.*/
+inline double Dot(const double* __restrict a,
+                  const double* __restrict b, const size_t n)
+{
+  double sum = 0.0;
+  for (size_t k=0; k<n; ++k)
+    sum += a[k]*b[k];
+  return sum;
+}
+
+//###################################################################
+/**Dot product of the contiguous sub-range [begin,end) of a and b.*/
+inline double DotRange(const double* __restrict a,
+                       const double* __restrict b,
+                       const size_t begin, const size_t end)
+{
+  return (end > begin)? Dot(a + begin, b + begin, end - begin) : 0.0;
+}
+}//namespace source_kernels
+
+//###################################################################
+/**Flat storage of a single Legendre moment of a group-to-group transfer
+ * matrix.
+ *
+ * Rows are stored either as dense bands, holding all values from the
+ * row's first to its last non-zero column, or in compressed sparse row
+ * form. The banded form is chosen when it stores at most twice the
+ * number of non-zeros, which is the case for the typical
+ * down-scattering dominated matrices, and allows every row to be applied
+ * as a contiguous dot product.*/
+class FlatTransferMatrix
+{
+public:
+  bool                  banded = true;
+  std::vector<size_t>   row_offsets;  ///< Offsets into values, size G+1
+  std::vector<uint32_t> row_begin;    ///< First column of each band
+  std::vector<uint32_t> columns;      ///< Column indices, CSR form only
+  std::vector<double>   values;
+
+public:
+  FlatTransferMatrix() = default;
+  FlatTransferMatrix(const chi_math::SparseMatrix& S, size_t num_groups);
+
+  //###################################################################
+  /**Returns the within-range (gprime in [gs_i,gs_f]) and out-of-range
+   * contributions of row g applied to the group block phi, combined
+   * according to the flags.*/
+  double ApplyRow(const size_t g, const double* __restrict phi,
+                  const size_t gs_i, const size_t gs_f,
+                  const bool within, const bool across) const
+  {
+    const double* row_values = values.data() + row_offsets[g];
+    const size_t  row_size   = row_offsets[g+1] - row_offsets[g];
+
+    if (banded)
+    {
+      const size_t b = row_begin[g];
+      const size_t e = b + row_size;
+      const double* row_phi = phi + b;
+
+      if (within and across)
+        return source_kernels::Dot(row_values, row_phi, row_size);
+
+      //Local column range of the groupset inside the band
+      const size_t gs_b = std::min(std::max(gs_i, b), e) - b;
+      const size_t gs_e = std::min(std::max(gs_f + 1, b), e) - b;
+
+      double sum = 0.0;
+      if (within)
+        sum += source_kernels::DotRange(row_values, row_phi, gs_b, gs_e);
+      if (across)
+      {
+        sum += source_kernels::DotRange(row_values, row_phi, 0, gs_b);
+        sum += source_kernels::DotRange(row_values, row_phi, gs_e, row_size);
+      }
+      return sum;
+    }
+
+    const uint32_t* row_columns = columns.data() + row_offsets[g];
+    const size_t span = gs_f - gs_i;
+    const double w_within = within? 1.0 : 0.0;
+    const double w_across = across? 1.0 : 0.0;
+
+    double sum = 0.0;
+    for (size_t k=0; k<row_size; ++k)
+    {
+      const size_t gp = row_columns[k];
+      const bool inside = (gp - gs_i) <= span; //unsigned wrap-around
+      sum += (inside? w_within : w_across) * row_values[k] * phi[gp];
+    }
+    return sum;
+  }
+};
+
+//###################################################################
+/**Precompiled scattering and fission source operator of a material.
+ *
+ * The fission operator is stored as a sum of rank-1 terms
+ * \f$ \chi_t \otimes \nu\sigma_{f,t} \f$. Without precursors there is
+ * a single term. With precursors the prompt and delayed terms are
+ * combined into two, the delayed spectrum being weighted by the
+ * precursor yields. The fission source of a node therefore costs
+ * O(G) instead of O(G^2).*/
+class MaterialSourceOperator
+{
+public:
+  std::vector<FlatTransferMatrix>  transfer;      ///< Per Legendre moment
+  bool                             is_fissile = false;
+  std::vector<std::vector<double>> fission_chi;
+  std::vector<std::vector<double>> fission_nu_sigma_f;
+
+public:
+  MaterialSourceOperator() = default;
+  MaterialSourceOperator(const chi_physics::TransportCrossSections& xs,
+                         size_t num_groups,
+                         bool use_precursors);
+};
+
+}//namespace LinearBoltzmann
+
+#endif
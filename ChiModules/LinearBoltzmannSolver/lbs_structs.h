@@ -20,6 +20,21 @@ enum class GeometryType
   THREED_CARTESIAN = 6
 };
 
+/**Across-groupset iteration schemes.*/
+enum class AGSScheme
+{
+  GAUSS_SEIDEL = 1,  ///< Groupsets use the latest fluxes of all others
+  JACOBI       = 2   ///< Groupsets use the fluxes of the previous iteration
+};
+
+/**When the DSA operators kept between solves are rebuilt.*/
+enum class DSARebuildPolicy
+{
+  ALWAYS       = 1,  ///< Rebuilt for every solve
+  ON_XS_CHANGE = 2,  ///< Rebuilt when the diffusion coefficients change
+  NEVER        = 3   ///< Built once per initialization
+};
+
 /**Struct for storing LBS options.*/
 struct Options
 {
@@ -29,6 +44,20 @@ struct Options
   SDMType sd_type = SDMType::UNDEFINED;
   unsigned int scattering_order=1;
   int  sweep_eager_limit= 32000; //see chiLBSSetProperty documentation
+  int  num_sweep_threads= 1;     //see chiLBSSetProperty documentation
+  bool use_persistent_sweep_comm = false;
+  bool sweep_distributed_tdg = false;
+
+  AGSScheme ags_scheme = AGSScheme::GAUSS_SEIDEL;
+  int    ags_max_iterations = 1;     //see chiLBSSetProperty documentation
+  double ags_tolerance = 1.0e-6;
+  bool   ags_two_grid = false;
+  double ags_two_grid_tolerance = 1.0e-4;
+  int    ags_two_grid_max_iterations = 100;
+
+  DSARebuildPolicy dsa_rebuild_policy = DSARebuildPolicy::ON_XS_CHANGE;
+  bool        dsa_matrix_free = false;        //see chiLBSSetProperty documentation
+  std::string dsa_matrix_free_pc = std::string("CELL_BLOCK");
 
   bool read_restart_data=false;
   std::string read_restart_folder_name = std::string("YRestart");
@@ -38,6 +67,11 @@ struct Options
   std::string write_restart_folder_name = std::string("YRestart");
   std::string write_restart_file_base   = std::string("restart");
   double write_restart_interval = 30.0;
+  bool write_restart_compressed = false;
+
+  bool sweep_ordering_cache = false;
+  std::string sweep_ordering_cache_folder_name = std::string("YSweepOrderings");
+  std::string sweep_ordering_cache_file_base   = std::string("spds");
 
   bool use_precursors = false;
   bool use_src_moments = false;
@@ -111,6 +145,19 @@ public:
   }
 };
 
+//###################################################################
+/**Range of a set of consecutive groups within the flux-moment vectors.
+ * The groups occupy block_size contiguous entries starting at
+ * first_index + b*stride, for b in [0,num_blocks). There is one block per
+ * node and moment, the moments of a node being consecutive blocks.*/
+struct FluxMomentSpan
+{
+  size_t first_index = 0;
+  size_t block_size  = 0;
+  size_t stride      = 0;
+  size_t num_blocks  = 0;
+};
+
 }
 
 #endif
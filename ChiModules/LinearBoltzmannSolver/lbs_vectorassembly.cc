@@ -1,5 +1,33 @@
 #include "lbs_linear_boltzmann_solver.h"
 
+#include <algorithm>
+
+//###################################################################
+/**Returns the range of span_num_groups groups, starting at first_group,
+ * within the flux-moment vectors. The cells of this location are laid
+ * out consecutively, node by node, so that the range is uniformly
+ * strided.*/
+LinearBoltzmann::FluxMomentSpan LinearBoltzmann::Solver::
+  GetFluxMomentSpan(size_t first_group, size_t span_num_groups) const
+{
+  FluxMomentSpan span;
+  span.first_index = first_group;
+  span.block_size  = span_num_groups;
+  span.stride      = num_groups;
+  span.num_blocks  = local_node_count * num_moments;
+
+  return span;
+}
+
+//###################################################################
+/**Returns the range of a groupset within the flux-moment vectors.*/
+LinearBoltzmann::FluxMomentSpan LinearBoltzmann::Solver::
+  GetFluxMomentSpan(const LBSGroupset& groupset) const
+{
+  return GetFluxMomentSpan(groupset.groups.front().id,
+                           groupset.groups.size());
+}
+
 //###################################################################
 /**Assembles a vector for a given groupset from a source vector.*/
 void LinearBoltzmann::Solver::
@@ -10,29 +38,18 @@ void LinearBoltzmann::Solver::
   double* x_ref;
   VecGetArray(x,&x_ref);
 
-  int gsi = groupset.groups[0].id;
-  int gsf = groupset.groups.back().id;
-  int gss = gsf-gsi+1;
+  const auto span = GetFluxMomentSpan(groupset);
 
-  int index = -1;
-  for (const auto& cell : grid->local_cells)
+  const double* y_block = y.data() + span.first_index;
+  double*       x_block = x_ref;
+  for (size_t b=0; b<span.num_blocks; ++b)
   {
-    auto& transport_view = cell_transport_views[cell.local_id];
-
-    for (int i=0; i < cell.vertex_ids.size(); i++)
-    {
-      for (int m=0; m<num_moments; m++)
-      {
-        size_t mapping = transport_view.MapDOF(i,m,gsi);
-        for (int g=0; g<gss; g++)
-        {
-          index++;
-          x_ref[index] = y[mapping+g]; //Offset on purpose
-        }//for g
-      }//for moment
-    }//for dof
-  }//for cell
+    std::copy(y_block, y_block + span.block_size, x_block);
+    y_block += span.stride;
+    x_block += span.block_size;
+  }
 
+  int index = static_cast<int>(span.num_blocks*span.block_size) - 1;
   if (with_delayed_psi)
     groupset.angle_agg.AppendDelayedAngularDOFsToArray(index, x_ref);
 
@@ -49,63 +66,83 @@ void LinearBoltzmann::Solver::
   const double* x_ref;
   VecGetArrayRead(x_src,&x_ref);
 
-  int gsi = groupset.groups[0].id;
-  int gsf = groupset.groups.back().id;
-  int gss = gsf-gsi+1;
+  const auto span = GetFluxMomentSpan(groupset);
 
-  int index = -1;
-  for (const auto& cell : grid->local_cells)
+  const double* x_block = x_ref;
+  double*       y_block = y.data() + span.first_index;
+  for (size_t b=0; b<span.num_blocks; ++b)
   {
-    auto& transport_view = cell_transport_views[cell.local_id];
-
-    for (int i=0; i < cell.vertex_ids.size(); i++)
-    {
-      for (int m=0; m<num_moments; m++)
-      {
-        size_t mapping = transport_view.MapDOF(i,m,gsi);
-        for (int g=0; g<gss; g++)
-        {
-          index++;
-          y[mapping+g] = x_ref[index];
-        }//for g
-      }//for moment
-    }//for dof
-  }//for cell
+    std::copy(x_block, x_block + span.block_size, y_block);
+    x_block += span.block_size;
+    y_block += span.stride;
+  }
 
+  int index = static_cast<int>(span.num_blocks*span.block_size) - 1;
   if (with_delayed_psi)
     groupset.angle_agg.SetDelayedAngularDOFsFromArray(index, x_ref);
 
   VecRestoreArrayRead(x_src,&x_ref);
 }
 
+//###################################################################
+/**Assembles two vectors for a given groupset from the same source
+ * vector, in a single pass over the source.*/
+void LinearBoltzmann::Solver::
+  SetSTLvectorsFromPETScVec(LBSGroupset& groupset, Vec x_src,
+                            std::vector<double>& y,
+                            std::vector<double>& z,
+                            bool with_delayed_psi/*=false*/)
+{
+  const double* x_ref;
+  VecGetArrayRead(x_src,&x_ref);
+
+  const auto span = GetFluxMomentSpan(groupset);
+
+  const double* x_block = x_ref;
+  double*       y_block = y.data() + span.first_index;
+  double*       z_block = z.data() + span.first_index;
+  for (size_t b=0; b<span.num_blocks; ++b)
+  {
+    for (size_t g=0; g<span.block_size; ++g)
+    {
+      y_block[g] = x_block[g];
+      z_block[g] = x_block[g];
+    }
+    x_block += span.block_size;
+    y_block += span.stride;
+    z_block += span.stride;
+  }
+
+  int index = static_cast<int>(span.num_blocks*span.block_size) - 1;
+  if (with_delayed_psi)
+    groupset.angle_agg.SetDelayedAngularDOFsFromArray(index, x_ref);
+
+  VecRestoreArrayRead(x_src,&x_ref);
+}
 
 //###################################################################
-/**Assembles a vector for a given groupset from a source vector.*/
+/**Copies the entries of a given groupset from a source vector.*/
 void LinearBoltzmann::Solver::
   ScopedCopySTLvectors(LBSGroupset& groupset,
                        const std::vector<double>& x_src,
                        std::vector<double>& y)
 {
-  int gsi = groupset.groups[0].id;
-  size_t gss = groupset.groups.size();
+  const auto span = GetFluxMomentSpan(groupset);
 
-  int index = -1;
-  for (const auto& cell : grid->local_cells)
+  //A groupset holding all groups is one contiguous range
+  if (span.block_size == span.stride)
   {
-    auto& transport_view = cell_transport_views[cell.local_id];
-
-    for (int i=0; i < cell.vertex_ids.size(); i++)
-    {
-      for (int m=0; m<num_moments; m++)
-      {
-        size_t mapping = transport_view.MapDOF(i,m,gsi);
-        for (int g=0; g<gss; g++)
-        {
-          index++;
-          y[mapping+g] = x_src[mapping+g];
-        }//for g
-      }//for moment
-    }//for dof
-  }//for cell
-
-}
\ No newline at end of file
+    std::copy(x_src.begin(), x_src.begin() + span.num_blocks*span.stride,
+              y.begin());
+    return;
+  }
+
+  const double* x_block = x_src.data() + span.first_index;
+  double*       y_block = y.data()     + span.first_index;
+  for (size_t b=0; b<span.num_blocks; ++b)
+  {
+    std::copy(x_block, x_block + span.block_size, y_block);
+    x_block += span.stride;
+    y_block += span.stride;
+  }
+}
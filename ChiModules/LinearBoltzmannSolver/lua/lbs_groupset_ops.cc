@@ -835,6 +835,13 @@ is to be created.
 
 ##_
 
+When enabled, the begin and end times of the most recent angle set
+executions are recorded in a fixed size buffer and written, per location,
+to the file GS_<groupset>_SweepLog_<location>.log after the groupset solve.
+Each line holds the location, sweep number, angle set number and the begin
+and end times in seconds, which can be used to plot sweep timelines.
+
+
 Example:
 \code
 chiLBSGroupsetSetEnableSweepLog(phys1,cur_gs,true)
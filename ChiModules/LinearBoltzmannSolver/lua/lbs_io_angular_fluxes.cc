@@ -18,12 +18,15 @@ is to be created.
 \param file_base string Path+Filename_base to use for the output. Each location
                         will append its id to the back plus an extension ".data"
 
+\param compress bool (Optional) Flag for compressing the angular flux data.
+                     Default false.
+
 */
 int chiLBSWriteGroupsetAngularFlux(lua_State *L)
 {
   //============================================= Get arguments
   int num_args = lua_gettop(L);
-  if (num_args != 3)
+  if (num_args != 3 and num_args != 4)
     LuaPostArgAmountError(__FUNCTION__,3,num_args);
 
   LuaCheckNilValue(__FUNCTION__,L,1);
@@ -33,6 +36,12 @@ int chiLBSWriteGroupsetAngularFlux(lua_State *L)
   int      solver_index = lua_tonumber(L,1);
   int      grpset_index = lua_tonumber(L,2);
   std::string file_base = lua_tostring(L,3);
+  bool     compress     = false;
+  if (num_args == 4)
+  {
+    LuaCheckNilValue(__FUNCTION__,L,4);
+    compress = lua_toboolean(L,4);
+  }
 
   //============================================= Get pointer to solver
   auto lbs_solver = LinearBoltzmann::lua_utils::
@@ -51,7 +60,7 @@ int chiLBSWriteGroupsetAngularFlux(lua_State *L)
     exit(EXIT_FAILURE);
   }
 
-  lbs_solver->WriteGroupsetAngularFluxes(*groupset, file_base);
+  lbs_solver->WriteGroupsetAngularFluxes(*groupset, file_base, compress);
 
   return 0;
 }
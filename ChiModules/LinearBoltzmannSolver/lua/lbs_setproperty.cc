@@ -35,9 +35,37 @@ extern ChiMath&     chi_math_handler;
 
 #define USE_PRECURSORS 12
 
+#define SWEEP_THREADS 13
+
+#define USE_PERSISTENT_SWEEP_COMM 14
+
+#define AGS_SCHEME 15
+  #define AGS_GAUSS_SEIDEL 1
+  #define AGS_JACOBI       2
+
+#define AGS_MAX_ITERATIONS 16
+
+#define AGS_TOLERANCE 17
+
+#define AGS_TWO_GRID 18
+
+#define SWEEP_ORDERING_CACHE 19
+
+#define SWEEP_DISTRIBUTED_TDG 20
+
+#define DSA_REBUILD_POLICY 21
+  #define DSA_REBUILD_ALWAYS       1
+  #define DSA_REBUILD_ON_XS_CHANGE 2
+  #define DSA_REBUILD_NEVER        3
+
+#define DSA_MATRIX_FREE 22
+
 #include "chi_log.h"
 extern ChiLog& chi_log;
 
+#include "chi_mpi.h"
+extern ChiMPI& chi_mpi;
+
 
 //###################################################################
 /**Set LBS property.
@@ -89,6 +117,73 @@ USE_PRECURSORS\n
  Flag for using delayed neutron precursors. Default false. This expects
  to be followed by a boolean.\n\n
 
+SWEEP_THREADS\n
+ Number of threads each process uses to execute independent angle sets
+ concurrently during a sweep. Communication remains on the main thread.
+ Only applies to the depth-of-graph scheduler and to sweep chunks that
+ support concurrent execution, otherwise sweeps remain serial. Reset to 1,
+ with a warning, if MPI does not provide MPI_THREAD_FUNNELED. Default 1.
+ Expects to be followed by an integer.\n\n
+
+USE_PERSISTENT_SWEEP_COMM\n
+ Flag for using persistent MPI requests for the sweep messages. Receives are
+ then pre-posted at the start of a sweep instead of being probed for. This
+ keeps the non-local angular flux buffers allocated between sweeps. Default
+ false. Expects to be followed by a boolean.\n\n
+
+AGS_SCHEME\n
+ Scheme used to iterate across groupsets, either AGS_GAUSS_SEIDEL (default),
+ where each groupset uses the latest flux of all other groupsets, or
+ AGS_JACOBI, where all groupsets use the flux of the previous iteration.
+ Expects to be followed by one of these constants.\n\n
+
+AGS_MAX_ITERATIONS\n
+ Maximum number of across-groupset iterations. The default of 1 solves each
+ groupset once, in order, lagging any scattering from later groupsets.
+ Expects to be followed by an integer.\n\n
+
+AGS_TOLERANCE\n
+ Point-wise convergence tolerance of the across-groupset iterations.
+ Default 1.0e-6. Expects to be followed by a float.\n\n
+
+AGS_TWO_GRID\n
+ Flag for accelerating the across-groupset iterations with a two-grid
+ diffusion correction for the lagged (thermal up-) scattering. Default
+ false. Expects to be followed by a boolean, which can be followed by the
+ optional residual tolerance (default 1.0e-4) and maximum number of
+ iterations (default 100) of the diffusion solves.\n\n
+
+SWEEP_ORDERING_CACHE\n
+ Enables an on-disk cache of sweep orderings for single angle aggregation.
+ Orderings found in the cache for the same mesh and partitioning are reused
+ instead of being rebuilt, new ones are added to it. The value can be
+ followed by two optional strings, the folder name and the file base name,
+ defaulted to "YSweepOrderings" and "spds" respectively.\n\n
+
+SWEEP_DISTRIBUTED_TDG\n
+ Flag for determining the sweep planes of the locations from exchanges
+ between neighboring locations only, instead of gathering all location
+ dependencies to build the global task dependency graph on every location.
+ Orderings with cyclic location dependencies still use the global graph when
+ cycles are allowed. Default false. Expects to be followed by a boolean.\n\n
+
+DSA_REBUILD_POLICY\n
+ Determines when the WGDSA and TGDSA solvers, which are kept between solves
+ along with their matrices, preconditioners and work vectors, are rebuilt.
+ DSA_REBUILD_ALWAYS rebuilds them for every solve, DSA_REBUILD_ON_XS_CHANGE
+ (default) only when the diffusion coefficients of the materials changed and
+ DSA_REBUILD_NEVER only on re-initialization of the solver. Expects to be
+ followed by one of these constants.\n\n
+
+DSA_MATRIX_FREE\n
+ Flag for applying the WGDSA and TGDSA diffusion operators matrix-free,
+ computing the cell and face integrals on the fly instead of assembling the
+ matrix, for problems where the group-aggregated matrix does not fit in
+ memory. Default false. Expects to be followed by a boolean, which can be
+ followed by an optional string naming the preconditioner, either
+ "CELL_BLOCK" (default), which assembles only the cell blocks of the
+ operator, or "JACOBI".\n\n
+
 \code
 chiLBSSetProperty(phys1,READ_RESTART_DATA,"YRestart1")
 \endcode
@@ -100,10 +195,12 @@ WRITE_RESTART_DATA\n
  absolute, and the second string is the file base name. The number is the time
  interval (in minutes) for a restart write to be triggered (apart from GMRES
  restarts and the conclusion of groupset completions) .These are defaulted to
- "YRestart", "restart" and 30 minutes respectively.\n\n
+ "YRestart", "restart" and 30 minutes respectively. A final optional boolean
+ enables block compression of the restart files, default false.\n\n
 
 \code
 chiLBSSetProperty(phys1,WRITE_RESTART_DATA,"YRestart1","restart",1)
+chiLBSSetProperty(phys1,WRITE_RESTART_DATA,"YRestart1","restart",1,true)
 \endcode
 
 ###Discretization methods
@@ -363,13 +460,21 @@ int chiLBSSetProperty(lua_State *L)
       lbs_solver->options.write_restart_file_base = std::string(filebase);
       chi_log.Log(LOG_0) << "Restart output filebase set to " << filebase;
     }
-    if (numArgs == 5)
+    if (numArgs >= 5)
     {
       LuaCheckNilValue(__FUNCTION__, L, 5);
 
       double interval = lua_tonumber(L,5);
       lbs_solver->options.write_restart_interval = interval;
     }
+    if (numArgs == 6)
+    {
+      LuaCheckNilValue(__FUNCTION__, L, 6);
+
+      bool compress = lua_toboolean(L,6);
+      lbs_solver->options.write_restart_compressed = compress;
+      chi_log.Log(LOG_0) << "Restart output compression set to " << compress;
+    }
     lbs_solver->options.write_restart_data = true;
   }
   else if (property == SAVE_ANGULAR_FLUX)
@@ -422,6 +527,223 @@ int chiLBSSetProperty(lua_State *L)
 
     chi_log.Log() << "LBS option: use_precursors set to " << flag;
   }
+  else if (property == SWEEP_THREADS)
+  {
+    LuaCheckNilValue(__FUNCTION__, L, 3);
+
+    int num_threads = lua_tonumber(L, 3);
+
+    if (num_threads < 1)
+    {
+      chi_log.Log(LOG_ALLERROR)
+        << "Invalid number of sweep threads " << num_threads
+        << " specified in call to chiLBSSetProperty:SWEEP_THREADS.";
+      exit(EXIT_FAILURE);
+    }
+
+    //Sweep threads rely on only the main thread making MPI calls
+    if (num_threads > 1 and chi_mpi.thread_support < MPI_THREAD_FUNNELED)
+    {
+      chi_log.Log(LOG_0WARNING)
+        << "chiLBSSetProperty:SWEEP_THREADS: The MPI implementation does "
+           "not provide MPI_THREAD_FUNNELED. Using 1 sweep thread instead of "
+        << num_threads << ".";
+      num_threads = 1;
+    }
+
+    lbs_solver->options.num_sweep_threads = num_threads;
+
+    chi_log.Log() << "LBS option: num_sweep_threads set to " << num_threads;
+  }
+  else if (property == USE_PERSISTENT_SWEEP_COMM)
+  {
+    LuaCheckNilValue(__FUNCTION__, L, 3);
+
+    bool flag = lua_toboolean(L, 3);
+
+    lbs_solver->options.use_persistent_sweep_comm = flag;
+
+    chi_log.Log() << "LBS option: use_persistent_sweep_comm set to " << flag;
+  }
+  else if (property == AGS_SCHEME)
+  {
+    LuaCheckNilValue(__FUNCTION__, L, 3);
+
+    int scheme = lua_tonumber(L, 3);
+
+    if (scheme == AGS_GAUSS_SEIDEL)
+      lbs_solver->options.ags_scheme = LinearBoltzmann::AGSScheme::GAUSS_SEIDEL;
+    else if (scheme == AGS_JACOBI)
+      lbs_solver->options.ags_scheme = LinearBoltzmann::AGSScheme::JACOBI;
+    else
+    {
+      chi_log.Log(LOG_ALLERROR)
+        << "Invalid across-groupset scheme " << scheme
+        << " specified in call to chiLBSSetProperty:AGS_SCHEME.";
+      exit(EXIT_FAILURE);
+    }
+
+    chi_log.Log() << "LBS option: ags_scheme set to " << scheme;
+  }
+  else if (property == AGS_MAX_ITERATIONS)
+  {
+    LuaCheckNilValue(__FUNCTION__, L, 3);
+
+    int max_iterations = lua_tonumber(L, 3);
+
+    if (max_iterations < 1)
+    {
+      chi_log.Log(LOG_ALLERROR)
+        << "Invalid number of iterations " << max_iterations
+        << " specified in call to chiLBSSetProperty:AGS_MAX_ITERATIONS.";
+      exit(EXIT_FAILURE);
+    }
+
+    lbs_solver->options.ags_max_iterations = max_iterations;
+
+    chi_log.Log() << "LBS option: ags_max_iterations set to "
+                  << max_iterations;
+  }
+  else if (property == AGS_TOLERANCE)
+  {
+    LuaCheckNilValue(__FUNCTION__, L, 3);
+
+    double tolerance = lua_tonumber(L, 3);
+
+    if (tolerance <= 0.0 or tolerance > 1.0)
+    {
+      chi_log.Log(LOG_ALLERROR)
+        << "Invalid tolerance " << tolerance
+        << " specified in call to chiLBSSetProperty:AGS_TOLERANCE.";
+      exit(EXIT_FAILURE);
+    }
+
+    lbs_solver->options.ags_tolerance = tolerance;
+
+    chi_log.Log() << "LBS option: ags_tolerance set to " << tolerance;
+  }
+  else if (property == AGS_TWO_GRID)
+  {
+    LuaCheckNilValue(__FUNCTION__, L, 3);
+
+    bool flag = lua_toboolean(L, 3);
+
+    lbs_solver->options.ags_two_grid = flag;
+
+    if (numArgs >= 4)
+    {
+      LuaCheckNilValue(__FUNCTION__, L, 4);
+
+      double tolerance = lua_tonumber(L, 4);
+
+      if (tolerance <= 0.0 or tolerance > 1.0)
+      {
+        chi_log.Log(LOG_ALLERROR)
+          << "Invalid tolerance " << tolerance
+          << " specified in call to chiLBSSetProperty:AGS_TWO_GRID.";
+        exit(EXIT_FAILURE);
+      }
+      lbs_solver->options.ags_two_grid_tolerance = tolerance;
+    }
+
+    if (numArgs >= 5)
+    {
+      LuaCheckNilValue(__FUNCTION__, L, 5);
+
+      int max_iterations = lua_tonumber(L, 5);
+
+      if (max_iterations < 1)
+      {
+        chi_log.Log(LOG_ALLERROR)
+          << "Invalid number of iterations " << max_iterations
+          << " specified in call to chiLBSSetProperty:AGS_TWO_GRID.";
+        exit(EXIT_FAILURE);
+      }
+      lbs_solver->options.ags_two_grid_max_iterations = max_iterations;
+    }
+
+    chi_log.Log() << "LBS option: ags_two_grid set to " << flag;
+  }
+  else if (property == SWEEP_ORDERING_CACHE)
+  {
+    if (numArgs >= 3)
+    {
+      LuaCheckNilValue(__FUNCTION__, L, 3);
+
+      const char* folder = lua_tostring(L,3);
+      lbs_solver->options.sweep_ordering_cache_folder_name = std::string(folder);
+      chi_log.Log(LOG_0) << "Sweep ordering cache folder set to " << folder;
+    }
+    if (numArgs >= 4)
+    {
+      LuaCheckNilValue(__FUNCTION__, L, 4);
+
+      const char* filebase = lua_tostring(L,4);
+      lbs_solver->options.sweep_ordering_cache_file_base = std::string(filebase);
+      chi_log.Log(LOG_0) << "Sweep ordering cache filebase set to " << filebase;
+    }
+    lbs_solver->options.sweep_ordering_cache = true;
+  }
+  else if (property == SWEEP_DISTRIBUTED_TDG)
+  {
+    LuaCheckNilValue(__FUNCTION__, L, 3);
+
+    bool flag = lua_toboolean(L, 3);
+
+    lbs_solver->options.sweep_distributed_tdg = flag;
+
+    chi_log.Log() << "LBS option: sweep_distributed_tdg set to " << flag;
+  }
+  else if (property == DSA_REBUILD_POLICY)
+  {
+    LuaCheckNilValue(__FUNCTION__, L, 3);
+
+    int policy = lua_tonumber(L, 3);
+
+    if (policy == DSA_REBUILD_ALWAYS)
+      lbs_solver->options.dsa_rebuild_policy =
+        LinearBoltzmann::DSARebuildPolicy::ALWAYS;
+    else if (policy == DSA_REBUILD_ON_XS_CHANGE)
+      lbs_solver->options.dsa_rebuild_policy =
+        LinearBoltzmann::DSARebuildPolicy::ON_XS_CHANGE;
+    else if (policy == DSA_REBUILD_NEVER)
+      lbs_solver->options.dsa_rebuild_policy =
+        LinearBoltzmann::DSARebuildPolicy::NEVER;
+    else
+    {
+      chi_log.Log(LOG_ALLERROR)
+        << "Invalid DSA rebuild policy " << policy
+        << " specified in call to chiLBSSetProperty:DSA_REBUILD_POLICY.";
+      exit(EXIT_FAILURE);
+    }
+
+    chi_log.Log() << "LBS option: dsa_rebuild_policy set to " << policy;
+  }
+  else if (property == DSA_MATRIX_FREE)
+  {
+    LuaCheckNilValue(__FUNCTION__, L, 3);
+
+    bool flag = lua_toboolean(L, 3);
+
+    lbs_solver->options.dsa_matrix_free = flag;
+
+    if (numArgs >= 4)
+    {
+      LuaCheckNilValue(__FUNCTION__, L, 4);
+
+      const std::string pc_type = lua_tostring(L, 4);
+      if (pc_type != "CELL_BLOCK" and pc_type != "JACOBI")
+      {
+        chi_log.Log(LOG_ALLERROR)
+          << "Invalid preconditioner " << pc_type
+          << " specified in call to chiLBSSetProperty:DSA_MATRIX_FREE.";
+        exit(EXIT_FAILURE);
+      }
+      lbs_solver->options.dsa_matrix_free_pc = pc_type;
+    }
+
+    chi_log.Log() << "LBS option: dsa_matrix_free set to " << flag;
+  }
   else
   {
     std::cerr << "Invalid property in chiLBSSetProperty.\n";
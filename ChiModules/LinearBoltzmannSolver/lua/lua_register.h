@@ -27,6 +27,21 @@ RegisterConstant(USE_SOURCE_MOMENTS, 9)
 RegisterConstant(VERBOSE_INNER_ITERATIONS, 10);
 RegisterConstant(VERBOSE_OUTER_ITERATIONS, 11);
 RegisterConstant(USE_PRECURSORS, 12);
+RegisterConstant(SWEEP_THREADS, 13);
+RegisterConstant(USE_PERSISTENT_SWEEP_COMM, 14);
+RegisterConstant(AGS_SCHEME, 15);
+RegisterConstant(AGS_GAUSS_SEIDEL, 1);
+RegisterConstant(AGS_JACOBI, 2);
+RegisterConstant(AGS_MAX_ITERATIONS, 16);
+RegisterConstant(AGS_TOLERANCE, 17);
+RegisterConstant(AGS_TWO_GRID, 18);
+RegisterConstant(SWEEP_ORDERING_CACHE, 19);
+RegisterConstant(SWEEP_DISTRIBUTED_TDG, 20);
+RegisterConstant(DSA_REBUILD_POLICY, 21);
+RegisterConstant(DSA_REBUILD_ALWAYS, 1);
+RegisterConstant(DSA_REBUILD_ON_XS_CHANGE, 2);
+RegisterConstant(DSA_REBUILD_NEVER, 3);
+RegisterConstant(DSA_MATRIX_FREE, 22);
 
 
 RegisterNamespace(LBSProperty);
@@ -49,6 +49,7 @@ endif()
 message(STATUS "VTK_DIR set to ${VTK_DIR}")
 
 find_package(MPI)
+find_package(Threads REQUIRED)
 set(CMAKE_MODULE_PATH ${CMAKE_MODULE_PATH} "${CHI_TECH_DIR}/ChiResources/Macros")
 
 #================================================ Include macros
@@ -108,7 +109,8 @@ else ()
     vtk_module_autoinit(TARGETS ${TARGET} MODULES ${VTK_LIBRARIES})
 endif()
 
-set(CHI_LIBS stdc++ lua m dl ${MPI_CXX_LIBRARIES} petsc ${VTK_LIBRARIES})
+set(CHI_LIBS stdc++ lua m dl ${MPI_CXX_LIBRARIES} petsc ${VTK_LIBRARIES}
+    Threads::Threads)
 set(CHI_LIBS ${CHI_LIBS} ChiLib ThirdParty)
 
 #================================================ Compiler flags
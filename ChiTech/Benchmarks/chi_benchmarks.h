@@ -0,0 +1,113 @@
+#ifndef CHI_BENCHMARKS_H
+#define CHI_BENCHMARKS_H
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstdint>
+
+namespace LinearBoltzmann
+{
+  class Solver;
+}
+
+namespace chi_mesh
+{
+  class UnpartitionedMesh;
+}
+
+/**Micro-benchmarks of the transport kernels.
+
+The ChiBenchmarks executable sets up a synthetic 3D orthogonal transport
+problem for each requested mesh size and times the mesh connectivity,
+sweep ordering, FLUDS construction, source, sweep and DSA kernels on it.
+Options are passed on the command line as lua assignments, e.g.
+
+\code
+mpiexec -np 4 bin/ChiBenchmarks bm_sizes={8,16,32} bm_repeats=10 \
+  bm_kernels={\"sweep\",\"set_source\"} bm_output=\"sweep.json\"
+\endcode
+
+Every sample is the maximum time over all locations. The statistics of
+the samples are written to a JSON file by location 0.*/
+namespace chi_benchmarks
+{
+
+//###################################################################
+/**Options of a benchmark run.*/
+struct Options
+{
+  std::vector<int> sizes = {8, 16};     ///< Cells per dimension
+  int  num_groups        = 16;
+  int  num_azimuthal     = 8;           ///< Per product quadrature
+  int  num_polar         = 4;
+  int  sweep_threads     = 1;
+  bool apply_wgdsa       = true;
+
+  int  repeats           = 5;           ///< Timed samples per kernel
+  int  warmup            = 1;           ///< Untimed executions first
+  bool write_samples     = false;       ///< Adds raw samples to output
+  std::vector<std::string> kernels;     ///< Empty means all kernels
+  std::string output_file_name = "chi_benchmarks.json";
+
+  bool KernelEnabled(const std::string& kernel_name) const;
+};
+
+//###################################################################
+/**Summary statistics of a set of timing samples.*/
+struct Statistics
+{
+  double min    = 0.0;
+  double max    = 0.0;
+  double mean   = 0.0;
+  double median = 0.0;
+  double stddev = 0.0;
+};
+
+//###################################################################
+/**Timing samples of a single kernel. When work is non-zero the time
+ * per unit of work, e.g. per unknown, is reported as well.*/
+struct KernelResult
+{
+  std::string         name;
+  std::vector<double> samples;          ///< Seconds
+  double              work = 0.0;
+  std::string         work_unit;
+};
+
+//###################################################################
+/**Results for one synthetic problem.*/
+struct ProblemResult
+{
+  int      cells_per_dim = 0;
+  uint64_t num_cells     = 0;
+  uint64_t num_nodes     = 0;
+  size_t   num_angles    = 0;
+  size_t   num_groups    = 0;
+  std::vector<KernelResult> kernels;
+};
+
+//01
+Options ReadOptions();
+LinearBoltzmann::Solver& SetupProblem(const Options& options,
+                                      int cells_per_dim);
+
+//02
+KernelResult TimeKernel(const std::string& name,
+                        const Options& options,
+                        const std::function<void()>& setup,
+                        const std::function<void()>& kernel);
+void RunKernels(const Options& options,
+                LinearBoltzmann::Solver& solver,
+                chi_mesh::UnpartitionedMesh& umesh,
+                ProblemResult& problem_result);
+
+//03
+Statistics ComputeStatistics(const std::vector<double>& samples);
+void LogSummary(const ProblemResult& problem_result);
+void WriteReport(const Options& options,
+                 const std::vector<ProblemResult>& problem_results);
+
+}//namespace chi_benchmarks
+
+#endif //CHI_BENCHMARKS_H
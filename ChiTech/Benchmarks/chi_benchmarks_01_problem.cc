@@ -0,0 +1,211 @@
+#include "chi_benchmarks.h"
+
+#include "ChiConsole/chi_console.h"
+#include "ChiPhysics/chi_physics.h"
+
+#include "LinearBoltzmannSolver/lbs_linear_boltzmann_solver.h"
+
+#include "chi_log.h"
+
+extern ChiConsole& chi_console;
+extern ChiPhysics& chi_physics_handler;
+extern ChiLog&     chi_log;
+
+#include <sstream>
+#include <algorithm>
+
+namespace
+{
+//###################################################################
+/**Reads the value at the given stack index, if it has the right type.*/
+void ReadValue(lua_State* L, int index, int& value)
+{
+  if (lua_isnumber(L, index))
+    value = static_cast<int>(lua_tonumber(L, index));
+}
+
+void ReadValue(lua_State* L, int index, bool& value)
+{
+  if (lua_isboolean(L, index))
+    value = lua_toboolean(L, index);
+}
+
+void ReadValue(lua_State* L, int index, std::string& value)
+{
+  if (lua_isstring(L, index))
+    value = lua_tostring(L, index);
+}
+
+//###################################################################
+/**Reads a lua global, if it is set.*/
+template<typename T>
+void ReadGlobal(lua_State* L, const char* name, T& value)
+{
+  lua_getglobal(L, name);
+  ReadValue(L, -1, value);
+  lua_pop(L, 1);
+}
+
+//###################################################################
+/**Reads a lua global that is either a single value or an array table
+ * of values, if it is set.*/
+template<typename T>
+void ReadGlobalArray(lua_State* L, const char* name, std::vector<T>& values)
+{
+  lua_getglobal(L, name);
+  if (lua_istable(L, -1))
+  {
+    values.clear();
+    const size_t table_size = lua_rawlen(L, -1);
+    for (size_t i=1; i<=table_size; ++i)
+    {
+      lua_rawgeti(L, -1, static_cast<lua_Integer>(i));
+      T value{};
+      ReadValue(L, -1, value);
+      values.push_back(value);
+      lua_pop(L, 1);
+    }
+  }
+  else if (not lua_isnil(L, -1))
+  {
+    T value{};
+    ReadValue(L, -1, value);
+    values.assign(1, value);
+  }
+  lua_pop(L, 1);
+}
+}//namespace
+
+//###################################################################
+/**Determines whether a kernel was requested.*/
+bool chi_benchmarks::Options::KernelEnabled(const std::string& kernel_name) const
+{
+  if (kernels.empty()) return true;
+
+  return std::find(kernels.begin(), kernels.end(), kernel_name) !=
+         kernels.end();
+}
+
+//###################################################################
+/**Reads the options from lua globals. Command line arguments of the
+ * form a=b have been executed in the console before this call.
+ *
+ * \code
+ * bm_sizes          Cells per dimension, number or table. Default {8,16}.
+ * bm_groups         Number of energy groups. Default 16.
+ * bm_azimuthal      Azimuthal angles of the quadrature. Default 8.
+ * bm_polar          Polar angles of the quadrature. Default 4.
+ * bm_sweep_threads  Number of sweep threads. Default 1.
+ * bm_wgdsa          Apply WGDSA, needed for the dsa kernels. Default true.
+ * bm_repeats        Timed samples per kernel. Default 5.
+ * bm_warmup         Untimed executions per kernel. Default 1.
+ * bm_samples        Write the raw samples. Default false.
+ * bm_kernels        Kernel names, string or table. Default all.
+ * bm_output         JSON output file. Default "chi_benchmarks.json".
+ * \endcode*/
+chi_benchmarks::Options chi_benchmarks::ReadOptions()
+{
+  lua_State* L = chi_console.consoleState;
+
+  Options options;
+  ReadGlobalArray(L, "bm_sizes", options.sizes);
+  ReadGlobal(L, "bm_groups", options.num_groups);
+  ReadGlobal(L, "bm_azimuthal", options.num_azimuthal);
+  ReadGlobal(L, "bm_polar", options.num_polar);
+  ReadGlobal(L, "bm_sweep_threads", options.sweep_threads);
+  ReadGlobal(L, "bm_wgdsa", options.apply_wgdsa);
+  ReadGlobal(L, "bm_repeats", options.repeats);
+  ReadGlobal(L, "bm_warmup", options.warmup);
+  ReadGlobal(L, "bm_samples", options.write_samples);
+  ReadGlobalArray(L, "bm_kernels", options.kernels);
+  ReadGlobal(L, "bm_output", options.output_file_name);
+
+  //============================================= Check options
+  bool invalid_size = options.sizes.empty();
+  for (int size : options.sizes)
+    if (size < 1) invalid_size = true;
+
+  if (invalid_size or options.num_groups < 1 or
+      options.num_azimuthal < 4 or options.num_polar < 2 or
+      options.sweep_threads < 1 or
+      options.repeats < 1 or options.warmup < 0)
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "chi_benchmarks: Invalid options. Sizes, groups, sweep threads "
+         "and repeats must be positive, there must be at least 4 azimuthal "
+         "and 2 polar angles, and warmup cannot be negative.";
+    exit(EXIT_FAILURE);
+  }
+
+  return options;
+}
+
+//###################################################################
+/**Creates the mesh and the transport solver for a cube with
+ * cells_per_dim cells along each dimension, using the lua console so
+ * that the problem is set up exactly as an input file would.*/
+LinearBoltzmann::Solver& chi_benchmarks::
+  SetupProblem(const Options& options, int cells_per_dim)
+{
+  const int last_group = options.num_groups - 1;
+
+  std::stringstream input;
+  input
+    << "chiMeshHandlerCreate()\n"
+    << "bm_nodes = {}\n"
+    << "for i=1," << cells_per_dim + 1 << " do\n"
+    << "  bm_nodes[i] = (i-1)/" << cells_per_dim << "\n"
+    << "end\n"
+    << "chiMeshCreateUnpartitioned3DOrthoMesh(bm_nodes,bm_nodes,bm_nodes)\n"
+    << "chiVolumeMesherExecute()\n"
+
+    << "bm_vol = chiLogicalVolumeCreate(RPP,-1000,1000,-1000,1000,-1000,1000)\n"
+    << "bm_mat = chiPhysicsAddMaterial(\"Benchmark\")\n"
+    << "chiVolumeMesherSetProperty(MATID_FROMLOGICAL,bm_vol,bm_mat)\n"
+    << "chiPhysicsMaterialAddProperty(bm_mat,TRANSPORT_XSECTIONS)\n"
+    << "chiPhysicsMaterialAddProperty(bm_mat,ISOTROPIC_MG_SOURCE)\n"
+    << "chiPhysicsMaterialSetProperty(bm_mat,TRANSPORT_XSECTIONS,SIMPLEXS1,"
+    <<    options.num_groups << ",1.0,0.5)\n"
+    << "bm_src = {}\n"
+    << "for g=1," << options.num_groups << " do bm_src[g] = 1.0 end\n"
+    << "chiPhysicsMaterialSetProperty(bm_mat,ISOTROPIC_MG_SOURCE,"
+    <<    "FROM_ARRAY,bm_src)\n"
+
+    << "bm_solver = chiLBSCreateSolver()\n"
+    << "chiSolverAddRegion(bm_solver,0)\n"
+    << "for g=1," << options.num_groups << " do "
+    <<    "chiLBSCreateGroup(bm_solver) end\n"
+    << "bm_quad = chiCreateProductQuadrature(GAUSS_LEGENDRE_CHEBYSHEV,"
+    <<    options.num_azimuthal << "," << options.num_polar << ")\n"
+    << "bm_gs = chiLBSCreateGroupset(bm_solver)\n"
+    << "chiLBSGroupsetAddGroups(bm_solver,bm_gs,0," << last_group << ")\n"
+    << "chiLBSGroupsetSetQuadrature(bm_solver,bm_gs,bm_quad)\n"
+    << "chiLBSGroupsetSetAngleAggregationType(bm_solver,bm_gs,"
+    <<    "LBSGroupset.ANGLE_AGG_SINGLE)\n"
+    << "chiLBSGroupsetSetIterativeMethod(bm_solver,bm_gs,"
+    <<    "NPT_CLASSICRICHARDSON_CYCLES)\n";
+  if (options.apply_wgdsa)
+    input
+      << "chiLBSGroupsetSetWGDSA(bm_solver,bm_gs,30,1.0e-4,false,\" \")\n";
+  input
+    << "chiLBSSetProperty(bm_solver,DISCRETIZATION_METHOD,PWLD)\n"
+    << "chiLBSSetProperty(bm_solver,SWEEP_THREADS,"
+    <<    options.sweep_threads << ")\n"
+    << "chiLBSInitialize(bm_solver)\n";
+
+  lua_State* L = chi_console.consoleState;
+  if (luaL_dostring(L, input.str().c_str()) != 0)
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "chi_benchmarks: Problem setup failed: " << lua_tostring(L, -1);
+    exit(EXIT_FAILURE);
+  }
+
+  int solver_handle = -1;
+  ReadGlobal(L, "bm_solver", solver_handle);
+
+  auto solver = dynamic_cast<LinearBoltzmann::Solver*>(
+    chi_physics_handler.solver_stack.at(solver_handle));
+
+  return *solver;
+}
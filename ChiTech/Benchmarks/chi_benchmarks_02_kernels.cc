@@ -0,0 +1,265 @@
+#include "chi_benchmarks.h"
+
+#include "ChiMesh/UnpartitionedMesh/chi_unpartitioned_mesh.h"
+#include "ChiMesh/SweepUtilities/SweepScheduler/sweepscheduler.h"
+
+#include "LinearBoltzmannSolver/lbs_linear_boltzmann_solver.h"
+#include "DiffusionSolver/Solver/diffusion_solver.h"
+
+#include "chi_log.h"
+#include "chi_mpi.h"
+
+extern ChiLog& chi_log;
+extern ChiMPI& chi_mpi;
+
+namespace
+{
+//###################################################################
+/**Deletes the angle sets and their FLUDS but, unlike
+ * Solver::ResetSweepOrderings, keeps the sweep orderings.*/
+void ReleaseAngleSets(LBSGroupset& groupset)
+{
+  auto& angle_agg = groupset.angle_agg;
+  for (auto& angset_grp : angle_agg.angle_set_groups)
+  {
+    for (auto& angset : angset_grp.angle_sets)
+      delete angset->fluds;
+    angset_grp.angle_sets.clear();
+  }
+  angle_agg.angle_set_groups.clear();
+}
+}//namespace
+
+//###################################################################
+/**Times a kernel. Each execution is preceded by an untimed call to
+ * setup. The first options.warmup executions are discarded and each of
+ * the remaining options.repeats samples is the maximum time over all
+ * locations.*/
+chi_benchmarks::KernelResult chi_benchmarks::
+  TimeKernel(const std::string& name,
+             const Options& options,
+             const std::function<void()>& setup,
+             const std::function<void()>& kernel)
+{
+  chi_log.Log(LOG_0) << "chi_benchmarks: Timing " << name;
+
+  KernelResult result;
+  result.name = name;
+  result.samples.reserve(options.repeats);
+
+  for (int r=0; r < options.warmup + options.repeats; ++r)
+  {
+    if (setup) setup();
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    const double t_start = MPI_Wtime();
+    kernel();
+    const double local_time = MPI_Wtime() - t_start;
+
+    double global_time = 0.0;
+    MPI_Allreduce(&local_time, &global_time, 1, MPI_DOUBLE, MPI_MAX,
+                  MPI_COMM_WORLD);
+
+    if (r >= options.warmup)
+      result.samples.push_back(global_time);
+  }
+
+  return result;
+}
+
+//###################################################################
+/**Times the enabled kernels on an initialized solver and its
+ * unpartitioned mesh. The kernels are executed in the order in which
+ * the solver uses them, so that each kernel operates on the data
+ * structures built by the ones before it. Only the first groupset is
+ * used.
+ *
+ * \code
+ * mesh_connectivity         UnpartitionedMesh::BuildMeshConnectivity
+ * create_sweep_order        CreateSweepOrder for the first direction
+ * compute_sweep_orderings   Solver::ComputeSweepOrderings
+ * fluds                     Solver::InitFluxDataStructures
+ * set_source                Solver::SetSource, all source terms
+ * sweep                     A full sweep with SweepChunkPWL
+ * dsa_assembly              WGDSA matrix assembly and solver setup
+ * dsa_solve                 WGDSA right-hand side, solve and update
+ * \endcode*/
+void chi_benchmarks::RunKernels(const Options& options,
+                                LinearBoltzmann::Solver& solver,
+                                chi_mesh::UnpartitionedMesh& umesh,
+                                ProblemResult& problem_result)
+{
+  auto& groupset = solver.groupsets.front();
+
+  const size_t num_angles = groupset.quadrature->abscissae.size();
+  const size_t num_groups = groupset.groups.size();
+  const double num_cells  = static_cast<double>(problem_result.num_cells);
+  const double num_unknowns = static_cast<double>(solver.glob_node_count)*
+                              static_cast<double>(num_angles*num_groups);
+
+  problem_result.num_nodes  = solver.glob_node_count;
+  problem_result.num_angles = num_angles;
+  problem_result.num_groups = num_groups;
+
+  auto& results = problem_result.kernels;
+
+  //============================================= Mesh connectivity
+  if (options.KernelEnabled("mesh_connectivity"))
+  {
+    auto reset_connectivity = [&umesh]()
+    {
+      umesh.vertex_cell_subscriptions.clear();
+      for (auto& cell : umesh.raw_cells)
+        for (auto& face : cell->faces)
+        {
+          face.has_neighbor = false;
+          face.neighbor = 0;
+        }
+    };
+
+    results.push_back(TimeKernel("mesh_connectivity", options,
+                                 reset_connectivity,
+                                 [&umesh]() {umesh.BuildMeshConnectivity();}));
+    results.back().work = num_cells;
+    results.back().work_unit = "cell";
+  }
+
+  //============================================= Sweep orderings
+  if (options.KernelEnabled("create_sweep_order"))
+  {
+    const auto omega = groupset.quadrature->omegas.front();
+    results.push_back(TimeKernel("create_sweep_order", options, nullptr,
+      [&solver,&groupset,&omega]()
+      {
+        chi_mesh::sweep_management::
+          CreateSweepOrder(omega, solver.grid, groupset.allow_cycles,
+                           solver.options.sweep_distributed_tdg);
+      }));
+    results.back().work = num_cells;
+    results.back().work_unit = "cell";
+  }
+
+  if (options.KernelEnabled("compute_sweep_orderings"))
+  {
+    results.push_back(TimeKernel("compute_sweep_orderings", options, nullptr,
+      [&solver,&groupset]() {solver.ComputeSweepOrderings(groupset);}));
+    results.back().work = num_cells*static_cast<double>(num_angles);
+    results.back().work_unit = "cell_direction";
+  }
+
+  if (groupset.sweep_orderings.empty())
+    solver.ComputeSweepOrderings(groupset);
+
+  //============================================= FLUDS
+  if (options.KernelEnabled("fluds"))
+  {
+    results.push_back(TimeKernel("fluds", options,
+      [&groupset]() {ReleaseAngleSets(groupset);},
+      [&solver,&groupset]() {solver.InitFluxDataStructures(groupset);}));
+    results.back().work = num_cells*static_cast<double>(num_angles);
+    results.back().work_unit = "cell_direction";
+  }
+
+  if (groupset.angle_agg.angle_set_groups.empty())
+    solver.InitFluxDataStructures(groupset);
+
+  //============================================= Source
+  const auto source_flags = LinearBoltzmann::APPLY_MATERIAL_SOURCE |
+                            LinearBoltzmann::APPLY_WGS_SCATTER_SOURCE |
+                            LinearBoltzmann::APPLY_WGS_FISSION_SOURCE |
+                            LinearBoltzmann::APPLY_AGS_SCATTER_SOURCE |
+                            LinearBoltzmann::APPLY_AGS_FISSION_SOURCE;
+
+  auto zero_source = [&solver]()
+  {
+    solver.q_moments_local.assign(solver.q_moments_local.size(), 0.0);
+  };
+
+  if (options.KernelEnabled("set_source"))
+  {
+    results.push_back(TimeKernel("set_source", options, zero_source,
+      [&solver,&groupset,source_flags]()
+      {solver.SetSource(groupset, solver.q_moments_local, source_flags);}));
+    results.back().work = static_cast<double>(solver.glob_node_count)*
+                          static_cast<double>(solver.num_moments*num_groups);
+    results.back().work_unit = "moment_unknown";
+  }
+
+  //============================================= Sweep
+  {
+    auto sweep_chunk = solver.SetSweepChunk(groupset);
+    MainSweepScheduler sweep_scheduler(SchedulingAlgorithm::DEPTH_OF_GRAPH,
+                                       groupset.angle_agg,
+                                       *sweep_chunk,
+                                       solver.options.num_sweep_threads);
+
+    zero_source();
+    solver.SetSource(groupset, solver.q_moments_local, source_flags);
+    sweep_chunk->SetSurfaceSourceActiveFlag(true);
+    sweep_chunk->ZeroIncomingDelayedPsi();
+
+    if (options.KernelEnabled("sweep"))
+    {
+      results.push_back(TimeKernel("sweep", options,
+        [&sweep_chunk]() {sweep_chunk->ZeroFluxDataStructures();},
+        [&sweep_scheduler]() {sweep_scheduler.Sweep();}));
+      results.back().work = num_unknowns;
+      results.back().work_unit = "unknown";
+    }
+    else
+    {
+      sweep_chunk->ZeroFluxDataStructures();
+      sweep_scheduler.Sweep();
+    }
+  }
+
+  //============================================= DSA
+  const bool dsa_enabled = options.KernelEnabled("dsa_assembly") or
+                           options.KernelEnabled("dsa_solve");
+  if (dsa_enabled and groupset.apply_wgdsa)
+  {
+    solver.InitWGDSA(groupset);
+    auto dsolver = (chi_diffusion::Solver*)groupset.wgdsa_solver;
+
+    const double num_dsa_unknowns =
+      static_cast<double>(solver.glob_node_count*num_groups);
+
+    if (options.KernelEnabled("dsa_assembly"))
+    {
+      results.push_back(TimeKernel("dsa_assembly", options, nullptr,
+        [dsolver]() {dsolver->ExecuteS(false, true);}));
+      results.back().work = num_dsa_unknowns;
+      results.back().work_unit = "unknown";
+    }
+
+    if (options.KernelEnabled("dsa_solve"))
+    {
+      //Delta-phi is taken between the swept flux and zero, which is
+      //restored before every solve.
+      const std::vector<double> phi_swept = solver.phi_new_local;
+      solver.phi_old_local.assign(solver.phi_old_local.size(), 0.0);
+
+      results.push_back(TimeKernel("dsa_solve", options,
+        [&solver,&phi_swept]() {solver.phi_new_local = phi_swept;},
+        [&solver,&groupset,dsolver]()
+        {
+          solver.AssembleWGDSADeltaPhiVector(groupset,
+                                             solver.phi_old_local.data(),
+                                             solver.phi_new_local.data());
+          dsolver->ExecuteS(true, false);
+          solver.DisAssembleWGDSADeltaPhiVector(groupset,
+                                                solver.phi_new_local.data());
+        }));
+      results.back().work = num_dsa_unknowns;
+      results.back().work_unit = "unknown";
+    }
+
+    solver.CleanUpWGDSA(groupset);
+  }
+  else if (dsa_enabled)
+    chi_log.Log(LOG_0WARNING)
+      << "chi_benchmarks: DSA kernels skipped since WGDSA is disabled.";
+
+  //============================================= Release
+  solver.ResetSweepOrderings(groupset);
+}
@@ -0,0 +1,174 @@
+#include "chi_benchmarks.h"
+
+#include "ChiTimer/chi_timer.h"
+
+#include "chi_log.h"
+#include "chi_mpi.h"
+
+extern ChiLog& chi_log;
+extern ChiMPI& chi_mpi;
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+
+namespace
+{
+//###################################################################
+/**Writes the statistics members of a JSON object, each scaled by the
+ * given factor.*/
+void WriteStatistics(std::ostream& out,
+                     const chi_benchmarks::Statistics& stats,
+                     const std::string& prefix,
+                     double scale,
+                     const std::string& indent)
+{
+  out << indent << "\"" << prefix << "min\": "    << stats.min*scale    << ",\n"
+      << indent << "\"" << prefix << "max\": "    << stats.max*scale    << ",\n"
+      << indent << "\"" << prefix << "mean\": "   << stats.mean*scale   << ",\n"
+      << indent << "\"" << prefix << "median\": " << stats.median*scale << ",\n"
+      << indent << "\"" << prefix << "stddev\": " << stats.stddev*scale;
+}
+}//namespace
+
+//###################################################################
+/**Computes the statistics of a non-empty set of samples. The standard
+ * deviation is the sample standard deviation.*/
+chi_benchmarks::Statistics chi_benchmarks::
+  ComputeStatistics(const std::vector<double>& samples)
+{
+  Statistics stats;
+  if (samples.empty()) return stats;
+
+  std::vector<double> sorted = samples;
+  std::sort(sorted.begin(), sorted.end());
+
+  const size_t n = sorted.size();
+  stats.min = sorted.front();
+  stats.max = sorted.back();
+  stats.mean = std::accumulate(sorted.begin(), sorted.end(), 0.0)/
+               static_cast<double>(n);
+  stats.median = (n % 2 == 1) ? sorted[n/2] :
+                 0.5*(sorted[n/2 - 1] + sorted[n/2]);
+
+  if (n > 1)
+  {
+    double sum_sq = 0.0;
+    for (double sample : sorted)
+      sum_sq += (sample - stats.mean)*(sample - stats.mean);
+    stats.stddev = std::sqrt(sum_sq/static_cast<double>(n - 1));
+  }
+
+  return stats;
+}
+
+//###################################################################
+/**Prints a table of the median times of a problem.*/
+void chi_benchmarks::LogSummary(const ProblemResult& problem_result)
+{
+  std::stringstream outstr;
+  outstr
+    << "\nchi_benchmarks: " << problem_result.cells_per_dim << "^3 cells, "
+    << problem_result.num_angles << " angles, "
+    << problem_result.num_groups << " groups\n"
+    << std::left << std::setw(26) << "  Kernel"
+    << std::right << std::setw(14) << "Median (s)"
+    << std::setw(14) << "Stddev (s)"
+    << std::setw(14) << "ns/unit" << "  Unit\n";
+
+  for (const auto& kernel : problem_result.kernels)
+  {
+    const auto stats = ComputeStatistics(kernel.samples);
+    outstr
+      << "  " << std::left << std::setw(24) << kernel.name << std::right
+      << std::scientific << std::setprecision(4)
+      << std::setw(14) << stats.median
+      << std::setw(14) << stats.stddev;
+    if (kernel.work > 0.0)
+      outstr << std::fixed << std::setprecision(3)
+             << std::setw(14) << stats.median/kernel.work*1.0e9
+             << "  " << kernel.work_unit;
+    outstr << "\n";
+  }
+
+  chi_log.Log(LOG_0) << outstr.str();
+}
+
+//###################################################################
+/**Writes the results of all problems as JSON. Times are in seconds and
+ * the per-unit-of-work statistics in nanoseconds.*/
+void chi_benchmarks::WriteReport(const Options& options,
+                                 const std::vector<ProblemResult>& problem_results)
+{
+  if (chi_mpi.location_id != 0) return;
+
+  std::ofstream out(options.output_file_name);
+  if (not out.is_open())
+  {
+    chi_log.Log(LOG_0ERROR)
+      << "chi_benchmarks: Failed to open " << options.output_file_name;
+    return;
+  }
+
+  out << std::setprecision(10);
+  out << "{\n"
+      << "  \"date\": \"" << ChiTimer::GetLocalDateTimeString() << "\",\n"
+      << "  \"num_processes\": " << chi_mpi.process_count << ",\n"
+      << "  \"sweep_threads\": " << options.sweep_threads << ",\n"
+      << "  \"repeats\": " << options.repeats << ",\n"
+      << "  \"warmup\": " << options.warmup << ",\n"
+      << "  \"problems\": [";
+
+  for (size_t p=0; p<problem_results.size(); ++p)
+  {
+    const auto& problem = problem_results[p];
+    out << (p == 0 ? "\n" : ",\n")
+        << "    {\n"
+        << "      \"cells_per_dim\": " << problem.cells_per_dim << ",\n"
+        << "      \"num_cells\": " << problem.num_cells << ",\n"
+        << "      \"num_nodes\": " << problem.num_nodes << ",\n"
+        << "      \"num_angles\": " << problem.num_angles << ",\n"
+        << "      \"num_groups\": " << problem.num_groups << ",\n"
+        << "      \"kernels\": [";
+
+    for (size_t k=0; k<problem.kernels.size(); ++k)
+    {
+      const auto& kernel = problem.kernels[k];
+      const auto stats = ComputeStatistics(kernel.samples);
+      const std::string indent(10, ' ');
+
+      out << (k == 0 ? "\n" : ",\n")
+          << "        {\n"
+          << indent << "\"name\": \"" << kernel.name << "\",\n"
+          << indent << "\"num_samples\": " << kernel.samples.size() << ",\n";
+      WriteStatistics(out, stats, "", 1.0, indent);
+
+      if (kernel.work > 0.0)
+      {
+        out << ",\n"
+            << indent << "\"work\": " << kernel.work << ",\n"
+            << indent << "\"work_unit\": \"" << kernel.work_unit << "\",\n";
+        WriteStatistics(out, stats, "ns_per_unit_", 1.0e9/kernel.work, indent);
+      }
+
+      if (options.write_samples)
+      {
+        out << ",\n" << indent << "\"samples\": [";
+        for (size_t s=0; s<kernel.samples.size(); ++s)
+          out << (s == 0 ? "" : ", ") << kernel.samples[s];
+        out << "]";
+      }
+      out << "\n        }";
+    }//for kernel
+    out << "\n      ]\n    }";
+  }//for problem
+  out << "\n  ]\n}\n";
+
+  out.close();
+
+  chi_log.Log(LOG_0)
+    << "chi_benchmarks: Results written to " << options.output_file_name;
+}
@@ -0,0 +1,50 @@
+#include "chi_benchmarks.h"
+#include "chi_runtime.h"
+
+#include "ChiConsole/chi_console.h"
+#include "ChiMesh/MeshHandler/chi_meshhandler.h"
+
+#include "chi_log.h"
+
+extern ChiConsole& chi_console;
+extern ChiLog&     chi_log;
+
+//######################################################### Program entry point
+/** Benchmark entry point. Arguments of the form a=b are executed as lua
+ * strings and set the benchmark options, see chi_benchmarks::ReadOptions.
+
+\param argc int    Number of arguments supplied.
+\param argv char** Array of strings representing each argument.
+
+*/
+int main(int argc, char** argv)
+{
+  ChiTech::Initialize(argc, argv);
+  chi_console.FlushConsole();
+
+  const auto options = chi_benchmarks::ReadOptions();
+
+  std::vector<chi_benchmarks::ProblemResult> problem_results;
+  for (int cells_per_dim : options.sizes)
+  {
+    auto& solver = chi_benchmarks::SetupProblem(options, cells_per_dim);
+    auto& umesh = *chi_mesh::GetCurrentHandler()->unpartitionedmesh_stack.back();
+
+    chi_benchmarks::ProblemResult problem_result;
+    problem_result.cells_per_dim = cells_per_dim;
+    problem_result.num_cells = static_cast<uint64_t>(cells_per_dim)*
+                               cells_per_dim*cells_per_dim;
+
+    chi_benchmarks::RunKernels(options, solver, umesh, problem_result);
+    chi_benchmarks::LogSummary(problem_result);
+
+    problem_results.push_back(std::move(problem_result));
+
+    //Partial results survive an interrupted run
+    chi_benchmarks::WriteReport(options, problem_results);
+  }
+
+  ChiTech::Finalize();
+
+  return 0;
+}
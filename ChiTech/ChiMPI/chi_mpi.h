@@ -33,9 +33,11 @@ class ChiMPI
 private:
   int m_location_id = 0;
   int m_process_count = 1;
+  int m_thread_support = MPI_THREAD_SINGLE;
 public:
   const int& location_id = m_location_id;
   const int& process_count = m_process_count;
+  const int& thread_support = m_thread_support; ///< Provided by MPI_Init_thread
 
 
 private:
@@ -45,6 +47,7 @@ private:
   ChiMPI() noexcept {}
   void SetLocationID(int in_location_id) {m_location_id = in_location_id;}
   void SetProcessCount(int in_process_count) {m_process_count = in_process_count;}
+  void SetThreadSupport(int in_thread_support) {m_thread_support = in_thread_support;}
 public:
   static ChiMPI& GetInstance() noexcept {return instance;}
 };
@@ -9,14 +9,12 @@ extern ChiLog& chi_log;
 /**Initializes the data structures necessary for interpolation. This is
  * independent of the physics and hence is a routine on its own.
  *
- * The first step of this initialization is to determine which cells
- * are intersected by this line. For polyhedrons this is evaluated
- * face side-by-side.
+ * The first step of this initialization is to find the cell associated
+ * with each point in the line. The grid's spatial index limits the
+ * point-in-cell tests to the cells whose bounding box contains the
+ * point. For polyhedrons the test is evaluated face side-by-side.
  *
- * The second step is to find the cell associated with each point in
- * in the line.
- *
- * Third step is to upload node indices for each-cell-point pair so that
+ * The second step is to upload node indices for each-cell-point pair so that
  * the value can be interpolated.*/
 void chi_mesh::FieldFunctionInterpolationLine::
 Initialize()
@@ -74,138 +72,27 @@ Initialize()
 
       //================================================== Find a home for each
       //                                                   point
-      for (const auto& cell : grid_view->local_cells)
+      // Only the cells whose bounding box contains a point are tested.
+      // Candidates are visited in local id order, so that a point on a
+      // shared face ends up in the last cell containing it.
+      const auto& spatial_index = grid_view->GetSpatialIndex();
+      for (int p=0; p<number_of_points; p++)
       {
-        int cell_local_index = cell.local_id;
-
-        //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% SLAB
-        if (cell.Type() == chi_mesh::CellType::SLAB)
-        {
-          for (int p=0; p<number_of_points; p++)
-          {
-            //Assume each point is inside the cell, now try to disprove it
-            bool is_inside = true;
-            uint64_t v0_i = cell.vertex_ids[0];
-            uint64_t v1_i = cell.vertex_ids[1];
-
-            const auto& v0 = grid_view->vertices[v0_i];
-            const auto& v1 = grid_view->vertices[v1_i];
-
-            chi_mesh::Vector3 v01 = v1 - v0;
-            chi_mesh::Vector3 v0p = interpolation_points[p] - v0;
-
-            double v01_norm = v01.Norm();
-            double projection = v01.Dot(v0p)/v01_norm;
-
-            if ((v0p.Dot(v01)<0.0) or (projection>v01_norm))
-            {
-              is_inside = false;
-            }
-
-            if (is_inside)
-            {
-              interpolation_points_ass_cell[p] = cell_local_index;
-              interpolation_points_has_ass_cell[p] = true;
-              chi_log.Log(LOG_ALLVERBOSE_2)
-                << "Cell inter section found  " << p
-                << " v0[" << v0_i << "]=" << v0.PrintS()
-                << " v1[" << v1_i << "]=" << v1.PrintS()
-                << " point=" << interpolation_points[p].PrintS();
-
-            }
-
-          }//for each point
-        }//if slab
-
-          //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% POLYGON
-        else if (cell.Type() == chi_mesh::CellType::POLYGON)
-        {
-          size_t num_edges = cell.faces.size();
-
-          for (int p=0; p<number_of_points; p++)
-          {
-            //Assume each point is inside the cell, now try to disprove it
-            bool is_inside = true;
-            //Form a plane for each edge
-            for (size_t e=0; e<num_edges; e++)
-            {
-              chi_mesh::Vector3 nref(0.0, 0.0, 1.0);
-              uint64_t v0_i = cell.faces[e].vertex_ids[0];
-              uint64_t v1_i = cell.faces[e].vertex_ids[1];
-
-              const auto& v0 = grid_view->vertices[v0_i];
-              const auto& v1 = grid_view->vertices[v1_i];
-
-              chi_mesh::Vector3 v01 = v1 - v0;
-              chi_mesh::Vector3   n = v01.Cross(nref);
-              n = n/n.Norm();
-
-              chi_mesh::Vector3 v0p = interpolation_points[p] - v0;
-              v0p=v0p/v0p.Norm();
-
-              if (n.Dot(v0p)>0.0)
-              {
-                is_inside = false;
-                break;
-              }
-            }//for edge
-
-            if (is_inside)
-            {
-              interpolation_points_ass_cell[p] = cell_local_index;
-              interpolation_points_has_ass_cell[p] = true;
-              chi_log.Log(LOG_ALLVERBOSE_2)
-                << "Cell inter section found  " << p;
-            }
-
-          }//for each point
-        }//if polygon cell
-
-          //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% POLYHEDRON
-        else if (cell.Type() == chi_mesh::CellType::POLYHEDRON)
+        const auto& point = interpolation_points[p];
+        for (uint64_t cell_local_index :
+               spatial_index.FindPointCandidates(point))
         {
-          size_t num_faces = cell.faces.size();
-
-          for (int p=0; p<number_of_points; p++)
+          const auto& cell = grid_view->local_cells[cell_local_index];
+          if (grid_view->CheckPointInsideCell(cell, point))
           {
-            //Assume each point is inside the cell, now try to disprove it
-            bool is_inside = true;
-            for (size_t f=0; f<num_faces; f++)
-            {
-              const auto& face = cell.faces[f];
-              size_t num_edges = face.vertex_ids.size();
-              //Form a plane for each side
-              for (size_t e=0; e<num_edges; e++)
-              {
-                uint64_t v0_i = face.vertex_ids[e];
-
-                const auto& v0 = grid_view->vertices[v0_i];
-                chi_mesh::Vector3 n  = cell.faces[f].normal;
-
-                chi_mesh::Vector3 v0p = interpolation_points[p] - v0;
-                v0p=v0p/v0p.Norm();
-
-                if (n.Dot(v0p)>0.0)
-                {
-                  is_inside = false;
-                  break;
-                }
-              }//for e
-              if (!is_inside) break;
-            }//for f
-
-            if (is_inside)
-            {
-              interpolation_points_ass_cell[p] = cell_local_index;
-              interpolation_points_has_ass_cell[p] = true;
-              chi_log.Log(LOG_ALLVERBOSE_2)
-                << "Cell inter section found  " << p;
-            }
-
-          }//for each point
-
-        }//if polyhedron
-      }//for local cell
+            interpolation_points_ass_cell[p] = cell_local_index;
+            interpolation_points_has_ass_cell[p] = true;
+            chi_log.Log(LOG_ALLVERBOSE_2)
+              << "Cell inter section found  " << p
+              << " point=" << point.PrintS();
+          }
+        }//for candidate cell
+      }//for each point
 
       //================================================== Upload node indices that
       //                                                   need mapping
@@ -34,6 +34,8 @@ private:
   std::vector<int>                    pwld_local_nodes_needed_unmapped;
   std::vector<int>                    pwld_local_cells_needed_unmapped;
 
+  std::vector<uint64_t>               cells_inside_logvolume;
+
 public:
   FieldFunctionInterpolationVolume()
   {
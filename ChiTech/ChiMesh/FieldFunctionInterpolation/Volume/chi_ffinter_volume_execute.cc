@@ -68,46 +68,39 @@ void chi_mesh::FieldFunctionInterpolationVolume::
   double max_value = 0.0;
   bool max_set = false;
 
-  for (auto& cell : grid_view->local_cells)
+  for (uint64_t c : cells_inside_logvolume)
   {
-    bool inside_logvolume=true;
+    const auto& cell = grid_view->local_cells[c];
 
-    if (logical_volume != nullptr)
-      inside_logvolume = logical_volume->Inside(cell.centroid);
+    const auto& fe_intgrl_values = discretization.GetUnitIntegrals(cell);
 
-    if (inside_logvolume)
+    for (int i=0; i<cell.vertex_ids.size(); i++)
     {
-      const auto& fe_intgrl_values = discretization.GetUnitIntegrals(cell);
+      double value = 0.0;
+      int64_t ir = -1;
 
-      for (int i=0; i<cell.vertex_ids.size(); i++)
-      {
-        double value = 0.0;
-        int64_t ir = -1;
-
-        counter++;
-        ir = mapping[counter];
-        VecGetValues(field,1,&ir,&value);
+      counter++;
+      ir = mapping[counter];
+      VecGetValues(field,1,&ir,&value);
 
-        if ((op_type >= OP_SUM_LUA) and (op_type <= OP_MAX_LUA))
-          value = CallLuaFunction(value,cell.material_id);
+      if ((op_type >= OP_SUM_LUA) and (op_type <= OP_MAX_LUA))
+        value = CallLuaFunction(value,cell.material_id);
 
-        op_value += value* fe_intgrl_values.IntV_shapeI(i);
-        total_volume += fe_intgrl_values.IntV_shapeI(i);
+      op_value += value* fe_intgrl_values.IntV_shapeI(i);
+      total_volume += fe_intgrl_values.IntV_shapeI(i);
 
-        if (!max_set)
-        {
+      if (!max_set)
+      {
+        max_value = value;
+        max_set = true;
+      }
+      else
+      {
+        if (value > max_value)
           max_value = value;
-          max_set = true;
-        }
-        else
-        {
-          if (value > max_value)
-            max_value = value;
-        }
-      }//for dof
-    }//if inside logicalVol
-
-  }//for local cell
+      }
+    }//for dof
+  }//for cell inside logicalVol
 
   double all_value=0.0;
   double all_total_volume = 0.0;
@@ -140,46 +133,39 @@ void chi_mesh::FieldFunctionInterpolationVolume::
   bool max_set = false;
   double total_volume = 0.0;
 
-  for (auto& cell : grid_view->local_cells)
+  for (uint64_t c : cells_inside_logvolume)
   {
-    bool inside_logvolume=true;
+    const auto& cell = grid_view->local_cells[c];
 
-    if (logical_volume != nullptr)
-      inside_logvolume = logical_volume->Inside(cell.centroid);
+    const auto& fe_intgrl_values = discretization.GetUnitIntegrals(cell);
 
-    if (inside_logvolume)
+    for (int i=0; i < cell.vertex_ids.size(); i++)
     {
-      const auto& fe_intgrl_values = discretization.GetUnitIntegrals(cell);
+      double value = 0.0;
+      int ir = -1;
 
-      for (int i=0; i < cell.vertex_ids.size(); i++)
-      {
-        double value = 0.0;
-        int ir = -1;
-
-        counter++;
-        ir = mapping[counter];
-        value = field[ir];
+      counter++;
+      ir = mapping[counter];
+      value = field[ir];
 
-        if ((op_type >= OP_SUM_LUA) and (op_type <= OP_MAX_LUA))
-          value = CallLuaFunction(value,cell.material_id);
+      if ((op_type >= OP_SUM_LUA) and (op_type <= OP_MAX_LUA))
+        value = CallLuaFunction(value,cell.material_id);
 
-        op_value += value* fe_intgrl_values.IntV_shapeI(i);
-        total_volume += fe_intgrl_values.IntV_shapeI(i);
+      op_value += value* fe_intgrl_values.IntV_shapeI(i);
+      total_volume += fe_intgrl_values.IntV_shapeI(i);
 
-        if (!max_set)
-        {
+      if (!max_set)
+      {
+        max_value = value;
+        max_set = true;
+      }
+      else
+      {
+        if (value > max_value)
           max_value = value;
-          max_set = true;
-        }
-        else
-        {
-          if (value > max_value)
-            max_value = value;
-        }
-      }//for dof
-    }//if inside logicalVol
-
-  }//for local cell
+      }
+    }//for dof
+  }//for cell inside logicalVol
 
   double all_value=0.0;
   double all_total_volume = 0.0;
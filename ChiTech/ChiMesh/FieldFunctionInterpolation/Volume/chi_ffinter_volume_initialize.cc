@@ -21,26 +21,26 @@ void chi_mesh::FieldFunctionInterpolationVolume::Initialize()
   }
 
   //================================================== Find cell inside volume
-  for (const auto& cell : grid_view->local_cells)
+  cells_inside_logvolume.clear();
+  if (logical_volume != nullptr)
+    cells_inside_logvolume =
+      grid_view->FindCellsInLogicalVolume(*logical_volume);
+  else
+    for (const auto& cell : grid_view->local_cells)
+      cells_inside_logvolume.push_back(cell.local_id);
+
+  for (uint64_t c : cells_inside_logvolume)
   {
+    const auto& cell = grid_view->local_cells[c];
     int cell_local_index = cell.local_id;
 
-    bool inside_logvolume=true;
-
-    if (logical_volume != nullptr)
-      inside_logvolume = logical_volume->Inside(cell.centroid);
-
-    if (inside_logvolume)
+    for (int i=0; i < cell.vertex_ids.size(); i++)
     {
-      for (int i=0; i < cell.vertex_ids.size(); i++)
-      {
-        cfem_local_nodes_needed_unmapped.push_back(i);
-        cfem_local_cells_needed_unmapped.push_back(cell_local_index);
-
-        pwld_local_nodes_needed_unmapped.push_back(i);
-        pwld_local_cells_needed_unmapped.push_back(cell_local_index);
-      }//for dof
-    }//if inside logicalVol
+      cfem_local_nodes_needed_unmapped.push_back(i);
+      cfem_local_cells_needed_unmapped.push_back(cell_local_index);
 
-  }//for local cell
+      pwld_local_nodes_needed_unmapped.push_back(i);
+      pwld_local_cells_needed_unmapped.push_back(cell_local_index);
+    }//for dof
+  }//for cell inside logicalVol
 }
\ No newline at end of file
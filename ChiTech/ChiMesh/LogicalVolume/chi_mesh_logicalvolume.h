@@ -2,8 +2,11 @@
 #define _chi_mesh_logicalvolume_h
 
 #include "../chi_mesh.h"
+#include "ChiMesh/MeshContinuum/chi_meshcontinuum_spatialindex.h"
 #include <chi_log.h>
 
+#include <array>
+
 #define SPHERE        1
 #define SPHERE_ORIGIN 2
 #define RPP           3
@@ -32,6 +35,25 @@ public:
   {
     return false;
   }
+
+  /**Evaluates Inside for each of the given points. Volumes with
+   * expensive point tests can override this to share work between
+   * the points.*/
+  virtual std::vector<bool>
+    InsideBatch(const std::vector<chi_mesh::Vector3>& points) const
+  {
+    std::vector<bool> inside(points.size(), false);
+    for (size_t p=0; p<points.size(); ++p)
+      inside[p] = Inside(points[p]);
+    return inside;
+  }
+
+  /**Sets a box enclosing the volume, if the volume can provide one.
+   * Spatial queries use it to skip cells far from the volume.*/
+  virtual bool GetBoundingBox(chi_mesh::BoundingBox& box) const
+  {
+    return false;
+  }
 };
 
 //###################################################################
@@ -76,6 +98,13 @@ public:
     else
       return false;
   }
+
+  bool GetBoundingBox(chi_mesh::BoundingBox& box) const override
+  {
+    box.xyz_min = chi_mesh::Vector3(x0 - r, y0 - r, z0 - r);
+    box.xyz_max = chi_mesh::Vector3(x0 + r, y0 + r, z0 + r);
+    return true;
+  }
 };
 
 //###################################################################
@@ -116,6 +145,13 @@ public:
     else
       return false;
   }
+
+  bool GetBoundingBox(chi_mesh::BoundingBox& box) const override
+  {
+    box.xyz_min = chi_mesh::Vector3(xmin, ymin, zmin);
+    box.xyz_max = chi_mesh::Vector3(xmax, ymax, zmax);
+    return true;
+  }
 };
 
 //###################################################################
@@ -203,13 +239,26 @@ public:
 };
 
 //###################################################################
-/**SurfaceMesh volume*/
+/**SurfaceMesh volume. The surface mesh must be closed. Its triangles
+ * are copied and indexed by a bounding-volume hierarchy at
+ * construction, hence later changes to the surface mesh are not seen
+ * by the volume.*/
 class chi_mesh::SurfaceMeshLogicalVolume : public LogicalVolume
 {
 private:
+  typedef std::array<chi_mesh::Vector3,3> Triangle;
+  typedef std::vector<std::pair<double,uint64_t>> RayCandidates;
+
+  enum class RayParity {INSIDE, OUTSIDE, ON_SURFACE, AMBIGUOUS};
+
   std::array<double,2> xbounds;
   std::array<double,2> ybounds;
   std::array<double,2> zbounds;
+
+  std::vector<Triangle>      triangles;
+  chi_mesh::MeshSpatialIndex triangle_index;
+  double                     tolerance = 0.0;
+  double                     max_ray_length = 0.0;
 public:
   chi_mesh::SurfaceMesh* surf_mesh = nullptr;
 
@@ -217,6 +266,23 @@ public:
   SurfaceMeshLogicalVolume(chi_mesh::SurfaceMesh* in_surf_mesh);
 
   bool Inside(const chi_mesh::Vector3& point) const override;
+  std::vector<bool>
+    InsideBatch(const std::vector<chi_mesh::Vector3>& points) const override;
+
+  bool GetBoundingBox(chi_mesh::BoundingBox& box) const override
+  {
+    box.xyz_min = chi_mesh::Vector3(xbounds[0], ybounds[0], zbounds[0]);
+    box.xyz_max = chi_mesh::Vector3(xbounds[1], ybounds[1], zbounds[1]);
+    return true;
+  }
+
+private:
+  bool CheckInside(const chi_mesh::Vector3& point,
+                   RayCandidates& candidates) const;
+  RayParity CastParityRay(const chi_mesh::Vector3& point,
+                          const chi_mesh::Vector3& omega,
+                          RayCandidates& candidates) const;
+  double ComputeWindingNumber(const chi_mesh::Vector3& point) const;
 };
 
 
@@ -236,6 +302,31 @@ public:
     }
     return true;
   }
+
+  /**The intersection of the boxes of the parts that provide one.*/
+  bool GetBoundingBox(chi_mesh::BoundingBox& box) const override
+  {
+    bool box_found = false;
+    for (const auto& part : parts)
+    {
+      chi_mesh::BoundingBox part_box;
+      if (not part.second->GetBoundingBox(part_box)) continue;
+
+      if (not box_found)
+        box = part_box;
+      else
+      {
+        box.xyz_min.x = std::max(box.xyz_min.x, part_box.xyz_min.x);
+        box.xyz_min.y = std::max(box.xyz_min.y, part_box.xyz_min.y);
+        box.xyz_min.z = std::max(box.xyz_min.z, part_box.xyz_min.z);
+        box.xyz_max.x = std::min(box.xyz_max.x, part_box.xyz_max.x);
+        box.xyz_max.y = std::min(box.xyz_max.y, part_box.xyz_max.y);
+        box.xyz_max.z = std::min(box.xyz_max.z, part_box.xyz_max.z);
+      }
+      box_found = true;
+    }
+    return box_found;
+  }
 };
 
 
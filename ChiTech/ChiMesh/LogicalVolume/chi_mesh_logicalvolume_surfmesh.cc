@@ -1,10 +1,27 @@
 #include "chi_mesh_logicalvolume.h"
 #include "ChiMesh/chi_mesh.h"
 #include "ChiMesh/SurfaceMesh/chi_surfacemesh.h"
-#include "ChiMesh/Raytrace/raytracing.h"
+
+#include <cmath>
+
+namespace
+{
+/**Directions of the parity rays. They are deliberately not aligned
+ * with the axes or the diagonals, along which the edges of generated
+ * surface meshes typically lie.*/
+const std::array<chi_mesh::Vector3,3> PARITY_RAY_DIRECTIONS =
+  {chi_mesh::Vector3( 0.8156, 0.4361, 0.3803).Normalized(),
+   chi_mesh::Vector3(-0.2877, 0.9046,-0.3146).Normalized(),
+   chi_mesh::Vector3( 0.4082,-0.3615, 0.8383).Normalized()};
+
+/**Barycentric distance from a triangle edge below which a ray hit is
+ * considered to be on the edge.*/
+const double EDGE_TOLERANCE = 1.0e-9;
+}//namespace
 
 //###################################################################
-/**Constructor to compute bound box information.*/
+/**Constructor to compute bound box information and to build the
+ * bounding-volume hierarchy over the triangles.*/
 chi_mesh::SurfaceMeshLogicalVolume::
   SurfaceMeshLogicalVolume(chi_mesh::SurfaceMesh *in_surf_mesh) :
   xbounds({1.0e6,-1.0e6}),
@@ -26,153 +43,181 @@ chi_mesh::SurfaceMeshLogicalVolume::
     if (y > ybounds[1]) ybounds[1] = y;
     if (z > zbounds[1]) zbounds[1] = z;
   }
+
+  //============================================= Tolerances
+  chi_mesh::Vector3 diagonal(xbounds[1] - xbounds[0],
+                             ybounds[1] - ybounds[0],
+                             zbounds[1] - zbounds[0]);
+  tolerance = 1.0e-10*diagonal.Norm() + 1.0e-14;
+  max_ray_length = 2.0*diagonal.Norm() + 1.0;
+
+  //============================================= Triangles
+  const auto& vertices = surf_mesh->vertices;
+
+  triangles.reserve(surf_mesh->faces.size());
+  std::vector<chi_mesh::BoundingBox> triangle_boxes;
+  triangle_boxes.reserve(surf_mesh->faces.size());
+  for (const auto& face : surf_mesh->faces)
+  {
+    Triangle triangle = {vertices[face.v_index[0]],
+                         vertices[face.v_index[1]],
+                         vertices[face.v_index[2]]};
+
+    chi_mesh::BoundingBox box;
+    for (const auto& vertex : triangle)
+      box.Extend(vertex);
+
+    triangles.push_back(triangle);
+    triangle_boxes.push_back(box);
+  }
+
+  triangle_index.Build(std::move(triangle_boxes));
 }
 
 //###################################################################
-/**Logical operation for surface mesh.*/
+/**Logical operation for surface mesh. Points on the surface are
+ * considered inside.*/
 bool chi_mesh::SurfaceMeshLogicalVolume::
   Inside(const chi_mesh::Vector3& point) const
 {
-  double tolerance = 1.0e-5;
+  RayCandidates candidates;
+  return CheckInside(point, candidates);
+}
 
-  //============================================= Boundbox check
-  double x = point.x;
-  double y = point.y;
-  double z = point.z;
+//###################################################################
+/**Logical operation for many points, reusing the ray query storage
+ * between them.*/
+std::vector<bool> chi_mesh::SurfaceMeshLogicalVolume::
+  InsideBatch(const std::vector<chi_mesh::Vector3>& points) const
+{
+  std::vector<bool> inside(points.size(), false);
+
+  RayCandidates candidates;
+  candidates.reserve(64);
+  for (size_t p=0; p<points.size(); ++p)
+    inside[p] = CheckInside(points[p], candidates);
+
+  return inside;
+}
 
-  if (not ((x >= xbounds[0]) and (x <= xbounds[1])))
+//###################################################################
+/**Determines whether a point is inside the surface by the parity of
+ * the number of triangles crossed by a ray from the point. If the ray
+ * passes too close to an edge or vertex for the parity to be reliable,
+ * the next ray direction is tried. Should all directions be ambiguous,
+ * the generalized winding number decides.*/
+bool chi_mesh::SurfaceMeshLogicalVolume::
+  CheckInside(const chi_mesh::Vector3& point,
+              RayCandidates& candidates) const
+{
+  //============================================= Boundbox check
+  if (not ((point.x >= xbounds[0] - tolerance) and
+           (point.x <= xbounds[1] + tolerance)))
     return false;
-  if (not ((y >= ybounds[0]) and (y <= ybounds[1])))
+  if (not ((point.y >= ybounds[0] - tolerance) and
+           (point.y <= ybounds[1] + tolerance)))
     return false;
-  if (not ((z >= zbounds[0]) and (z <= zbounds[1])))
+  if (not ((point.z >= zbounds[0] - tolerance) and
+           (point.z <= zbounds[1] + tolerance)))
     return false;
 
-  //============================================= Cheapshot pass
-  // This pass purely checks if the point have a
-  // negative sense with all the faces of the surface.
-  // If it does then .. bonus .. we don't need to do
-  // anything more because the surface is probably convex.
-  bool cheap_pass = true; // now try to disprove
-  for (size_t f=0; f<surf_mesh->faces.size(); f++)
+  //============================================= Parity rays
+  for (const auto& omega : PARITY_RAY_DIRECTIONS)
   {
-    chi_mesh::Vector3 fc      = surf_mesh->faces[f].face_centroid;
-    chi_mesh::Vector3 p_to_fc = fc - point;
-
-    p_to_fc = p_to_fc/p_to_fc.Norm();
-
-    double sense = p_to_fc.Dot(surf_mesh->faces[f].geometric_normal);
-
-    if (sense < (0.0-tolerance))
+    switch (CastParityRay(point, omega, candidates))
     {
-      cheap_pass = false;
-      break;
+      case RayParity::INSIDE:
+      case RayParity::ON_SURFACE: return true;
+      case RayParity::OUTSIDE:    return false;
+      case RayParity::AMBIGUOUS:  break;
     }
-  }//for f
-
-  //if (!cheap_pass) return false;
-  if (cheap_pass) return true;
-
-  //============================================= Expensive pass
-  // Getting to here means the cheap pass produced
-  // a negative and now we need to do more work.
-  for (size_t f=0; f<surf_mesh->faces.size(); f++)
-  {
-    chi_mesh::Vector3 fc      = surf_mesh->faces[f].face_centroid;
-    chi_mesh::Vector3 p_to_fc = fc - point;
-    double distance_to_face = p_to_fc.Norm();
-    double closest_distance = 1.0e16;
-    bool   closest_sense_pos= false;
-
-
-    p_to_fc = p_to_fc/p_to_fc.Norm();
-
-    double sense = p_to_fc.Dot(surf_mesh->faces[f].geometric_normal);
-
-    bool good_to_go = true;
-    if (sense < (0.0-tolerance))
-    {
-      good_to_go = false;
-      for (size_t fi=0; fi<surf_mesh->faces.size(); fi++)
-      {
-        if (fi==f) continue;  //Skip same face
-
-        //Get all the vertices
-        int v0_i = surf_mesh->faces[fi].v_index[0];
-        int v1_i = surf_mesh->faces[fi].v_index[1];
-        int v2_i = surf_mesh->faces[fi].v_index[2];
-        chi_mesh::Vertex v0 = surf_mesh->vertices[v0_i];
-        chi_mesh::Vertex v1 = surf_mesh->vertices[v1_i];
-        chi_mesh::Vertex v2 = surf_mesh->vertices[v2_i];
-
+  }
 
+  //============================================= Winding number
+  return std::fabs(ComputeWindingNumber(point)) >= 0.5;
+}
 
-        //=========================== Check if the line intersects plane
-        chi_mesh::Vertex         intp;           //Intersection point
-        std::pair<double,double> weights;
-        bool intersects_plane = chi_mesh::
-               CheckPlaneLineIntersect(surf_mesh->faces[fi].geometric_normal,v0,
-                                       point,fc,intp,
-                                       &weights);
-        if (!intersects_plane) continue;
+//###################################################################
+/**Counts the triangles crossed by the ray point + t*omega, t>0, using
+ * the Moller-Trumbore intersection test on the triangles whose
+ * bounding boxes the ray hits.*/
+chi_mesh::SurfaceMeshLogicalVolume::RayParity
+  chi_mesh::SurfaceMeshLogicalVolume::
+  CastParityRay(const chi_mesh::Vector3& point,
+                const chi_mesh::Vector3& omega,
+                RayCandidates& candidates) const
+{
+  triangle_index.FindRayCandidates(point, omega, max_ray_length, candidates);
 
-        //=========================== Check if the line intersects the triangle
-        bool intersects_triangle = true;
+  size_t num_crossings = 0;
+  for (const auto& candidate : candidates)
+  {
+    const auto& triangle = triangles[candidate.second];
 
-        //Compute the legs
-        chi_mesh::Vector3 v01 = v1 - v0;
-        chi_mesh::Vector3 v12 = v2 - v1;
-        chi_mesh::Vector3 v20 = v0 - v2;
+    const chi_mesh::Vector3 e1 = triangle[1] - triangle[0];
+    const chi_mesh::Vector3 e2 = triangle[2] - triangle[0];
 
-        //Compute the vertices to the point
-        chi_mesh::Vector3 v0p = intp - v0;
-        chi_mesh::Vector3 v1p = intp - v1;
-        chi_mesh::Vector3 v2p = intp - v2;
+    const chi_mesh::Vector3 pvec = omega.Cross(e2);
+    const double det = e1.Dot(pvec);
 
-        //Compute the cross products
-        chi_mesh::Vector3 x0p = v01.Cross(v0p);
-        chi_mesh::Vector3 x1p = v12.Cross(v1p);
-        chi_mesh::Vector3 x2p = v20.Cross(v2p);
+    //Rays parallel to the triangle cannot cross it. If such a ray runs
+    //through the triangle it also meets the edges of its neighbors,
+    //which makes the ray ambiguous.
+    if (std::fabs(det) <= 1.0e-12*e1.Norm()*e2.Norm()) continue;
 
-        //Normalize them
-        x0p = x0p/x0p.Norm();
-        x1p = x1p/x1p.Norm();
-        x2p = x2p/x2p.Norm();
+    const double inv_det = 1.0/det;
+    const chi_mesh::Vector3 tvec = point - triangle[0];
+    const double u = tvec.Dot(pvec)*inv_det;
 
-        chi_mesh::Vector3 face_norm = surf_mesh->faces[fi].geometric_normal /
-                                      surf_mesh->faces[fi].geometric_normal.Norm();
+    const chi_mesh::Vector3 qvec = tvec.Cross(e1);
+    const double v = omega.Dot(qvec)*inv_det;
 
-        if (x0p.Dot(face_norm)<0.0) intersects_triangle = false;
-        if (x1p.Dot(face_norm)<0.0) intersects_triangle = false;
-        if (x2p.Dot(face_norm)<0.0) intersects_triangle = false;
+    if (u < -EDGE_TOLERANCE or v < -EDGE_TOLERANCE or
+        u + v > 1.0 + EDGE_TOLERANCE)
+      continue;
 
+    const double t = e2.Dot(qvec)*inv_det;
 
-        if (!intersects_triangle) continue;
+    if (std::fabs(t) <= tolerance) return RayParity::ON_SURFACE;
+    if (t < 0.0) continue;
 
+    if (u < EDGE_TOLERANCE or v < EDGE_TOLERANCE or
+        u + v > 1.0 - EDGE_TOLERANCE)
+      return RayParity::AMBIGUOUS;
 
+    ++num_crossings;
+  }//for candidate
 
-        //============================ Determine the sense with the triangle
-        double sense_with_this_tri =
-          p_to_fc.Dot(surf_mesh->faces[fi].geometric_normal);
-        double distance_to_triangle = weights.second*distance_to_face;
+  return (num_crossings % 2 == 1) ? RayParity::INSIDE : RayParity::OUTSIDE;
+}
 
-        if (distance_to_triangle < closest_distance)
-        {
-          closest_distance = distance_to_triangle;
+//###################################################################
+/**Computes the generalized winding number of the surface about a
+ * point, summing the solid angles of the triangles as given by
+ * Van Oosterom and Strackee. For a closed surface it is +/-1 inside,
+ * depending on the orientation of the triangles, and 0 outside.*/
+double chi_mesh::SurfaceMeshLogicalVolume::
+  ComputeWindingNumber(const chi_mesh::Vector3& point) const
+{
+  double solid_angle = 0.0;
+  for (const auto& triangle : triangles)
+  {
+    const chi_mesh::Vector3 a = triangle[0] - point;
+    const chi_mesh::Vector3 b = triangle[1] - point;
+    const chi_mesh::Vector3 c = triangle[2] - point;
 
-          if (sense_with_this_tri > 0.0)
-            closest_sense_pos = true;
-          else
-            closest_sense_pos = false;
-        }//
+    const double la = a.Norm();
+    const double lb = b.Norm();
+    const double lc = c.Norm();
 
-      }//for inner iter face
-    }//if sense negative
+    if (la <= tolerance or lb <= tolerance or lc <= tolerance) return 1.0;
 
-    if ((closest_distance < distance_to_face) && closest_sense_pos)
-      good_to_go = true;
+    const double numerator = a.Dot(b.Cross(c));
+    const double denominator = la*lb*lc + a.Dot(b)*lc +
+                               b.Dot(c)*la + c.Dot(a)*lb;
 
-    if (!good_to_go) return false;
-  }//for f
+    solid_angle += 2.0*std::atan2(numerator, denominator);
+  }
 
-  return true;
-}
\ No newline at end of file
+  return solid_angle/(4.0*M_PI);
+}
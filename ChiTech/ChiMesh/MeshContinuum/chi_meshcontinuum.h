@@ -5,6 +5,7 @@
 #include "chi_meshcontinuum_localcellhandler.h"
 #include "chi_meshcontinuum_globalcellhandler.h"
 #include "chi_meshcontinuum_vertexhandler.h"
+#include "chi_meshcontinuum_spatialindex.h"
 
 #include "chi_mpi.h"
 
@@ -17,8 +18,7 @@ private:
   std::vector<chi_mesh::Cell*> native_cells;  ///< Actual native cells
   std::vector<chi_mesh::Cell*> foreign_cells; ///< Locally stored ghosts
 
-  std::map<uint64_t,uint64_t> global_cell_id_to_native_id_map;
-  std::map<uint64_t,uint64_t> global_cell_id_to_foreign_id_map;
+  GlobalIDIndex global_cell_id_to_local_id_map;
 
   uint64_t global_vertex_count=0;
 
@@ -33,6 +33,9 @@ public:
 private:
   bool                           face_histogram_available = false;
   bool                           communicators_available  = false;
+  bool                           spatial_index_available = false;
+
+  MeshSpatialIndex               spatial_index;
 
   //Pair.first is the max dofs-per-face for the category and Pair.second
   //is the number of faces in this category
@@ -46,8 +49,7 @@ public:
     cells(local_cell_glob_indices,
           native_cells,
           foreign_cells,
-          global_cell_id_to_native_id_map,
-          global_cell_id_to_foreign_id_map)
+          global_cell_id_to_local_id_map)
   {
     surface_mesh = nullptr;
     line_mesh    = nullptr;
@@ -66,8 +68,9 @@ public:
   {
     native_cells.clear();
     foreign_cells.clear();
-    global_cell_id_to_native_id_map.clear();
-    global_cell_id_to_foreign_id_map.clear();
+    global_cell_id_to_local_id_map.Clear();
+    spatial_index.Clear();
+    spatial_index_available = false;
   }
 
   //01
@@ -102,7 +105,13 @@ public:
 
   std::vector<uint64_t> GetDomainUniqueBoundaryIDs() const;
 
-  size_t CountCellsInLogicalVolume(chi_mesh::LogicalVolume& log_vol) const;
+  std::vector<uint64_t>
+    FindCellsInLogicalVolume(const chi_mesh::LogicalVolume& log_vol);
+  size_t CountCellsInLogicalVolume(chi_mesh::LogicalVolume& log_vol);
+
+  const MeshSpatialIndex& GetSpatialIndex();
+  bool CheckPointInsideCell(const chi_mesh::Cell& cell,
+                            const chi_mesh::Vector3& point) const;
 };
 
 #endif //CHI_MESHCONTINUUM_H_
\ No newline at end of file
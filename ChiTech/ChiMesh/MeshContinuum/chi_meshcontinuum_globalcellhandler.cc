@@ -19,15 +19,15 @@ void chi_mesh::GlobalCellHandler::
 
     native_cells.push_back(new_cell);
 
-    global_cell_id_to_native_id_map.insert(std::make_pair(
-      new_cell->global_id, native_cells.size()-1));
+    global_cell_id_to_local_id_map.Insert(
+      new_cell->global_id, native_cells.size()-1);
   }
   else
   {
     foreign_cells.push_back(new_cell);
 
-    global_cell_id_to_foreign_id_map.insert(std::make_pair(
-      new_cell->global_id, foreign_cells.size() - 1));
+    global_cell_id_to_local_id_map.Insert(
+      new_cell->global_id, (foreign_cells.size() - 1) | FOREIGN_FLAG);
   }
 
 }
@@ -37,15 +37,14 @@ void chi_mesh::GlobalCellHandler::
 chi_mesh::Cell& chi_mesh::GlobalCellHandler::
   operator[](uint64_t cell_global_index)
 {
-  auto native_location = global_cell_id_to_native_id_map.find(cell_global_index);
+  auto local_id = global_cell_id_to_local_id_map.Find(cell_global_index);
 
-  if (native_location != global_cell_id_to_native_id_map.end())
-    return *native_cells[native_location->second];
-  else
+  if (local_id != nullptr)
   {
-    auto foreign_location = global_cell_id_to_foreign_id_map.find(cell_global_index);
-    if (foreign_location != global_cell_id_to_foreign_id_map.end())
-      return *foreign_cells[foreign_location->second];
+    if (*local_id & FOREIGN_FLAG)
+      return *foreign_cells[*local_id & ~FOREIGN_FLAG];
+    else
+      return *native_cells[*local_id];
   }
 
   std::stringstream ostr;
@@ -61,15 +60,14 @@ chi_mesh::Cell& chi_mesh::GlobalCellHandler::
 const chi_mesh::Cell& chi_mesh::GlobalCellHandler::
   operator[](uint64_t cell_global_index) const
 {
-  auto native_location = global_cell_id_to_native_id_map.find(cell_global_index);
+  auto local_id = global_cell_id_to_local_id_map.Find(cell_global_index);
 
-  if (native_location != global_cell_id_to_native_id_map.end())
-    return *native_cells[native_location->second];
-  else
+  if (local_id != nullptr)
   {
-    auto foreign_location = global_cell_id_to_foreign_id_map.find(cell_global_index);
-    if (foreign_location != global_cell_id_to_foreign_id_map.end())
-      return *foreign_cells[foreign_location->second];
+    if (*local_id & FOREIGN_FLAG)
+      return *foreign_cells[*local_id & ~FOREIGN_FLAG];
+    else
+      return *native_cells[*local_id];
   }
 
   std::stringstream ostr;
@@ -121,10 +119,10 @@ std::vector<uint64_t> chi_mesh::GlobalCellHandler::
 uint64_t chi_mesh::GlobalCellHandler::
   GetGhostLocalID(int cell_global_index)
 {
-  auto foreign_location = global_cell_id_to_foreign_id_map.find(cell_global_index);
+  auto local_id = global_cell_id_to_local_id_map.Find(cell_global_index);
 
-  if (foreign_location != global_cell_id_to_foreign_id_map.end())
-    return foreign_location->second;
+  if (local_id != nullptr and (*local_id & FOREIGN_FLAG))
+    return *local_id & ~FOREIGN_FLAG;
 
   std::stringstream ostr;
   ostr << "Grid GetGhostLocalID failed to find cell " << cell_global_index;
@@ -2,24 +2,27 @@
 #define CHI_MESHCONTINUUM_GLOBALCELLHANDLER_H_
 
 #include "ChiMesh/Cell/cell.h"
-
-#include <map>
+#include "chi_meshcontinuum_globalidindex.h"
 
 namespace chi_mesh
 {
 //##################################################
-/**Handles all global index queries.*/
+/**Handles all global index queries. Native and foreign cells share a
+ * single hash index, with foreign cells flagged by FOREIGN_FLAG in the
+ * stored value, so that any global id is resolved with one lookup.*/
 class GlobalCellHandler
 {
   friend class MeshContinuum;
+public:
+  static constexpr uint64_t FOREIGN_FLAG = uint64_t(1) << 63;
+
 private:
   std::vector<uint64_t>& local_cell_glob_indices;
 
   std::vector<chi_mesh::Cell*>& native_cells;
   std::vector<chi_mesh::Cell*>& foreign_cells;
 
-  std::map<uint64_t,uint64_t>& global_cell_id_to_native_id_map;
-  std::map<uint64_t,uint64_t>& global_cell_id_to_foreign_id_map;
+  GlobalIDIndex& global_cell_id_to_local_id_map;
 
 
 private:
@@ -27,13 +30,11 @@ private:
     std::vector<uint64_t>& in_local_cell_glob_indices,
     std::vector<chi_mesh::Cell*>& in_native_cells,
     std::vector<chi_mesh::Cell*>& in_foreign_cells,
-    std::map<uint64_t,uint64_t>& in_global_cell_id_to_native_id_map,
-    std::map<uint64_t,uint64_t>& in_global_cell_id_to_foreign_id_map) :
+    GlobalIDIndex& in_global_cell_id_to_local_id_map) :
     local_cell_glob_indices(in_local_cell_glob_indices),
     native_cells(in_native_cells),
     foreign_cells(in_foreign_cells),
-    global_cell_id_to_native_id_map(in_global_cell_id_to_native_id_map),
-    global_cell_id_to_foreign_id_map(in_global_cell_id_to_foreign_id_map)
+    global_cell_id_to_local_id_map(in_global_cell_id_to_local_id_map)
   {}
 
 public:
@@ -41,7 +42,7 @@ public:
   chi_mesh::Cell& operator[](uint64_t cell_global_index);
   const chi_mesh::Cell& operator[](uint64_t cell_global_index) const;
 
-  size_t GetNumGhosts() {return global_cell_id_to_foreign_id_map.size();}
+  size_t GetNumGhosts() {return foreign_cells.size();}
 
   std::vector<uint64_t> GetGhostGlobalIDs();
 
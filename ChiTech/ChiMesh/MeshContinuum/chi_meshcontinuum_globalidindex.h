@@ -0,0 +1,118 @@
+#ifndef CHI_MESHCONTINUUM_GLOBALIDINDEX_H
+#define CHI_MESHCONTINUUM_GLOBALIDINDEX_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace chi_mesh
+{
+
+//##################################################
+/**Compact open-addressing hash index mapping global ids to local
+ * storage indices. Keys and values are stored in a single flat slot
+ * array with linear probing, which keeps a lookup to, typically, a single
+ * cache line instead of a red-black-tree traversal. The table is kept at
+ * most half full. Entries cannot be erased individually, only the whole
+ * index can be cleared.*/
+class GlobalIDIndex
+{
+private:
+  static constexpr uint64_t EMPTY_KEY = UINT64_MAX;
+
+  struct Slot
+  {
+    uint64_t key   = EMPTY_KEY;
+    uint64_t value = 0;
+  };
+
+  std::vector<Slot> slots;
+  size_t            num_entries = 0;
+  uint64_t          mask = 0;
+
+  /**Mixes the bits of a global id (splitmix64 finalizer) so that
+   * consecutive ids spread over the table.*/
+  static uint64_t Hash(uint64_t key)
+  {
+    key ^= key >> 30; key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27; key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+    return key;
+  }
+
+  /**Rebuilds the table with the given number of slots, which must be
+   * a power of two.*/
+  void Rehash(size_t new_num_slots)
+  {
+    std::vector<Slot> old_slots(new_num_slots);
+    old_slots.swap(slots);
+    mask = new_num_slots - 1;
+
+    for (const auto& slot : old_slots)
+      if (slot.key != EMPTY_KEY)
+      {
+        uint64_t s = Hash(slot.key) & mask;
+        while (slots[s].key != EMPTY_KEY) s = (s + 1) & mask;
+        slots[s] = slot;
+      }
+  }
+
+public:
+  /**Makes sure at least num_keys entries can be inserted without the
+   * table having to grow.*/
+  void Reserve(size_t num_keys)
+  {
+    size_t num_slots = 16;
+    while (num_slots < 2 * num_keys) num_slots *= 2;
+    if (num_slots > slots.size()) Rehash(num_slots);
+  }
+
+  /**Inserts a key-value pair. If the key is already present the
+   * existing value is kept and false is returned.*/
+  bool Insert(uint64_t key, uint64_t value)
+  {
+    if (2 * (num_entries + 1) > slots.size())
+      Rehash(slots.empty()? 16 : 2 * slots.size());
+
+    uint64_t s = Hash(key) & mask;
+    while (slots[s].key != EMPTY_KEY)
+    {
+      if (slots[s].key == key) return false;
+      s = (s + 1) & mask;
+    }
+
+    slots[s].key   = key;
+    slots[s].value = value;
+    ++num_entries;
+    return true;
+  }
+
+  /**Returns a pointer to the value stored for the key, or nullptr
+   * if the key is not present.*/
+  const uint64_t* Find(uint64_t key) const
+  {
+    if (slots.empty()) return nullptr;
+
+    uint64_t s = Hash(key) & mask;
+    while (slots[s].key != EMPTY_KEY)
+    {
+      if (slots[s].key == key) return &slots[s].value;
+      s = (s + 1) & mask;
+    }
+    return nullptr;
+  }
+
+  size_t size() const {return num_entries;}
+
+  void Clear()
+  {
+    slots.clear();
+    slots.shrink_to_fit();
+    num_entries = 0;
+    mask = 0;
+  }
+};
+
+}//namespace chi_mesh
+
+#endif //CHI_MESHCONTINUUM_GLOBALIDINDEX_H
@@ -0,0 +1,339 @@
+#include "chi_meshcontinuum.h"
+
+#include "ChiMesh/Cell/cell.h"
+
+#include "chi_log.h"
+extern ChiLog& chi_log;
+
+#include <cmath>
+
+namespace
+{
+typedef chi_mesh::MeshSpatialIndex::Node IndexNode;
+
+//###################################################################
+/**Depth-first traversal of the hierarchy. Subtrees whose box fails
+ * box_test are skipped, and leaf_func is called for every cell in the
+ * remaining leaves.*/
+template<typename BoxTest, typename LeafFunction>
+void Traverse(const std::vector<IndexNode>& nodes,
+              const std::vector<uint64_t>& cell_ids,
+              BoxTest&& box_test, LeafFunction&& leaf_func)
+{
+  if (nodes.empty()) return;
+
+  std::vector<uint64_t> stack;
+  stack.reserve(64);
+  stack.push_back(0);
+  while (not stack.empty())
+  {
+    const auto& node = nodes[stack.back()];
+    const uint64_t node_index = stack.back();
+    stack.pop_back();
+
+    if (not box_test(node.box)) continue;
+
+    if (node.count > 0)
+    {
+      for (uint64_t i=node.first; i<node.first + node.count; ++i)
+        leaf_func(cell_ids[i]);
+      continue;
+    }
+
+    stack.push_back(node.right_child);
+    stack.push_back(node_index + 1);
+  }
+}
+
+//###################################################################
+/**Computes the distance at which a ray enters a box, using the slab
+ * method. Returns false if the ray misses the box within
+ * [0,max_distance].*/
+bool RayBoxEntry(const chi_mesh::BoundingBox& box,
+                 const chi_mesh::Vector3& origin,
+                 const chi_mesh::Vector3& omega,
+                 double max_distance,
+                 double& t_entry)
+{
+  double t_min = 0.0;
+  double t_max = max_distance;
+  for (size_t d=0; d<3; ++d)
+  {
+    const double o = origin[d];
+    const double lo = box.xyz_min[d];
+    const double hi = box.xyz_max[d];
+
+    if (omega[d] == 0.0)
+    {
+      if (o < lo or o > hi) return false;
+      continue;
+    }
+
+    double t_lo = (lo - o)/omega[d];
+    double t_hi = (hi - o)/omega[d];
+    if (t_lo > t_hi) std::swap(t_lo, t_hi);
+
+    t_min = std::max(t_min, t_lo);
+    t_max = std::min(t_max, t_hi);
+    if (t_min > t_max) return false;
+  }
+
+  t_entry = t_min;
+  return true;
+}
+}//namespace
+
+//###################################################################
+/**Builds the hierarchy over the given cell bounding boxes, indexed by
+ * cell local id.*/
+void chi_mesh::MeshSpatialIndex::Build(std::vector<BoundingBox> in_cell_boxes)
+{
+  Clear();
+  cell_boxes = std::move(in_cell_boxes);
+
+  const size_t num_cells = cell_boxes.size();
+  if (num_cells == 0) return;
+
+  //================================================== Pad boxes
+  BoundingBox mesh_box;
+  for (const auto& box : cell_boxes)
+    mesh_box.Extend(box);
+
+  const double tolerance =
+    1.0e-10*(mesh_box.xyz_max - mesh_box.xyz_min).Norm() + 1.0e-14;
+  const chi_mesh::Vector3 padding(tolerance, tolerance, tolerance);
+
+  std::vector<chi_mesh::Vector3> centers;
+  centers.reserve(num_cells);
+  for (auto& box : cell_boxes)
+  {
+    box.xyz_min = box.xyz_min - padding;
+    box.xyz_max = box.xyz_max + padding;
+    centers.push_back(box.Center());
+  }
+
+  //================================================== Build tree
+  cell_ids.resize(num_cells);
+  for (size_t c=0; c<num_cells; ++c)
+    cell_ids[c] = c;
+
+  nodes.reserve(2*(num_cells/MAX_LEAF_SIZE + 1));
+  BuildNode(0, num_cells, centers);
+}
+
+//###################################################################
+/**Recursively builds the node holding cell_ids[first,first+count) and
+ * returns its index.*/
+uint64_t chi_mesh::MeshSpatialIndex::
+  BuildNode(uint64_t first, uint64_t count,
+            const std::vector<chi_mesh::Vector3>& centers)
+{
+  const uint64_t node_index = nodes.size();
+  nodes.emplace_back();
+
+  BoundingBox box;
+  BoundingBox center_box;
+  for (uint64_t i=first; i<first + count; ++i)
+  {
+    box.Extend(cell_boxes[cell_ids[i]]);
+    center_box.Extend(centers[cell_ids[i]]);
+  }
+  nodes[node_index].box = box;
+
+  //================================================== Split axis
+  const auto extent = center_box.xyz_max - center_box.xyz_min;
+  size_t axis = 0;
+  if (extent.y > extent[axis]) axis = 1;
+  if (extent.z > extent[axis]) axis = 2;
+
+  if (count <= MAX_LEAF_SIZE or extent[axis] <= 0.0)
+  {
+    nodes[node_index].first = first;
+    nodes[node_index].count = count;
+    return node_index;
+  }
+
+  //================================================== Median split
+  const uint64_t num_left = count/2;
+  std::nth_element(cell_ids.begin() + first,
+                   cell_ids.begin() + first + num_left,
+                   cell_ids.begin() + first + count,
+                   [&centers,axis](uint64_t a, uint64_t b)
+                   {return centers[a][axis] < centers[b][axis];});
+
+  BuildNode(first, num_left, centers);
+  const uint64_t right_child =
+    BuildNode(first + num_left, count - num_left, centers);
+  nodes[node_index].right_child = right_child;
+
+  return node_index;
+}
+
+//###################################################################
+/**Releases the hierarchy.*/
+void chi_mesh::MeshSpatialIndex::Clear()
+{
+  cell_boxes.clear();
+  cell_ids.clear();
+  nodes.clear();
+}
+
+//###################################################################
+/**Returns the local ids, in ascending order, of the cells whose
+ * bounding box contains the point.*/
+std::vector<uint64_t> chi_mesh::MeshSpatialIndex::
+  FindPointCandidates(const chi_mesh::Vector3& point) const
+{
+  std::vector<uint64_t> candidates;
+  Traverse(nodes, cell_ids,
+           [&point](const BoundingBox& box) {return box.Contains(point);},
+           [this,&point,&candidates](uint64_t c)
+           {if (cell_boxes[c].Contains(point)) candidates.push_back(c);});
+
+  std::sort(candidates.begin(), candidates.end());
+  return candidates;
+}
+
+//###################################################################
+/**Returns the local ids, in ascending order, of the cells whose
+ * bounding box overlaps the given box.*/
+std::vector<uint64_t> chi_mesh::MeshSpatialIndex::
+  FindBoxOverlaps(const BoundingBox& box) const
+{
+  std::vector<uint64_t> candidates;
+  Traverse(nodes, cell_ids,
+           [&box](const BoundingBox& node_box) {return box.Overlaps(node_box);},
+           [this,&box,&candidates](uint64_t c)
+           {if (cell_boxes[c].Overlaps(box)) candidates.push_back(c);});
+
+  std::sort(candidates.begin(), candidates.end());
+  return candidates;
+}
+
+//###################################################################
+/**Returns the cells whose bounding box is hit by the ray
+ * origin + t*omega, t in [0,max_distance], as pairs of entry distance
+ * and local id, sorted by entry distance. The first candidate
+ * containing the ray's entry point is usually the cell it starts in or
+ * enters first; exact intersections are obtained with chi_mesh::RayTrace.*/
+std::vector<std::pair<double,uint64_t>> chi_mesh::MeshSpatialIndex::
+  FindRayCandidates(const chi_mesh::Vector3& origin,
+                    const chi_mesh::Vector3& omega,
+                    double max_distance) const
+{
+  std::vector<std::pair<double,uint64_t>> candidates;
+  FindRayCandidates(origin, omega, max_distance, candidates);
+  return candidates;
+}
+
+//###################################################################
+/**Same as above but writes the candidates into the given vector, so
+ * that callers issuing many queries can reuse its storage.*/
+void chi_mesh::MeshSpatialIndex::
+  FindRayCandidates(const chi_mesh::Vector3& origin,
+                    const chi_mesh::Vector3& omega,
+                    double max_distance,
+                    std::vector<std::pair<double,uint64_t>>& candidates) const
+{
+  candidates.clear();
+  double t_entry = 0.0;
+  Traverse(nodes, cell_ids,
+           [&](const BoundingBox& box)
+           {return RayBoxEntry(box, origin, omega, max_distance, t_entry);},
+           [&](uint64_t c)
+           {
+             if (RayBoxEntry(cell_boxes[c], origin, omega,
+                             max_distance, t_entry))
+               candidates.emplace_back(t_entry, c);
+           });
+
+  std::sort(candidates.begin(), candidates.end());
+}
+
+//###################################################################
+/**Builds the spatial index over the local cells. The index is built once
+ * and reused until the cell references are cleared. It does not track
+ * subsequent modifications to the cells or vertices.*/
+const chi_mesh::MeshSpatialIndex& chi_mesh::MeshContinuum::GetSpatialIndex()
+{
+  if (spatial_index_available) return spatial_index;
+
+  std::vector<BoundingBox> cell_boxes;
+  cell_boxes.reserve(native_cells.size());
+  for (const auto& cell : local_cells)
+  {
+    BoundingBox box;
+    for (uint64_t vid : cell.vertex_ids)
+      box.Extend(vertices[vid]);
+    cell_boxes.push_back(box);
+  }
+
+  spatial_index.Build(std::move(cell_boxes));
+  spatial_index_available = true;
+
+  chi_log.Log(LOG_ALLVERBOSE_1)
+    << "Spatial index built over " << spatial_index.NumCells()
+    << " local cells.";
+
+  return spatial_index;
+}
+
+//###################################################################
+/**Determines whether a point lies inside a cell. Slabs are tested
+ * against their two vertices, polygons against the planes of their
+ * edges and polyhedra against the planes of their faces. Points on the
+ * cell surface are considered inside.*/
+bool chi_mesh::MeshContinuum::
+  CheckPointInsideCell(const chi_mesh::Cell& cell,
+                       const chi_mesh::Vector3& point) const
+{
+  //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% SLAB
+  if (cell.Type() == chi_mesh::CellType::SLAB)
+  {
+    const auto& v0 = vertices[cell.vertex_ids[0]];
+    const auto& v1 = vertices[cell.vertex_ids[1]];
+
+    chi_mesh::Vector3 v01 = v1 - v0;
+    chi_mesh::Vector3 v0p = point - v0;
+
+    double v01_norm = v01.Norm();
+    double projection = v01.Dot(v0p)/v01_norm;
+
+    return not ((v0p.Dot(v01)<0.0) or (projection>v01_norm));
+  }
+  //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% POLYGON
+  else if (cell.Type() == chi_mesh::CellType::POLYGON)
+  {
+    const chi_mesh::Vector3 nref(0.0, 0.0, 1.0);
+    for (const auto& face : cell.faces)
+    {
+      const auto& v0 = vertices[face.vertex_ids[0]];
+      const auto& v1 = vertices[face.vertex_ids[1]];
+
+      chi_mesh::Vector3 v01 = v1 - v0;
+      chi_mesh::Vector3   n = v01.Cross(nref);
+      n = n/n.Norm();
+
+      chi_mesh::Vector3 v0p = point - v0;
+      v0p=v0p/v0p.Norm();
+
+      if (n.Dot(v0p)>0.0) return false;
+    }//for edge
+    return true;
+  }
+  //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% POLYHEDRON
+  else if (cell.Type() == chi_mesh::CellType::POLYHEDRON)
+  {
+    for (const auto& face : cell.faces)
+      for (uint64_t vid : face.vertex_ids)
+      {
+        chi_mesh::Vector3 v0p = point - vertices[vid];
+        v0p=v0p/v0p.Norm();
+
+        if (face.normal.Dot(v0p)>0.0) return false;
+      }
+    return true;
+  }
+
+  return false;
+}
@@ -0,0 +1,122 @@
+#ifndef CHI_MESHCONTINUUM_SPATIALINDEX_H
+#define CHI_MESHCONTINUUM_SPATIALINDEX_H
+
+#include "ChiMesh/chi_meshvector.h"
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <limits>
+#include <algorithm>
+
+namespace chi_mesh
+{
+
+//##################################################
+/**Axis-aligned bounding box. A default constructed box is empty.*/
+struct BoundingBox
+{
+  chi_mesh::Vector3 xyz_min = chi_mesh::Vector3(
+    std::numeric_limits<double>::max(),
+    std::numeric_limits<double>::max(),
+    std::numeric_limits<double>::max());
+  chi_mesh::Vector3 xyz_max = chi_mesh::Vector3(
+    std::numeric_limits<double>::lowest(),
+    std::numeric_limits<double>::lowest(),
+    std::numeric_limits<double>::lowest());
+
+  void Extend(const chi_mesh::Vector3& point)
+  {
+    xyz_min.x = std::min(xyz_min.x, point.x);
+    xyz_min.y = std::min(xyz_min.y, point.y);
+    xyz_min.z = std::min(xyz_min.z, point.z);
+    xyz_max.x = std::max(xyz_max.x, point.x);
+    xyz_max.y = std::max(xyz_max.y, point.y);
+    xyz_max.z = std::max(xyz_max.z, point.z);
+  }
+
+  void Extend(const BoundingBox& other)
+  {
+    Extend(other.xyz_min);
+    Extend(other.xyz_max);
+  }
+
+  chi_mesh::Vector3 Center() const {return (xyz_min + xyz_max)/2.0;}
+
+  bool Contains(const chi_mesh::Vector3& point) const
+  {
+    return (point.x >= xyz_min.x) and (point.x <= xyz_max.x) and
+           (point.y >= xyz_min.y) and (point.y <= xyz_max.y) and
+           (point.z >= xyz_min.z) and (point.z <= xyz_max.z);
+  }
+
+  bool Overlaps(const BoundingBox& other) const
+  {
+    return (xyz_min.x <= other.xyz_max.x) and (xyz_max.x >= other.xyz_min.x) and
+           (xyz_min.y <= other.xyz_max.y) and (xyz_max.y >= other.xyz_min.y) and
+           (xyz_min.z <= other.xyz_max.z) and (xyz_max.z >= other.xyz_min.z);
+  }
+};
+
+//##################################################
+/**Bounding-volume hierarchy over a set of bounding boxes, typically
+ * those of the local cells of a MeshContinuum or of the triangles of a
+ * surface mesh.
+ *
+ * The hierarchy is built top-down by splitting the cells at the median
+ * of their box centers along the longest axis, giving a balanced tree
+ * of depth O(log N). Nodes are stored depth-first, so that the left child
+ * of a node directly follows it. The cell boxes are padded by a small
+ * tolerance, relative to the extent of the mesh, so that points on
+ * cell faces are found in all adjacent cells.
+ *
+ * All queries return candidates based on bounding boxes only. Exact
+ * tests, e.g. MeshContinuum::CheckPointInsideCell, are left to the
+ * caller.*/
+class MeshSpatialIndex
+{
+public:
+  struct Node
+  {
+    BoundingBox box;
+    uint64_t    first       = 0; ///< Into cell_ids, leaves only
+    uint64_t    count       = 0; ///< 0 for interior nodes
+    uint64_t    right_child = 0; ///< Interior nodes only
+  };
+
+  static constexpr size_t MAX_LEAF_SIZE = 4;
+
+private:
+  std::vector<BoundingBox> cell_boxes;
+  std::vector<uint64_t>    cell_ids;
+  std::vector<Node>        nodes;
+
+public:
+  void Build(std::vector<BoundingBox> in_cell_boxes);
+  void Clear();
+
+  size_t NumCells() const {return cell_boxes.size();}
+  const BoundingBox& GetCellBox(uint64_t cell_local_id) const
+  {return cell_boxes[cell_local_id];}
+
+  std::vector<uint64_t>
+    FindPointCandidates(const chi_mesh::Vector3& point) const;
+  std::vector<uint64_t>
+    FindBoxOverlaps(const BoundingBox& box) const;
+  std::vector<std::pair<double,uint64_t>>
+    FindRayCandidates(const chi_mesh::Vector3& origin,
+                      const chi_mesh::Vector3& omega,
+                      double max_distance) const;
+  void FindRayCandidates(const chi_mesh::Vector3& origin,
+                         const chi_mesh::Vector3& omega,
+                         double max_distance,
+                         std::vector<std::pair<double,uint64_t>>& candidates) const;
+
+private:
+  uint64_t BuildNode(uint64_t first, uint64_t count,
+                     const std::vector<chi_mesh::Vector3>& centers);
+};
+
+}//namespace chi_mesh
+
+#endif //CHI_MESHCONTINUUM_SPATIALINDEX_H
@@ -163,12 +163,13 @@ size_t chi_mesh::MeshContinuum::GetFaceHistogramBinDOFSize(size_t category)
 
 //###################################################################
 /**Check whether a cell is local by attempting to find the key in
- * the native index map.*/
+ * the cell index map and checking that it is not flagged as foreign.*/
 bool chi_mesh::MeshContinuum::IsCellLocal(uint64_t cell_global_index) const
 {
-  auto native_index = global_cell_id_to_native_id_map.find(cell_global_index);
+  auto local_id = global_cell_id_to_local_id_map.Find(cell_global_index);
 
-  if (native_index != global_cell_id_to_native_id_map.end())
+  if (local_id != nullptr and
+      not (*local_id & GlobalCellHandler::FOREIGN_FLAG))
     return true;
 
   return false;
@@ -177,16 +178,10 @@ bool chi_mesh::MeshContinuum::IsCellLocal(uint64_t cell_global_index) const
 
 //###################################################################
 /**Check whether a cell is a boundary by checking if the key is
- * found in the native or foreign cell maps.*/
+ * not found in the cell index map.*/
 bool chi_mesh::MeshContinuum::IsCellBndry(uint64_t cell_global_index) const
 {
-  auto native_index = global_cell_id_to_native_id_map.find(cell_global_index);
-  auto foreign_index = global_cell_id_to_foreign_id_map.find(cell_global_index);
-
-  auto no_native = global_cell_id_to_native_id_map.end();
-  auto no_foreign = global_cell_id_to_foreign_id_map.end();
-
-  if ( (native_index == no_native) and (foreign_index == no_foreign))
+  if (global_cell_id_to_local_id_map.Find(cell_global_index) == nullptr)
     return true;
 
   return false;
@@ -263,16 +258,47 @@ chi_mesh::Vector3 chi_mesh::MeshContinuum::
   return centroid/double(list.size());
 }
 
+//###################################################################
+/**Returns the local ids, in ascending order, of the local cells whose
+ * centroid is inside a logical volume. If the logical volume provides a
+ * bounding box only the cells overlapping it, as found by the spatial
+ * index, are tested.*/
+std::vector<uint64_t> chi_mesh::MeshContinuum::
+  FindCellsInLogicalVolume(const chi_mesh::LogicalVolume& log_vol)
+{
+  std::vector<uint64_t> cell_local_ids;
+
+  std::vector<uint64_t> candidate_ids;
+  chi_mesh::BoundingBox log_vol_box;
+  if (log_vol.GetBoundingBox(log_vol_box))
+    candidate_ids = GetSpatialIndex().FindBoxOverlaps(log_vol_box);
+  else
+  {
+    candidate_ids.reserve(local_cells.size());
+    for (const auto& cell : local_cells)
+      candidate_ids.push_back(cell.local_id);
+  }
+
+  std::vector<chi_mesh::Vector3> centroids;
+  centroids.reserve(candidate_ids.size());
+  for (uint64_t c : candidate_ids)
+    centroids.push_back(local_cells[c].centroid);
+
+  const auto inside = log_vol.InsideBatch(centroids);
+  for (size_t i=0; i<candidate_ids.size(); ++i)
+    if (inside[i])
+      cell_local_ids.push_back(candidate_ids[i]);
+
+  return cell_local_ids;
+}
+
 //###################################################################
 /**Counts the number of cells within a logical volume across all
  * partitions.*/
 size_t chi_mesh::MeshContinuum::
-  CountCellsInLogicalVolume(chi_mesh::LogicalVolume &log_vol) const
+  CountCellsInLogicalVolume(chi_mesh::LogicalVolume &log_vol)
 {
-  size_t local_count=0;
-  for (const auto& cell : local_cells)
-    if (log_vol.Inside(cell.centroid))
-      ++local_count;
+  size_t local_count = FindCellsInLogicalVolume(log_vol).size();
 
   size_t global_count=0;
 
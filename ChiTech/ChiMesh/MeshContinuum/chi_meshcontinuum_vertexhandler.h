@@ -2,43 +2,76 @@
 #define CHI_MESHCONTINUUM_VERTEXHANDLER_H
 
 #include "ChiMesh/chi_meshvector.h"
+#include "chi_meshcontinuum_globalidindex.h"
 
-#include <map>
+#include <vector>
+#include <sstream>
+#include <stdexcept>
 
 namespace chi_mesh
 {
 
-/**Manages a vertex map with custom calls.*/
+/**Manages the locally stored vertices. Vertices are stored densely, as
+ * (global-id, vertex) pairs in insertion order, and are located by
+ * global id through a hash index.*/
 class VertexHandler
 {
-  typedef std::map<uint64_t, chi_mesh::Vector3> GlobalIDMap;
+  typedef std::vector<std::pair<uint64_t, chi_mesh::Vector3>> LocalVertices;
 private:
-  std::map<uint64_t, chi_mesh::Vector3> m_global_id_vertex_map;
+  LocalVertices m_local_vertices;
+  GlobalIDIndex m_global_id_to_local_index;
+
+  /**Returns the local index of a vertex or throws if the vertex is
+   * not stored locally.*/
+  size_t MapGlobalID(const uint64_t global_id) const
+  {
+    const uint64_t* local_index = m_global_id_to_local_index.Find(global_id);
+    if (local_index == nullptr)
+    {
+      std::stringstream ostr;
+      ostr << "chi_mesh::VertexHandler: vertex " << global_id
+           << " is not stored locally.";
+      throw std::out_of_range(ostr.str());
+    }
+    return *local_index;
+  }
 
 public:
   // Iterators
-  GlobalIDMap::iterator begin() {return m_global_id_vertex_map.begin();}
-  GlobalIDMap::iterator end() {return m_global_id_vertex_map.end();}
+  LocalVertices::iterator begin() {return m_local_vertices.begin();}
+  LocalVertices::iterator end() {return m_local_vertices.end();}
 
-  GlobalIDMap::const_iterator begin() const {return m_global_id_vertex_map.begin();}
-  GlobalIDMap::const_iterator end() const {return m_global_id_vertex_map.end();}
+  LocalVertices::const_iterator begin() const {return m_local_vertices.begin();}
+  LocalVertices::const_iterator end() const {return m_local_vertices.end();}
 
   // Accessors
   chi_mesh::Vector3& operator[](const uint64_t global_id)
   {
-    return m_global_id_vertex_map.at(global_id);
+    return m_local_vertices[MapGlobalID(global_id)].second;
   }
 
   const chi_mesh::Vector3& operator[](const uint64_t global_id) const
   {
-    return m_global_id_vertex_map.at(global_id);
+    return m_local_vertices[MapGlobalID(global_id)].second;
   }
 
   // Utilities
+  /**Adds a vertex. If a vertex with the same global id is already
+   * stored the existing vertex is kept.*/
   void Insert(const uint64_t global_id, const chi_mesh::Vector3& vec)
   {
-    m_global_id_vertex_map.insert(std::make_pair(global_id, vec));
+    if (m_global_id_to_local_index.Insert(global_id, m_local_vertices.size()))
+      m_local_vertices.emplace_back(global_id, vec);
   }
+
+  /**Reserves storage for the given number of vertices.*/
+  void Reserve(const size_t num_vertices)
+  {
+    m_local_vertices.reserve(num_vertices);
+    m_global_id_to_local_index.Reserve(num_vertices);
+  }
+
+  size_t size() const {return m_local_vertices.size();}
 };
 
 }//namespace chi_mesh
@@ -52,12 +52,8 @@ void chi_mesh::sweep_management::AngleAggregation::ZeroIncomingDelayedPsi()
       auto& rbndry = (BoundaryReflecting&)(*bndry);
 
       if (rbndry.opposing_reflected)
-        for (auto& angle : rbndry.hetero_boundary_flux_old)
-          for (auto& cellvec : angle)
-            for (auto& facevec : cellvec)
-              for (auto& dofvec : facevec)
-                for (auto& val : dofvec)
-                  val = 0.0;
+        rbndry.hetero_boundary_flux_old.assign(
+          rbndry.hetero_boundary_flux_old.size(), 0.0);
 
     }//if reflecting
   }//for bndry
@@ -82,10 +78,6 @@ void chi_mesh::sweep_management::AngleAggregation::InitializeReflectingBCs()
 {
   const double epsilon = 1.0e-8;
 
-  int total_reflect_cells = 0;
-  int total_reflect_faces = 0;
-  int total_reflect_size = 0;
-
   bool reflecting_bcs_initialized=false;
 
   int bndry_id=0;
@@ -124,55 +116,60 @@ void chi_mesh::sweep_management::AngleAggregation::InitializeReflectingBCs()
         }
       }
 
+      //========================================= Map boundary faces
+      // Every face on the reflecting boundary gets an offset, in face
+      // dofs, into the storage block of an outgoing angle. These offsets
+      // are the same for all angles.
+      rbndry.cell_face_offsets.assign(num_local_cells, -1);
+      rbndry.face_dof_offsets.clear();
+      int64_t num_face_dofs = 0;
+      for (const auto& cell : grid->local_cells)
+      {
+        //=========================== Check cell on ref bndry
+        bool on_ref_bndry = false;
+        for (const auto& face : cell.faces){
+          if ( (not face.has_neighbor) and
+               (face.normal.Dot(rbndry.normal) > 0.999999) )
+          {
+            on_ref_bndry = true;
+            break;
+          }
+        }
+        if (not on_ref_bndry) continue;
+
+        //=========================== If cell on ref bndry
+        rbndry.cell_face_offsets[cell.local_id] =
+          static_cast<int64_t>(rbndry.face_dof_offsets.size());
+        for (const auto& face : cell.faces)
+        {
+          if ( (not face.has_neighbor) and
+               (face.normal.Dot(rbndry.normal) > 0.999999) )
+          {
+            rbndry.face_dof_offsets.push_back(num_face_dofs);
+            num_face_dofs += static_cast<int64_t>(face.vertex_ids.size());
+          }
+          else
+            rbndry.face_dof_offsets.push_back(-1);
+        }
+      }//for cells
+
       //========================================= For angles
-      rbndry.hetero_boundary_flux.clear();
-      rbndry.hetero_boundary_flux_old.clear();
-      rbndry.hetero_boundary_flux.resize(tot_num_angles);
+      //Only outgoing angles get storage
+      rbndry.angle_offsets.assign(tot_num_angles, -1);
+      int64_t num_values = 0;
       for (int n=0; n<tot_num_angles; ++n)
       {
-        //Only continue if omega is outgoing
         if ( quadrature->omegas[n].Dot(rbndry.normal)< 0.0 )
           continue;
 
-        //================================== For cells
-        auto& cell_vec = rbndry.hetero_boundary_flux[n];
-        cell_vec.resize(num_local_cells);
-        for (const auto& cell : grid->local_cells)
-        {
-          int c = cell.local_id;
-
-          //=========================== Check cell on ref bndry
-          bool on_ref_bndry = false;
-          for (const auto& face : cell.faces){
-            if ( (not face.has_neighbor) and
-                 (face.normal.Dot(rbndry.normal) > 0.999999) )
-            {
-              on_ref_bndry = true;
-              break;
-            }
-          }
-          if (not on_ref_bndry) continue;
-          total_reflect_cells += 1;
-
-          //=========================== If cell on ref bndry
-          cell_vec[c].resize(cell.faces.size());
-          int f=0;
-          for (const auto& face : cell.faces)
-          {
-            if ( (not face.has_neighbor) and
-                 (face.normal.Dot(rbndry.normal) > 0.999999) )
-            {
-              cell_vec[c][f].clear();
-              cell_vec[c][f].resize(face.vertex_ids.size(),
-                                    std::vector<double>(number_of_groups,0.0));
-              total_reflect_faces += 1;
-              total_reflect_size  += face.vertex_ids.size()*number_of_groups;
-            }
-            ++f;
-          }
-        }//for cells
+        rbndry.angle_offsets[n] = num_values;
+        num_values += num_face_dofs*number_of_groups;
       }//for angles
 
+      rbndry.num_groups = number_of_groups;
+      rbndry.hetero_boundary_flux.assign(num_values, 0.0);
+      rbndry.hetero_boundary_flux_old.clear();
+
       //========================================= Determine if boundary is
       //                                          opposing reflecting
       if ((bndry_id == 1) and (sim_boundaries[0]->IsReflecting()))
@@ -217,11 +214,7 @@ std::pair<size_t,size_t> chi_mesh::sweep_management::AngleAggregation::
       auto& rbndry = (BoundaryReflecting&)(*bndry);
 
       if (rbndry.opposing_reflected)
-        for (auto& angle : rbndry.hetero_boundary_flux)
-          for (auto& cellvec : angle)
-            for (auto& facevec : cellvec)
-              for (auto& dofvec : facevec)
-                local_ang_unknowns += dofvec.size();
+        local_ang_unknowns += rbndry.hetero_boundary_flux.size();
 
     }//if reflecting
   }//for bndry
@@ -265,13 +258,11 @@ void chi_mesh::sweep_management::AngleAggregation::
     {
       auto& rbndry = (BoundaryReflecting&)(*bndry);
 
+      //After a sweep the latest outgoing fluxes are held in the
+      //old storage, see BoundaryReflecting::ResetAnglesReadyStatus
       if (rbndry.opposing_reflected)
-        for (auto& angle : rbndry.hetero_boundary_flux)
-          for (auto& cellvec : angle)
-            for (auto& facevec : cellvec)
-              for (auto& dofvec : facevec)
-                for (auto val : dofvec)
-                {index++; x_ref[index] = val;}
+        for (auto val : rbndry.hetero_boundary_flux_old)
+        {index++; x_ref[index] = val;}
 
     }//if reflecting
   }//for bndry
@@ -303,12 +294,8 @@ void chi_mesh::sweep_management::AngleAggregation::
       auto& rbndry = (BoundaryReflecting&)(*bndry);
 
       if (rbndry.opposing_reflected)
-        for (auto& angle : rbndry.hetero_boundary_flux_old)
-          for (auto& cellvec : angle)
-            for (auto& facevec : cellvec)
-              for (auto& dofvec : facevec)
-                for (auto& val : dofvec)
-                {index++; val = x_ref[index];}
+        for (auto& val : rbndry.hetero_boundary_flux_old)
+        {index++; val = x_ref[index];}
 
     }//if reflecting
   }//for bndry
@@ -345,12 +332,9 @@ std::vector<double> chi_mesh::sweep_management::AngleAggregation::
       auto& rbndry = (BoundaryReflecting&)(*bndry);
 
       if (rbndry.opposing_reflected)
-        for (auto& angle : rbndry.hetero_boundary_flux_old)
-          for (auto& cellvec : angle)
-            for (auto& facevec : cellvec)
-              for (auto& dofvec : facevec)
-                for (auto val : dofvec)
-                  psi_vector.push_back(val);
+        psi_vector.insert(psi_vector.end(),
+                          rbndry.hetero_boundary_flux_old.begin(),
+                          rbndry.hetero_boundary_flux_old.end());
 
     }//if reflecting
   }//for bndry
@@ -392,12 +376,8 @@ void chi_mesh::sweep_management::AngleAggregation::
       auto& rbndry = (BoundaryReflecting&)(*bndry);
 
       if (rbndry.opposing_reflected)
-        for (auto& angle : rbndry.hetero_boundary_flux_old)
-          for (auto& cellvec : angle)
-            for (auto& facevec : cellvec)
-              for (auto& dofvec : facevec)
-                for (auto& val : dofvec)
-                  val = stl_vector[index++];
+        for (auto& val : rbndry.hetero_boundary_flux_old)
+          val = stl_vector[index++];
 
     }//if reflecting
   }//for bndry
@@ -78,27 +78,47 @@ chi_mesh::sweep_management::AngleSet::
   else if (status == Status::READY_TO_EXECUTE and
            permission == ExecutionPermission::EXECUTE)
   {
-    sweep_buffer.InitializeLocalAndDownstreamBuffers();
+    BeginExecution();
 
     chi_log.LogEvent(timing_tags[0],ChiLog::EventType::EVENT_BEGIN);
     sweep_chunk.Sweep(this); //Execute chunk
     chi_log.LogEvent(timing_tags[0],ChiLog::EventType::EVENT_END);
 
-    //Send outgoing psi and clear local and receive buffers
-    sweep_buffer.SendDownstreamPsi(angle_set_num);
-    sweep_buffer.ClearLocalAndReceiveBuffers();
-
-    //Update boundary readiness
-    for (auto& bndry : ref_boundaries)
-      bndry->UpdateAnglesReadyStatus(angles,ref_subset);
-
-    executed = true;
+    EndExecution(angle_set_num);
     return AngleSetStatus::FINISHED;
   }
   else
     return AngleSetStatus::READY_TO_EXECUTE;
 }
 
+//###################################################################
+/**Prepares the local and downstream buffers for the execution of a
+ * sweep chunk. Together with EndExecution this allows a scheduler to
+ * execute the sweep chunk itself, for instance on a worker thread,
+ * once AngleSetAdvance has reported READY_TO_EXECUTE. Both calls
+ * communicate and must be made from the main thread.*/
+void chi_mesh::sweep_management::AngleSet::BeginExecution()
+{
+  sweep_buffer.InitializeLocalAndDownstreamBuffers();
+}
+
+//###################################################################
+/**Sends the outgoing psi, clears the local and receive buffers and
+ * updates the boundary readiness after the sweep chunk has been
+ * executed. The angle set is marked as executed.*/
+void chi_mesh::sweep_management::AngleSet::EndExecution(int angle_set_num)
+{
+  //Send outgoing psi and clear local and receive buffers
+  sweep_buffer.SendDownstreamPsi(angle_set_num);
+  sweep_buffer.ClearLocalAndReceiveBuffers();
+
+  //Update boundary readiness
+  for (auto& bndry : ref_boundaries)
+    bndry->UpdateAnglesReadyStatus(angles,ref_subset);
+
+  executed = true;
+}
+
 //###################################################################
 /***/
 chi_mesh::sweep_management::AngleSetStatus
@@ -135,6 +155,13 @@ void chi_mesh::sweep_management::AngleSet::SetMaxBufferMessages(int new_max)
   sweep_buffer.max_num_mess = new_max;
 }
 
+//###################################################################
+/**Enables or disables persistent requests in the sweepbuffer.*/
+void chi_mesh::sweep_management::AngleSet::SetUsePersistentRequests(bool flag)
+{
+  sweep_buffer.SetUsePersistentRequests(flag);
+}
+
 //###################################################################
 /**Returns the number of groups associated with the angleset.*/
 int chi_mesh::sweep_management::AngleSet::GetNumGrps() const
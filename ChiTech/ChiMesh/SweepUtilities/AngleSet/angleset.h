@@ -59,6 +59,8 @@ public:
 
   void SetMaxBufferMessages(int new_max);
 
+  void SetUsePersistentRequests(bool flag);
+
   int GetNumGrps() const;
 
   AngleSetStatus AngleSetAdvance(
@@ -66,6 +68,8 @@ public:
              int angle_set_num,
              const std::vector<size_t>& timing_tags,
              ExecutionPermission permission = ExecutionPermission::EXECUTE);
+  void BeginExecution();
+  void EndExecution(int angle_set_num);
   AngleSetStatus FlushSendBuffers();
   void ResetSweepBuffers();
   void ReceiveDelayedData(int angle_set_num);
@@ -393,4 +393,8 @@ void chi_mesh::sweep_management::SPDS::BuildTaskDependencyGraph(bool cycle_allow
     }
     global_sweep_planes.push_back(new_stdg);
   }
-}
\ No newline at end of file
+
+  num_global_sweep_planes = static_cast<int>(global_sweep_planes.size());
+  location_sweep_plane = glob_sweep_order_rank[
+    glob_order_mapping[chi_mpi.location_id]];
+}
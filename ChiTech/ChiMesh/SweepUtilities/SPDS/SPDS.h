@@ -29,6 +29,9 @@ struct chi_mesh::sweep_management::SPDS
 
   std::vector<std::vector<int>> global_dependencies;
 
+  int                      location_sweep_plane = -1;    ///< Plane of this location
+  int                      num_global_sweep_planes = 0;
+
   //======================================== Default constructor
   SPDS() = default;
 
@@ -36,6 +39,7 @@ struct chi_mesh::sweep_management::SPDS
   int MapLocJToDeplocI(int locJ);
 
   void BuildTaskDependencyGraph(bool cycle_allowance_flag);
+  bool BuildDistributedTaskDependencyGraph(bool cycle_allowance_flag);
 };
 
 #endif //CHI_SPDS_H
\ No newline at end of file
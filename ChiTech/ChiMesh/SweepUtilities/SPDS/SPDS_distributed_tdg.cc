@@ -0,0 +1,125 @@
+#include "SPDS.h"
+
+#include "chi_log.h"
+#include "chi_mpi.h"
+#include "ChiTimer/chi_timer.h"
+
+extern ChiLog& chi_log;
+extern ChiMPI& chi_mpi;
+extern ChiTimer   chi_program_timer;
+
+#include <algorithm>
+
+//###################################################################
+/**Determines the sweep plane of this location without assembling the
+ * global task dependency graph. The location dependencies define a
+ * distributed graph communicator over which the sweep planes are
+ * propagated in rounds: a location whose dependencies all have a plane
+ * takes the plane one beyond their maximum and passes it on to its
+ * dependents with an MPI_Neighbor_alltoall. The number of rounds is the
+ * number of sweep planes, and every location only stores and exchanges
+ * data with its direct neighbors.
+ *
+ * A round in which no location resolves its plane indicates a cyclic
+ * dependency. If cycles are allowed the function then returns false,
+ * so that the caller can fall back to the global graph, which is able to
+ * remove them. Otherwise this is an error.
+ *
+ * Only location_sweep_plane and num_global_sweep_planes are set, the
+ * global_sweep_planes and global_dependencies remain empty.*/
+bool chi_mesh::sweep_management::SPDS::
+  BuildDistributedTaskDependencyGraph(bool cycle_allowance_flag)
+{
+  chi_log.Log(LOG_0VERBOSE_1)
+    << chi_program_timer.GetTimeString()
+    << " Building distributed Task Dependency Graph.";
+
+  //============================================= Create graph communicator
+  //Each location only knows its incoming edges, the communicator
+  //resolves the outgoing ones
+  const int num_deps = static_cast<int>(location_dependencies.size());
+  const int location_id = chi_mpi.location_id;
+  std::vector<int> degrees(num_deps, 1);
+  std::vector<int> destinations(num_deps, location_id);
+
+  MPI_Comm tdg_comm;
+  MPI_Dist_graph_create(MPI_COMM_WORLD,                 //Old communicator
+                        num_deps,                       //Number of sources
+                        location_dependencies.data(),   //Sources
+                        degrees.data(),                 //Source degrees
+                        destinations.data(),            //Destinations
+                        MPI_UNWEIGHTED,                 //Weights
+                        MPI_INFO_NULL,                  //Info
+                        0,                              //Reorder
+                        &tdg_comm);                     //New communicator
+
+  int indegree = 0, outdegree = 0, weighted = 0;
+  MPI_Dist_graph_neighbors_count(tdg_comm, &indegree, &outdegree, &weighted);
+
+  //============================================= Propagate sweep planes
+  int plane = -1;
+  std::vector<int> send_planes(outdegree, -1);
+  std::vector<int> recv_planes(indegree, -1);
+
+  int num_unresolved_prev = chi_mpi.process_count + 1;
+  bool cycles_detected = false;
+  while (true)
+  {
+    if (plane < 0)
+    {
+      int max_dep_plane = -1;
+      bool all_deps_resolved = true;
+      for (int dep_plane : recv_planes)
+      {
+        if (dep_plane < 0) {all_deps_resolved = false; break;}
+        max_dep_plane = std::max(max_dep_plane, dep_plane);
+      }
+      if (all_deps_resolved)
+        plane = max_dep_plane + 1;
+    }
+
+    int local_unresolved = (plane < 0)? 1 : 0;
+    int num_unresolved = 0;
+    MPI_Allreduce(&local_unresolved, &num_unresolved, 1,
+                  MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+
+    if (num_unresolved == 0) break;
+    if (num_unresolved == num_unresolved_prev) {cycles_detected = true; break;}
+    num_unresolved_prev = num_unresolved;
+
+    send_planes.assign(outdegree, plane);
+    MPI_Neighbor_alltoall(send_planes.data(), 1, MPI_INT,
+                          recv_planes.data(), 1, MPI_INT,
+                          tdg_comm);
+  }
+
+  MPI_Comm_free(&tdg_comm);
+
+  //============================================= Handle cycles
+  if (cycles_detected)
+  {
+    if (cycle_allowance_flag)
+    {
+      chi_log.Log(LOG_0VERBOSE_1)
+        << chi_program_timer.GetTimeString()
+        << " Cyclic location dependencies detected, reverting to the"
+        << " global Task Dependency Graph.";
+      return false;
+    }
+
+    chi_log.Log(LOG_ALLERROR)
+      << "Distributed sweep-ordering failed. "
+      << "Cyclic dependencies detected. Cycles need to be allowed"
+      << " by calling application.";
+    exit(EXIT_FAILURE);
+  }
+
+  //============================================= Number of sweep planes
+  int max_plane = 0;
+  MPI_Allreduce(&plane, &max_plane, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+
+  location_sweep_plane = plane;
+  num_global_sweep_planes = max_plane + 1;
+
+  return true;
+}
@@ -59,21 +59,12 @@ HeterogenousPsiIncoming(
   double* Psi = zero_boundary_flux.data();
 
   int reflected_angle_num = reflected_anglenum[angle_num];
+  size_t index = MapPsi(reflected_angle_num,cell_local_id,face_num,fi);
 
   if (opposing_reflected)
-  {
-    Psi = &hetero_boundary_flux_old[reflected_angle_num]
-                                   [cell_local_id]
-                                   [face_num]
-                                   [fi][gs_ss_begin];
-  }
+    Psi = &hetero_boundary_flux_old[index + gs_ss_begin];
   else
-  {
-    Psi = &hetero_boundary_flux[reflected_angle_num]
-                               [cell_local_id]
-                               [face_num]
-                               [fi][gs_ss_begin];
-  }
+    Psi = &hetero_boundary_flux[index + gs_ss_begin];
 
   return Psi;
 }
@@ -88,10 +79,8 @@ HeterogenousPsiOutgoing(
   int fi,
   int gs_ss_begin)
 {
-  return &hetero_boundary_flux[angle_num]
-                              [cell_local_id]
-                              [face_num]
-                              [fi][gs_ss_begin];;
+  return &hetero_boundary_flux[MapPsi(angle_num,cell_local_id,face_num,fi) +
+                               gs_ss_begin];
 }
 
 
@@ -112,55 +101,42 @@ bool chi_mesh::sweep_management::BoundaryReflecting::
   if (opposing_reflected) return true;
   bool ready_flag = true;
   for (auto& n : angles)
-    if (hetero_boundary_flux[reflected_anglenum[n]].size()>0)
+    if (angle_offsets[reflected_anglenum[n]] >= 0)
       if (not angle_readyflags[n][gs_ss]) return false;
 
   return ready_flag;
 }
 
 //###################################################################
-/**Resets angle ready flags to false.*/
+/**Resets angle ready flags to false. For opposing reflecting
+ * boundaries the point-wise change between the new and old outgoing
+ * fluxes is computed, after which the storage is swapped so that the
+ * new fluxes become the incoming fluxes of the next sweep.*/
 void chi_mesh::sweep_management::BoundaryReflecting::
   ResetAnglesReadyStatus()
 {
   double local_pw_change = 0.0;
   if (opposing_reflected)
   {
-    int n=0;
-    for (auto& angle : hetero_boundary_flux){
-      int c=0;
-      for (auto& cellvec : angle){
-        int f=0;
-        for (auto& facevec : cellvec){
-          int i=0;
-          for (auto& dofvec : facevec){
-            int g=0;
-            for (auto& new_val : dofvec)
-            {
-              double old_val = hetero_boundary_flux_old[n][c][f][i][g];
-              double delta_val = std::fabs(new_val-old_val);
-              double max_val = std::max(new_val,old_val);
-
-              if (max_val >= std::numeric_limits<double>::min())
-                local_pw_change = std::max(delta_val/max_val,local_pw_change);
-              else
-                local_pw_change = std::max(delta_val,local_pw_change);
-
-              hetero_boundary_flux_old[n][c][f][i][g] = new_val;
-              ++g;
-            }
-            ++i;
-          }
-          ++f;
-        }
-        ++c;
-      }
-      ++n;
+    const size_t num_values = hetero_boundary_flux.size();
+    for (size_t k=0; k<num_values; ++k)
+    {
+      double new_val = hetero_boundary_flux[k];
+      double old_val = hetero_boundary_flux_old[k];
+      double delta_val = std::fabs(new_val-old_val);
+      double max_val = std::max(new_val,old_val);
+
+      if (max_val >= std::numeric_limits<double>::min())
+        local_pw_change = std::max(delta_val/max_val,local_pw_change);
+      else
+        local_pw_change = std::max(delta_val,local_pw_change);
     }
+    hetero_boundary_flux.swap(hetero_boundary_flux_old);
+
     MPI_Allreduce(&local_pw_change,&pw_change,1,MPI_DOUBLE,MPI_MAX,MPI_COMM_WORLD);
   }
 
   for (auto& flags : angle_readyflags)
     for (int gs_ss=0; gs_ss<flags.size(); ++gs_ss)
       flags[gs_ss] = false;
-}
\ No newline at end of file
+}
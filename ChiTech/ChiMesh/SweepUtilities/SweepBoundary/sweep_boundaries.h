@@ -99,15 +99,18 @@ public:
   const chi_mesh::Normal normal;
   bool  opposing_reflected = false;
 
-  typedef std::vector<double> DOFVec;   //Groups per DOF
-  typedef std::vector<DOFVec> FaceVec;  //DOFs per face
-  typedef std::vector<FaceVec> CellVec; //Faces per cell
-  typedef std::vector<CellVec> AngVec;  //Cell per angle
-
-  //angle,cell,face,dof,group
-  //Populated by angle aggregation
-  std::vector<AngVec>              hetero_boundary_flux;
-  std::vector<AngVec>              hetero_boundary_flux_old;
+  //Flat storage of the outgoing angular fluxes, ordered
+  //angle,cell,face,dof,group. Populated by angle aggregation.
+  //The groups of face dof fi, on face f of local cell c, for
+  //outgoing angle n start at index
+  //  angle_offsets[n] +
+  //  (face_dof_offsets[cell_face_offsets[c] + f] + fi)*num_groups
+  std::vector<double>              hetero_boundary_flux;
+  std::vector<double>              hetero_boundary_flux_old;
+  std::vector<int64_t>             angle_offsets;     ///< -1 if incoming
+  std::vector<int64_t>             cell_face_offsets; ///< -1 if not on bndry
+  std::vector<int64_t>             face_dof_offsets;  ///< -1 if not on bndry
+  size_t                           num_groups=0;
   double                           pw_change=0.0;
 
   std::vector<int>                 reflected_anglenum;
@@ -120,6 +123,18 @@ public:
   normal(in_normal)
   {}
 
+  /**Returns the index of the first group of face dof fi, on face
+   * face_num of the given cell, for the given outgoing angle.*/
+  size_t MapPsi(int angle_num,
+                uint64_t cell_local_id,
+                int face_num,
+                int fi) const
+  {
+    return angle_offsets[angle_num] +
+           (face_dof_offsets[cell_face_offsets[cell_local_id] + face_num] +
+            fi) * num_groups;
+  }
+
   double* HeterogenousPsiIncoming(
                           int angle_num,
                           uint64_t cell_local_id,
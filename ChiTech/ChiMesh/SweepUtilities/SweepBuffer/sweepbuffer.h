@@ -44,7 +44,16 @@ private:
 
   std::vector<std::vector<MPI_Request>> deplocI_message_request;
 
+  //Persistent communication
+  bool use_persistent_requests = false;
+  bool prelocI_receives_posted = false;
+  int  persistent_recv_tag_base = -1;
+  int  persistent_send_tag_base = -1;
+  int  num_pending_receives = 0;
 
+  std::vector<MPI_Request>         prelocI_persistent_request;
+  std::vector<std::pair<int,int>>  prelocI_persistent_request_map;
+  std::vector<int>                 persistent_completed_indices;
 
 public:
   int max_num_mess;
@@ -52,6 +61,7 @@ public:
   SweepBuffer(chi_mesh::sweep_management::AngleSet* ref_angleset,
               int sweep_eager_limit,
               ChiMPICommunicatorSet* in_comm_set);
+  ~SweepBuffer();
   bool DoneSending();
   void BuildMessageStructure();
   void InitializeDelayedUpstreamData();
@@ -63,6 +73,13 @@ public:
   void ClearLocalAndReceiveBuffers();
   void Reset();
 
+  //Persistent communication
+  void SetUsePersistentRequests(bool flag);
+private:
+  void InitializePersistentReceives(int angle_set_num);
+  void InitializePersistentSends(int angle_set_num);
+  void FreePersistentRequests();
+  AngleSetStatus ReceiveUpstreamPsiPersistent(int angle_set_num);
 };
 } }
 #endif //CHI_SWEEPBUFFER_H
\ No newline at end of file
@@ -36,6 +36,9 @@ ClearLocalAndReceiveBuffers()
   auto empty_vector = std::vector<std::vector<double>>(0);
   angleset->local_psi.swap(empty_vector);
 
+  //Persistent receives are bound to the incoming buffers
+  if (use_persistent_requests) return;
+
   empty_vector = std::vector<std::vector<double>>(0);
   angleset->prelocI_outgoing_psi.swap(empty_vector);
 }
@@ -63,7 +66,8 @@ ClearDownstreamBuffers()
 
   }
 
-  if (done_sending)
+  //Persistent sends are bound to the outgoing buffers
+  if (done_sending and (not use_persistent_requests))
   {
     for (size_t deplocI=0; deplocI<spds->location_successors.size(); deplocI++)
     {
@@ -80,6 +84,7 @@ void chi_mesh::sweep_management::SweepBuffer::Reset()
   done_sending = false;
   data_initialized = false;
   upstream_data_initialized = false;
+  prelocI_receives_posted = false;
 
   for (int prelocI=0; prelocI<prelocI_message_available.size(); prelocI++)
     for (int m=0; m<prelocI_message_available[prelocI].size(); m++)
@@ -37,12 +37,23 @@ InitializeLocalAndDownstreamBuffers()
                                      num_grps*num_angles,0.0);
     }
 
+    //============================ Complete previous persistent sends
+    // The persistent sends of the previous sweep may still be reading
+    // the outgoing buffers, which are overwritten below and by the
+    // sweep chunk.
+    if (use_persistent_requests and persistent_send_tag_base >= 0)
+      for (auto& requests : deplocI_message_request)
+        MPI_Waitall(static_cast<int>(requests.size()),
+                    requests.data(), MPI_STATUSES_IGNORE);
+
     //============================ Resize FLUDS non-local outgoing Data
     angleset->deplocI_outgoing_psi.resize(
       spds->location_successors.size(),std::vector<double>());
+    // With persistent requests the buffers are retained between sweeps,
+    // assign then zeroes them without reallocating.
     for (size_t deplocI=0; deplocI<spds->location_successors.size(); deplocI++)
     {
-      angleset->deplocI_outgoing_psi[deplocI].resize(
+      angleset->deplocI_outgoing_psi[deplocI].assign(
         fluds->deplocI_face_dof_count[deplocI]*num_grps*num_angles,0.0);
     }
 
@@ -0,0 +1,184 @@
+#include "sweepbuffer.h"
+
+#include "ChiMesh/SweepUtilities/AngleSet/angleset.h"
+#include "ChiMesh/SweepUtilities/SPDS/SPDS.h"
+
+#include <chi_mpi.h>
+
+extern ChiMPI&      chi_mpi;
+
+//###################################################################
+/**Destructor. Frees the persistent requests, if any.*/
+chi_mesh::sweep_management::SweepBuffer::~SweepBuffer()
+{
+  int mpi_finalized = 0;
+  MPI_Finalized(&mpi_finalized);
+  if (not mpi_finalized)
+    FreePersistentRequests();
+}
+
+//###################################################################
+/**Enables or disables the use of persistent requests.
+ *
+ * With persistent requests the message structure built by
+ * BuildMessageStructure is bound, once, to MPI_Recv_init and
+ * MPI_Send_init requests. The receives of an angleset are pre-posted
+ * when the angleset is first polled in a sweep and completed with
+ * MPI_Testsome, instead of probing for every message. The
+ * non-local incoming and outgoing buffers must then persist between
+ * sweeps, which increases the memory footprint.*/
+void chi_mesh::sweep_management::SweepBuffer::
+  SetUsePersistentRequests(bool flag)
+{
+  if (use_persistent_requests and (not flag))
+    FreePersistentRequests();
+
+  use_persistent_requests = flag;
+}
+
+//###################################################################
+/**Creates the persistent receive requests for all predecessor
+ * messages. The incoming buffers must already be allocated.*/
+void chi_mesh::sweep_management::SweepBuffer::
+  InitializePersistentReceives(int angle_set_num)
+{
+  for (auto& request : prelocI_persistent_request)
+    if (request != MPI_REQUEST_NULL) MPI_Request_free(&request);
+  prelocI_persistent_request.clear();
+  prelocI_persistent_request_map.clear();
+
+  auto spds = angleset->GetSPDS();
+
+  for (size_t prelocI=0; prelocI<spds->location_dependencies.size(); prelocI++)
+  {
+    int locJ = spds->location_dependencies[prelocI];
+
+    int num_mess = prelocI_message_count[prelocI];
+    for (int m=0; m<num_mess; m++)
+    {
+      u_ll_int block_addr   = prelocI_message_blockpos[prelocI][m];
+      u_ll_int message_size = prelocI_message_size[prelocI][m];
+
+      MPI_Request request;
+      MPI_Recv_init(&angleset->prelocI_outgoing_psi[prelocI].data()[block_addr],
+                    message_size,
+                    MPI_DOUBLE,
+                    comm_set->MapIonJ(locJ,chi_mpi.location_id),
+                    max_num_mess*angle_set_num + m, //tag
+                    comm_set->communicators[chi_mpi.location_id],
+                    &request);
+
+      prelocI_persistent_request.push_back(request);
+      prelocI_persistent_request_map.emplace_back(prelocI,m);
+    }//for message
+  }//for prelocI
+
+  persistent_completed_indices.resize(prelocI_persistent_request.size());
+  persistent_recv_tag_base = max_num_mess*angle_set_num;
+}
+
+//###################################################################
+/**Creates the persistent send requests for all successor messages.
+ * The outgoing buffers must already be allocated.*/
+void chi_mesh::sweep_management::SweepBuffer::
+  InitializePersistentSends(int angle_set_num)
+{
+  if (persistent_send_tag_base >= 0)
+    for (auto& requests : deplocI_message_request)
+      for (auto& request : requests)
+        if (request != MPI_REQUEST_NULL) MPI_Request_free(&request);
+
+  auto spds = angleset->GetSPDS();
+
+  for (size_t deplocI=0; deplocI<spds->location_successors.size(); deplocI++)
+  {
+    int locJ = spds->location_successors[deplocI];
+
+    int num_mess = deplocI_message_count[deplocI];
+    for (int m=0; m<num_mess; m++)
+    {
+      u_ll_int block_addr   = deplocI_message_blockpos[deplocI][m];
+      u_ll_int message_size = deplocI_message_size[deplocI][m];
+
+      MPI_Send_init(&angleset->deplocI_outgoing_psi[deplocI].data()[block_addr],
+                    message_size,
+                    MPI_DOUBLE,
+                    comm_set->MapIonJ(locJ,locJ),
+                    max_num_mess*angle_set_num + m, //tag
+                    comm_set->communicators[locJ],
+                    &deplocI_message_request[deplocI][m]);
+    }//for message
+  }//for deplocI
+
+  persistent_send_tag_base = max_num_mess*angle_set_num;
+}
+
+//###################################################################
+/**Frees all persistent requests.*/
+void chi_mesh::sweep_management::SweepBuffer::FreePersistentRequests()
+{
+  for (auto& request : prelocI_persistent_request)
+    if (request != MPI_REQUEST_NULL) MPI_Request_free(&request);
+  prelocI_persistent_request.clear();
+  prelocI_persistent_request_map.clear();
+  persistent_recv_tag_base = -1;
+  prelocI_receives_posted = false;
+
+  if (persistent_send_tag_base >= 0)
+    for (auto& requests : deplocI_message_request)
+      for (auto& request : requests)
+      {
+        if (request != MPI_REQUEST_NULL) MPI_Request_free(&request);
+        request = MPI_REQUEST_NULL;
+      }
+  persistent_send_tag_base = -1;
+}
+
+//###################################################################
+/**Persistent-request version of ReceiveUpstreamPsi. On the first call
+ * of a sweep all receives are started, thereafter completed receives
+ * are collected with MPI_Testsome.*/
+chi_mesh::sweep_management::AngleSetStatus
+chi_mesh::sweep_management::SweepBuffer::
+  ReceiveUpstreamPsiPersistent(int angle_set_num)
+{
+  //============================== Post receives
+  if (not prelocI_receives_posted)
+  {
+    if (persistent_recv_tag_base != max_num_mess*angle_set_num)
+      InitializePersistentReceives(angle_set_num);
+
+    if (not prelocI_persistent_request.empty())
+      MPI_Startall(static_cast<int>(prelocI_persistent_request.size()),
+                   prelocI_persistent_request.data());
+
+    num_pending_receives = static_cast<int>(prelocI_persistent_request.size());
+    prelocI_receives_posted = true;
+  }
+
+  if (num_pending_receives == 0)
+    return AngleSetStatus::READY_TO_EXECUTE;
+
+  //============================== Collect completed receives
+  int num_completed = 0;
+  MPI_Testsome(static_cast<int>(prelocI_persistent_request.size()),
+               prelocI_persistent_request.data(),
+               &num_completed,
+               persistent_completed_indices.data(),
+               MPI_STATUSES_IGNORE);
+
+  if (num_completed == MPI_UNDEFINED) num_completed = 0;
+
+  for (int k=0; k<num_completed; ++k)
+  {
+    const auto& message = prelocI_persistent_request_map[
+                            persistent_completed_indices[k]];
+    prelocI_message_available[message.first][message.second] = true;
+  }
+  num_pending_receives -= num_completed;
+
+  if (num_pending_receives > 0)
+    return AngleSetStatus::RECEIVING;
+  else
+    return AngleSetStatus::READY_TO_EXECUTE;
+}
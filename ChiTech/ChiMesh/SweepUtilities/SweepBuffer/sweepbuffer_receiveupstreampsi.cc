@@ -36,6 +36,9 @@ chi_mesh::sweep_management::SweepBuffer::ReceiveUpstreamPsi(int angle_set_num)
     upstream_data_initialized = true;
   }
 
+  if (use_persistent_requests)
+    return ReceiveUpstreamPsiPersistent(angle_set_num);
+
   //============================== Assume all data is available and now try
   //                               to receive all of it
   bool ready_to_execute = true;
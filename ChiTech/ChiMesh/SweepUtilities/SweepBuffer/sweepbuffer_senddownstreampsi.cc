@@ -11,6 +11,19 @@ SendDownstreamPsi(int angle_set_num)
 {
   auto spds =  angleset->GetSPDS();
 
+  //============================== Persistent requests
+  if (use_persistent_requests)
+  {
+    if (persistent_send_tag_base != max_num_mess*angle_set_num)
+      InitializePersistentSends(angle_set_num);
+
+    //The previous sweep's sends were completed when the outgoing
+    //buffers were initialized
+    for (auto& requests : deplocI_message_request)
+      MPI_Startall(static_cast<int>(requests.size()), requests.data());
+    return;
+  }
+
   for (size_t deplocI=0; deplocI<spds->location_successors.size(); deplocI++)
   {
     int locJ = spds->location_successors[deplocI];
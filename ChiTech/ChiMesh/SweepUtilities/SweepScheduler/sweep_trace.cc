@@ -0,0 +1,66 @@
+#include "sweep_trace.h"
+
+#include <chi_mpi.h>
+
+extern ChiMPI& chi_mpi;
+
+#include <algorithm>
+#include <cstdio>
+
+//###################################################################
+/**Allocates the ring buffer and starts collecting records. Existing
+ * records are discarded.*/
+void chi_mesh::sweep_management::SweepTrace::Enable(size_t capacity)
+{
+  records.assign(std::max<size_t>(capacity,1), Record());
+  next_record  = 0;
+  num_added    = 0;
+  sweep_number = 0;
+  location_id  = chi_mpi.location_id;
+}
+
+//###################################################################
+/**Returns the number of records currently held.*/
+size_t chi_mesh::sweep_management::SweepTrace::NumRecords() const
+{
+  return std::min(num_added, records.size());
+}
+
+//###################################################################
+/**Returns the number of records that have been overwritten because
+ * the ring buffer was full.*/
+size_t chi_mesh::sweep_management::SweepTrace::NumOverwritten() const
+{
+  return num_added - NumRecords();
+}
+
+//###################################################################
+/**Writes the records, oldest first, one per line in the format
+ * [location] sweep angle-set begin end with times in seconds.
+ * The format is intended for offline timeline plots.*/
+void chi_mesh::sweep_management::SweepTrace::
+  WriteRecords(std::ostream& ostr) const
+{
+  const size_t num_records = NumRecords();
+
+  ostr << "Sweep trace: " << num_records << " angle set executions";
+  if (NumOverwritten() > 0)
+    ostr << " (" << NumOverwritten() << " older executions overwritten)";
+  ostr << "\n";
+  ostr << "# location sweep angle-set begin(s) end(s)\n";
+
+  const size_t first = (num_added > records.size())? next_record : 0;
+  char buf[128];
+  for (size_t r=0; r<num_records; ++r)
+  {
+    const Record& record = records[(first + r) % records.size()];
+
+    snprintf(buf, sizeof(buf), "[%d] %llu %d %16.9f %16.9f\n",
+             record.location_id,
+             static_cast<unsigned long long>(record.sweep_number),
+             record.angle_set_num,
+             record.begin_time/1000.0,
+             record.end_time/1000.0);
+    ostr << buf;
+  }
+}
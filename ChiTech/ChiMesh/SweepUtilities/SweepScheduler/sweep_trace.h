@@ -0,0 +1,69 @@
+#ifndef CHI_SWEEP_TRACE_H
+#define CHI_SWEEP_TRACE_H
+
+#include "ChiMesh/SweepUtilities/sweep_namespace.h"
+
+#include <cstdint>
+#include <vector>
+#include <ostream>
+
+//###################################################################
+/**Low overhead trace of angle set executions. Records have a fixed
+ * size and are stored in a ring buffer that is allocated once, when
+ * the trace is enabled, so that recording never allocates and long
+ * runs retain only the most recent executions. Only the thread that
+ * drives the sweep scheduler may add records.*/
+class chi_mesh::sweep_management::SweepTrace
+{
+public:
+  /**A single angle set execution. Times are program times in
+   * milliseconds.*/
+  struct Record
+  {
+    uint64_t sweep_number  = 0;
+    int32_t  angle_set_num = 0;
+    int32_t  location_id   = 0;
+    double   begin_time    = 0.0;
+    double   end_time      = 0.0;
+  };
+
+  static constexpr size_t DEFAULT_CAPACITY = 65536;
+
+private:
+  std::vector<Record> records;
+  size_t              next_record  = 0;
+  size_t              num_added    = 0;
+  uint64_t            sweep_number = 0;
+  int32_t             location_id  = 0;
+
+public:
+  void Enable(size_t capacity=DEFAULT_CAPACITY);
+
+  /**Returns true if records are being collected.*/
+  bool IsEnabled() const {return not records.empty();}
+
+  /**Marks the start of a new sweep. Subsequent records carry the
+   * new sweep number.*/
+  void BeginSweep() {++sweep_number;}
+
+  /**Adds a record, overwriting the oldest one when the buffer is full.
+   * The trace must be enabled.*/
+  void Add(int angle_set_num, double begin_time, double end_time)
+  {
+    Record& record       = records[next_record];
+    record.sweep_number  = sweep_number;
+    record.angle_set_num = angle_set_num;
+    record.location_id   = location_id;
+    record.begin_time    = begin_time;
+    record.end_time      = end_time;
+
+    if (++next_record == records.size()) next_record = 0;
+    ++num_added;
+  }
+
+  size_t NumRecords() const;
+  size_t NumOverwritten() const;
+  void   WriteRecords(std::ostream& ostr) const;
+};
+
+#endif //CHI_SWEEP_TRACE_H
@@ -3,7 +3,12 @@
 
 #include "ChiMesh/SweepUtilities/AngleAggregation/angleaggregation.h"
 #include "ChiMesh/SweepUtilities/sweepchunk_base.h"
+#include "sweep_trace.h"
 
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
 
 namespace chi_mesh { namespace sweep_management
 {
@@ -45,14 +50,30 @@ private:
     }
   };
   std::vector<RULE_VALUES> rule_values;
+
+  //Threaded execution
+  const int num_threads;
+  std::vector<std::vector<double>>         worker_phi;
+  std::vector<std::shared_ptr<SweepChunk>> worker_chunks;
+  std::vector<std::thread>                 worker_threads;
+  std::mutex                               worker_mutex;
+  std::condition_variable                  worker_cv;
+  std::condition_variable                  worker_done_cv;
+  std::deque<size_t>                       worker_task_queue;
+  std::vector<size_t>                      worker_completed_tasks;
+  std::vector<std::pair<double,double>>    worker_task_times;
+  bool                                     worker_shutdown = false;
 public:
   SweepChunk& sweep_chunk;
   const size_t sweep_event_tag;
   const std::vector<size_t> sweep_timing_events_tag;
+  SweepTrace sweep_trace;
 public:
   SweepScheduler(SchedulingAlgorithm in_scheduler_type,
                  AngleAggregation& in_angle_agg,
-                 SweepChunk& in_sweep_chunk);
+                 SweepChunk& in_sweep_chunk,
+                 int in_num_threads=1);
+  ~SweepScheduler();
 
   void Sweep();
   double GetAverageSweepTime() const;
@@ -64,6 +85,16 @@ private:
   //02
   void InitializeAlgoDOG();
   void ScheduleAlgoDOG(SweepChunk& sweep_chunk);
+
+  //Threaded execution
+  void InitializeWorkerThreads();
+  void WorkerThreadLoop(size_t worker_id);
+  bool PrepareWorkerChunks(SweepChunk& sweep_chunk);
+  void SubmitWorkerTask(size_t rule_index);
+  std::vector<size_t> CollectCompletedWorkerTasks();
+  void WaitForWorkerTasks();
+  void ReduceWorkerPhi(SweepChunk& sweep_chunk);
+  void FinalizeWorkerThreads();
 };
 
 #endif //CHI_SWEEPSCHEDULER_H
\ No newline at end of file
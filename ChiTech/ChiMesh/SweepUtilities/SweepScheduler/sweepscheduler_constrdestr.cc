@@ -9,9 +9,11 @@ extern ChiLog& chi_log;
 chi_mesh::sweep_management::SweepScheduler::SweepScheduler(
     SchedulingAlgorithm in_scheduler_type,
     chi_mesh::sweep_management::AngleAggregation& in_angle_agg,
-    SweepChunk& in_sweep_chunk) :
+    SweepChunk& in_sweep_chunk,
+    int in_num_threads) :
   scheduler_type(in_scheduler_type),
   angle_agg(in_angle_agg),
+  num_threads(in_num_threads),
   sweep_chunk(in_sweep_chunk),
   sweep_event_tag(chi_log.GetRepeatingEventTag("Sweep Timing")),
   sweep_timing_events_tag({
@@ -21,7 +23,11 @@ chi_mesh::sweep_management::SweepScheduler::SweepScheduler(
   angle_agg.InitializeReflectingBCs();
 
   if (scheduler_type == SchedulingAlgorithm::DEPTH_OF_GRAPH)
+  {
     InitializeAlgoDOG();
+    if (num_threads > 1)
+      InitializeWorkerThreads();
+  }
 
   //=================================== Initialize delayed upstream data
   for (auto& angsetgrp : in_angle_agg.angle_set_groups)
@@ -47,4 +53,11 @@ chi_mesh::sweep_management::SweepScheduler::SweepScheduler(
   for (auto& angsetgrp : in_angle_agg.angle_set_groups)
     for (auto& angset : angsetgrp.angle_sets)
       angset->SetMaxBufferMessages(global_max_num_messages);
+}
+
+//###################################################################
+/**Sweep scheduler destructor. Joins the worker threads, if any.*/
+chi_mesh::sweep_management::SweepScheduler::~SweepScheduler()
+{
+  FinalizeWorkerThreads();
 }
\ No newline at end of file
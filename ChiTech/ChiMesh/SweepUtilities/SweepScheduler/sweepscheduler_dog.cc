@@ -2,11 +2,12 @@
 
 #include <chi_mpi.h>
 #include <chi_log.h>
+#include "ChiTimer/chi_timer.h"
 
 extern ChiMPI& chi_mpi;
 extern ChiLog& chi_log;
+extern ChiTimer chi_program_timer;
 
-#include <sstream>
 #include <algorithm>
 
 //###################################################################
@@ -27,24 +28,13 @@ void chi_mesh::sweep_management::SweepScheduler::InitializeAlgoDOG()
     {
       auto angleset                 = angleset_group.angle_sets[as];
       auto       spds               = angleset->GetSPDS();
-      TLEVELED_GRAPH& leveled_graph = spds->global_sweep_planes;
 
-      //========================== Find location depth
-      size_t loc_depth = -1;
-      for (size_t level=0; level<leveled_graph.size(); level++)
-      {
-        for (size_t index=0; index<leveled_graph[level].item_id.size(); index++)
-        {
-          if (leveled_graph[level].item_id[index] == chi_mpi.location_id)
-          {
-            loc_depth = leveled_graph.size()-level;
-            break;
-          }
-        }//for locations in plane
-      }//for sweep planes
+      //========================== Location depth
+      const int loc_depth = spds->num_global_sweep_planes -
+                            spds->location_sweep_plane;
 
       //========================== Set up rule values
-      if (loc_depth>=0)
+      if (spds->location_sweep_plane >= 0)
       {
         RULE_VALUES new_rule_vals(angleset);
         new_rule_vals.depth_of_graph = loc_depth;
@@ -123,23 +113,36 @@ void chi_mesh::sweep_management::SweepScheduler::
 
   chi_log.LogEvent(sweep_event_tag, ChiLog::EventType::EVENT_BEGIN);
 
-  auto ev_info =
-    std::make_shared<ChiLog::EventInfo>(std::string("Sweep initiated"));
-
-  chi_log.LogEvent(sweep_event_tag,
-                   ChiLog::EventType::SINGLE_OCCURRENCE,ev_info);
+  //==================================================== Sweep trace
+  // Angleset executions are only recorded when the trace is enabled.
+  // Recording writes a fixed size record into a preallocated buffer.
+  const bool tracing = sweep_trace.IsEnabled();
+  if (tracing) sweep_trace.BeginSweep();
+
+  //==================================================== Threaded execution
+  // When worker threads are available the sweep chunks of ready
+  // anglesets are handed to the workers. The anglesets in flight are
+  // skipped until their chunk has completed, after which the main
+  // thread sends their outgoing psi.
+  const bool threaded = PrepareWorkerChunks(sweep_chunk);
+  std::vector<bool> angleset_in_flight(rule_values.size(), false);
+  size_t num_in_flight = 0;
 
   //==================================================== Loop till done
+  // A pass that executes nothing only polls for messages. The main
+  // thread then waits for the workers, or yields, before polling again.
   bool finished = false;
-  size_t scheduled_angleset = 0;
   while (!finished)
   {
     finished = true;
+    bool progressed = false;
     for (size_t as=0; as<rule_values.size(); as++)
     {
       auto angleset = rule_values[as].angle_set;
       int angset_number = rule_values[as].set_index;
 
+      if (angleset_in_flight[as]) {finished = false; continue;}
+
       //=============================== Query angleset status
       // Status will here be one of the following:
       //  - RECEIVING.
@@ -155,19 +158,21 @@ void chi_mesh::sweep_management::SweepScheduler::
                         ExePerm::NO_EXEC_IF_READY);
 
       //=============================== Execute if ready and allowed
-      // If this angleset is the one scheduled to run
-      // and it is ready then it will be given permission
-      if (status == Status::READY_TO_EXECUTE /*and as == scheduled_angleset*/)
+      // If this angleset is ready then it will be given permission
+      if (status == Status::READY_TO_EXECUTE)
       {
-        std::stringstream message_i;
-        message_i
-          << "Angleset " << angset_number
-          << " executed on location " << chi_mpi.location_id;
-
-        auto ev_info_i = std::make_shared<ChiLog::EventInfo>(message_i.str());
+        if (threaded)
+        {
+          angleset->BeginExecution();
+          angleset_in_flight[as] = true;
+          ++num_in_flight;
+          SubmitWorkerTask(as);
+          finished = false;
+          progressed = true;
+          continue;
+        }
 
-        chi_log.LogEvent(sweep_event_tag,
-                         ChiLog::EventType::SINGLE_OCCURRENCE,ev_info_i);
+        const double begin_time = tracing? chi_program_timer.GetTime() : 0.0;
 
         status = angleset->
           AngleSetAdvance(sweep_chunk,
@@ -175,23 +180,47 @@ void chi_mesh::sweep_management::SweepScheduler::
                           sweep_timing_events_tag,
                           ExePerm::EXECUTE);
 
-        std::stringstream message_f;
-        message_f
-          << "Angleset " << angset_number
-          << " finished on location " << chi_mpi.location_id;
-
-        auto ev_info_f = std::make_shared<ChiLog::EventInfo>(message_f.str());
+        if (tracing)
+          sweep_trace.Add(angset_number, begin_time,
+                          chi_program_timer.GetTime());
 
-        chi_log.LogEvent(sweep_event_tag,
-                         ChiLog::EventType::SINGLE_OCCURRENCE,ev_info_f);
-
-        scheduled_angleset++; //Schedule the next angleset
+        progressed = true;
       }
 
       if (status != Status::FINISHED)
         finished = false;
     }//for each angleset rule
+
+    //=============================== Complete anglesets executed by workers
+    if (threaded)
+    {
+      for (size_t as : CollectCompletedWorkerTasks())
+      {
+        auto angleset = rule_values[as].angle_set;
+        int angset_number = rule_values[as].set_index;
+
+        angleset->EndExecution(angset_number);
+        angleset_in_flight[as] = false;
+        --num_in_flight;
+        progressed = true;
+
+        if (tracing)
+          sweep_trace.Add(angset_number,
+                          worker_task_times[as].first,
+                          worker_task_times[as].second);
+      }
+    }
+
+    //=============================== Back off when idle
+    if (not finished and not progressed)
+    {
+      if (num_in_flight > 0) WaitForWorkerTasks();
+      else                   std::this_thread::yield();
+    }
   }//while not finished
+
+  if (threaded)
+    ReduceWorkerPhi(sweep_chunk);
 //  }
 
   //================================================== Receive delayed data
@@ -0,0 +1,169 @@
+#include "sweepscheduler.h"
+
+#include <chi_log.h>
+#include "ChiTimer/chi_timer.h"
+
+extern ChiLog& chi_log;
+extern ChiTimer chi_program_timer;
+
+#include <chrono>
+
+//###################################################################
+/**Creates one worker chunk per thread and starts the worker threads.
+ * If the sweep chunk cannot make worker chunks the scheduler stays
+ * serial.*/
+void chi_mesh::sweep_management::SweepScheduler::InitializeWorkerThreads()
+{
+  //=================================== Create worker chunks
+  // The worker chunks hold references to the elements of worker_phi,
+  // it may therefore not be resized after this point.
+  worker_phi.resize(num_threads);
+  worker_task_times.resize(rule_values.size(), {0.0,0.0});
+  for (auto& phi : worker_phi)
+  {
+    auto worker_chunk = sweep_chunk.MakeWorkerChunk(phi);
+    if (not worker_chunk)
+    {
+      chi_log.Log(LOG_0WARNING)
+        << "SweepScheduler: The sweep chunk does not support threaded "
+        << "execution. Sweeps will be executed serially.";
+      worker_chunks.clear();
+      return;
+    }
+    worker_chunks.push_back(worker_chunk);
+  }
+
+  //=================================== Start the workers
+  for (size_t w=0; w<worker_chunks.size(); ++w)
+    worker_threads.emplace_back(&SweepScheduler::WorkerThreadLoop, this, w);
+
+  chi_log.Log(LOG_0VERBOSE_1)
+    << "SweepScheduler: Started " << worker_threads.size()
+    << " sweep worker threads per location.";
+}
+
+//###################################################################
+/**Work loop of a single worker thread. Workers only execute sweep
+ * chunks, all communication and logging remains on the main thread.*/
+void chi_mesh::sweep_management::SweepScheduler::
+  WorkerThreadLoop(size_t worker_id)
+{
+  auto& worker_chunk = *worker_chunks[worker_id];
+
+  while (true)
+  {
+    size_t rule_index;
+    {
+      std::unique_lock<std::mutex> lock(worker_mutex);
+      worker_cv.wait(lock, [this]()
+        {return worker_shutdown or (not worker_task_queue.empty());});
+
+      if (worker_task_queue.empty()) return; //shutdown
+
+      rule_index = worker_task_queue.front();
+      worker_task_queue.pop_front();
+    }
+
+    const double begin_time = chi_program_timer.GetTime();
+    worker_chunk.Sweep(rule_values[rule_index].angle_set.get());
+    const double end_time = chi_program_timer.GetTime();
+
+    {
+      std::lock_guard<std::mutex> lock(worker_mutex);
+      worker_task_times[rule_index] = {begin_time, end_time};
+      worker_completed_tasks.push_back(rule_index);
+    }
+    worker_done_cv.notify_one();
+  }
+}
+
+//###################################################################
+/**Synchronizes the worker chunks with the main sweep chunk and zeroes
+ * their flux moments. Returns false when the sweep must be executed
+ * serially, i.e. when there are no workers or when moment callbacks,
+ * which only the main chunk knows about, are registered.*/
+bool chi_mesh::sweep_management::SweepScheduler::
+  PrepareWorkerChunks(SweepChunk& sweep_chunk)
+{
+  if (worker_chunks.empty()) return false;
+  if (not sweep_chunk.moment_callbacks.empty()) return false;
+
+  const size_t num_phi_dofs = sweep_chunk.GetDestinationPhi().size();
+  for (size_t w=0; w<worker_chunks.size(); ++w)
+  {
+    worker_phi[w].assign(num_phi_dofs, 0.0);
+    worker_chunks[w]->SetDestinationPsi(sweep_chunk.GetDestinationPsi());
+    worker_chunks[w]->
+      SetSurfaceSourceActiveFlag(sweep_chunk.IsSurfaceSourceActive());
+  }
+
+  return true;
+}
+
+//###################################################################
+/**Queues the angle set of the given rule for execution by the next
+ * available worker.*/
+void chi_mesh::sweep_management::SweepScheduler::
+  SubmitWorkerTask(size_t rule_index)
+{
+  {
+    std::lock_guard<std::mutex> lock(worker_mutex);
+    worker_task_queue.push_back(rule_index);
+  }
+  worker_cv.notify_one();
+}
+
+//###################################################################
+/**Returns, without blocking, the rule indices of the angle sets whose
+ * sweep chunks have completed since the previous call.*/
+std::vector<size_t> chi_mesh::sweep_management::SweepScheduler::
+  CollectCompletedWorkerTasks()
+{
+  std::vector<size_t> completed_tasks;
+  {
+    std::lock_guard<std::mutex> lock(worker_mutex);
+    completed_tasks.swap(worker_completed_tasks);
+  }
+  return completed_tasks;
+}
+
+//###################################################################
+/**Blocks the main thread until a worker completes a task, or for at
+ * most a short interval. The main thread calls this when it has nothing
+ * to do, so that it does not compete with the workers for cores. The
+ * interval bounds the delay before incoming messages are progressed.*/
+void chi_mesh::sweep_management::SweepScheduler::WaitForWorkerTasks()
+{
+  std::unique_lock<std::mutex> lock(worker_mutex);
+  worker_done_cv.wait_for(lock, std::chrono::microseconds(50),
+    [this]() {return not worker_completed_tasks.empty();});
+}
+
+//###################################################################
+/**Adds the flux moments accumulated by the workers to the destination
+ * of the main sweep chunk.*/
+void chi_mesh::sweep_management::SweepScheduler::
+  ReduceWorkerPhi(SweepChunk& sweep_chunk)
+{
+  auto& destination_phi = sweep_chunk.GetDestinationPhi();
+  const size_t num_phi_dofs = destination_phi.size();
+
+  for (const auto& phi : worker_phi)
+    for (size_t i=0; i<num_phi_dofs; ++i)
+      destination_phi[i] += phi[i];
+}
+
+//###################################################################
+/**Signals the worker threads to stop and joins them.*/
+void chi_mesh::sweep_management::SweepScheduler::FinalizeWorkerThreads()
+{
+  {
+    std::lock_guard<std::mutex> lock(worker_mutex);
+    worker_shutdown = true;
+  }
+  worker_cv.notify_all();
+
+  for (auto& worker : worker_threads)
+    worker.join();
+  worker_threads.clear();
+}
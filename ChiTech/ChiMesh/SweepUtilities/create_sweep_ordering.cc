@@ -19,12 +19,15 @@ extern ChiTimer   chi_program_timer;
 
 //###################################################################
 /**Develops a sweep ordering for a given angle for locally owned
- * cells.*/
+ * cells. With distributed_tdg_flag the sweep plane of each location is
+ * determined from neighbor exchanges instead of from the global task
+ * dependency graph, see SPDS::BuildDistributedTaskDependencyGraph.*/
 std::shared_ptr<chi_mesh::sweep_management::SPDS>
 chi_mesh::sweep_management::
   CreateSweepOrder(const chi_mesh::Vector3& omega,
                    chi_mesh::MeshContinuumPtr grid,
-                   bool cycle_allowance_flag)
+                   bool cycle_allowance_flag,
+                   bool distributed_tdg_flag)
 {
   auto sweep_order  = std::make_shared<chi_mesh::sweep_management::SPDS>();
   sweep_order->grid = grid;
@@ -96,6 +99,22 @@ chi_mesh::sweep_management::
     exit(EXIT_FAILURE);
   }
 
+  //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% Distributed task
+  //                                                        dependency graph
+  //Only exchanges sweep planes with neighboring locations. Returns false
+  //if cycles need to be removed, which requires the global graph.
+  if (distributed_tdg_flag and
+      sweep_order->BuildDistributedTaskDependencyGraph(cycle_allowance_flag))
+  {
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    chi_log.Log(LOG_0VERBOSE_1)
+      << chi_program_timer.GetTimeString()
+      << " Done computing sweep ordering.\n\n";
+
+    return sweep_order;
+  }
+
   //%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%% Create Task
   //                                                        Dependency Graphs
   //All locations will gather other locations' dependencies
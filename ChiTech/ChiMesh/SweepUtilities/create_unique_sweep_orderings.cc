@@ -0,0 +1,374 @@
+#include "sweep_namespace.h"
+
+#include "ChiMesh/MeshContinuum/chi_meshcontinuum.h"
+#include "ChiMesh/SweepUtilities/SPDS/SPDS.h"
+
+#include "chi_mpi.h"
+#include "chi_log.h"
+#include "ChiTimer/chi_timer.h"
+
+extern ChiMPI& chi_mpi;
+extern ChiLog& chi_log;
+extern ChiTimer chi_program_timer;
+
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+
+namespace
+{
+const char SPDS_CACHE_MAGIC[8] = {'C','H','I','S','P','D','S','2'};
+
+//###################################################################
+/**FNV-1a hash of a sequence of 64-bit words.*/
+uint64_t HashWords(const uint64_t* words, size_t num_words,
+                   uint64_t hash = 14695981039346656037ULL)
+{
+  for (size_t k=0; k<num_words; ++k)
+  {
+    uint64_t w = words[k];
+    for (int b=0; b<8; ++b)
+    {
+      hash ^= (w & 0xFFULL);
+      hash *= 1099511628211ULL;
+      w >>= 8;
+    }
+  }
+  return hash;
+}
+
+//###################################################################
+/**Hash of the local connectivity of the grid, used to invalidate
+ * cached sweep orderings when the mesh or its partitioning changes.*/
+uint64_t HashLocalConnectivity(chi_mesh::MeshContinuumPtr grid)
+{
+  std::vector<uint64_t> cell_global_ids;
+  std::vector<uint64_t> cell_num_faces;
+  std::vector<uint64_t> face_neighbor_ids;
+  std::vector<uint64_t> face_neighbor_partition_ids;
+  for (const auto& cell : grid->local_cells)
+  {
+    cell_global_ids.push_back(cell.global_id);
+    cell_num_faces.push_back(cell.faces.size());
+    for (const auto& face : cell.faces)
+    {
+      face_neighbor_ids.push_back(face.neighbor_id);
+      face_neighbor_partition_ids.push_back(
+        static_cast<uint64_t>(face.GetNeighborPartitionID(*grid)));
+    }
+  }
+
+  uint64_t header[] = {static_cast<uint64_t>(chi_mpi.process_count),
+                       static_cast<uint64_t>(chi_mpi.location_id),
+                       cell_global_ids.size(),
+                       face_neighbor_ids.size()};
+  uint64_t hash = HashWords(header, 4);
+
+  hash = HashWords(cell_global_ids.data(), cell_global_ids.size(), hash);
+  hash = HashWords(cell_num_faces.data(), cell_num_faces.size(), hash);
+  hash = HashWords(face_neighbor_ids.data(), face_neighbor_ids.size(), hash);
+  hash = HashWords(face_neighbor_partition_ids.data(),
+                   face_neighbor_partition_ids.size(), hash);
+
+  return hash;
+}
+
+//###################################################################
+template<typename T>
+void WriteVector(std::ofstream& file, const std::vector<T>& v)
+{
+  uint64_t size = v.size();
+  file.write((char*)&size, sizeof(uint64_t));
+  file.write((char*)v.data(), static_cast<std::streamsize>(size*sizeof(T)));
+}
+
+//###################################################################
+template<typename T>
+bool ReadVector(std::ifstream& file, std::vector<T>& v)
+{
+  uint64_t size = 0;
+  file.read((char*)&size, sizeof(uint64_t));
+  if (not file or size > (1ULL << 40)) return false;
+  v.resize(size);
+  file.read((char*)v.data(), static_cast<std::streamsize>(size*sizeof(T)));
+  return static_cast<bool>(file);
+}
+
+//###################################################################
+/**Writes the location-local part of a sweep ordering.*/
+void WriteSPDS(std::ofstream& file,
+               const chi_mesh::sweep_management::SPDS& spds)
+{
+  file.write((char*)&spds.omega.x, sizeof(double));
+  file.write((char*)&spds.omega.y, sizeof(double));
+  file.write((char*)&spds.omega.z, sizeof(double));
+
+  WriteVector(file, spds.spls.item_id);
+
+  uint64_t num_planes = spds.global_sweep_planes.size();
+  file.write((char*)&num_planes, sizeof(uint64_t));
+  for (const auto& stdg : spds.global_sweep_planes)
+    WriteVector(file, stdg.item_id);
+
+  WriteVector(file, spds.location_dependencies);
+  WriteVector(file, spds.location_successors);
+  WriteVector(file, spds.delayed_location_dependencies);
+  WriteVector(file, spds.delayed_location_successors);
+  WriteVector(file, spds.local_cyclic_dependencies);
+
+  file.write((char*)&spds.location_sweep_plane, sizeof(int));
+  file.write((char*)&spds.num_global_sweep_planes, sizeof(int));
+
+  uint64_t num_locations = spds.global_dependencies.size();
+  file.write((char*)&num_locations, sizeof(uint64_t));
+  for (const auto& deps : spds.global_dependencies)
+    WriteVector(file, deps);
+}
+
+//###################################################################
+/**Reads a sweep ordering written by WriteSPDS.*/
+bool ReadSPDS(std::ifstream& file,
+              chi_mesh::sweep_management::SPDS& spds)
+{
+  file.read((char*)&spds.omega.x, sizeof(double));
+  file.read((char*)&spds.omega.y, sizeof(double));
+  file.read((char*)&spds.omega.z, sizeof(double));
+
+  if (not ReadVector(file, spds.spls.item_id)) return false;
+
+  uint64_t num_planes = 0;
+  file.read((char*)&num_planes, sizeof(uint64_t));
+  if (not file or num_planes > (1ULL << 32)) return false;
+  spds.global_sweep_planes.resize(num_planes);
+  for (auto& stdg : spds.global_sweep_planes)
+    if (not ReadVector(file, stdg.item_id)) return false;
+
+  if (not ReadVector(file, spds.location_dependencies)) return false;
+  if (not ReadVector(file, spds.location_successors)) return false;
+  if (not ReadVector(file, spds.delayed_location_dependencies)) return false;
+  if (not ReadVector(file, spds.delayed_location_successors)) return false;
+  if (not ReadVector(file, spds.local_cyclic_dependencies)) return false;
+
+  file.read((char*)&spds.location_sweep_plane, sizeof(int));
+  file.read((char*)&spds.num_global_sweep_planes, sizeof(int));
+
+  //Orderings built with the distributed task dependency graph do not
+  //store the global dependencies
+  uint64_t num_locations = 0;
+  file.read((char*)&num_locations, sizeof(uint64_t));
+  if (not file or
+      (num_locations != 0 and
+       num_locations != static_cast<uint64_t>(chi_mpi.process_count)))
+    return false;
+  spds.global_dependencies.resize(num_locations);
+  for (auto& deps : spds.global_dependencies)
+    if (not ReadVector(file, deps)) return false;
+
+  return true;
+}
+}//namespace
+
+//###################################################################
+/**Computes a signature that fully determines the sweep ordering of a
+ * direction on the local cells. Every local face is classified as
+ * outgoing, incoming or parallel with the same tolerance used by
+ * PopulateCellRelationships and the FLUDS, 2 bits per face. The first
+ * word holds the octant of omega, which the sweep schedulers use to
+ * prioritize angle sets.
+ *
+ * Two directions with equal signatures on all locations have identical
+ * cell and location dependency graphs and can share SPDS and FLUDS.*/
+std::vector<uint64_t> chi_mesh::sweep_management::
+  ComputeSweepOrderSignature(const chi_mesh::Vector3& omega,
+                             chi_mesh::MeshContinuumPtr grid)
+{
+  const double tolerance = 1.0e-16;
+
+  size_t num_faces = 0;
+  for (const auto& cell : grid->local_cells)
+    num_faces += cell.faces.size();
+
+  std::vector<uint64_t> signature(1 + (num_faces + 31)/32, 0);
+
+  signature[0] = ((omega.x >= 0.0)? 1 : 0) |
+                 ((omega.y >= 0.0)? 2 : 0) |
+                 ((omega.z >= 0.0)? 4 : 0);
+
+  size_t f = 0;
+  for (const auto& cell : grid->local_cells)
+    for (const auto& face : cell.faces)
+    {
+      const double mu = omega.Dot(face.normal);
+
+      uint64_t orientation = 0;                       //parallel
+      if      (mu > (0.0+tolerance)) orientation = 1; //outgoing
+      else if (mu < (0.0-tolerance)) orientation = 2; //incoming
+
+      signature[1 + f/32] |= orientation << (2*(f%32));
+      ++f;
+    }
+
+  return signature;
+}
+
+//###################################################################
+/**Develops the sweep orderings for a list of directions, building only
+ * one SPDS per distinct dependency structure. The returned vector holds
+ * one entry per direction; directions with the same sweep order
+ * signature (see ComputeSweepOrderSignature) on all locations share the
+ * same SPDS, whose omega is the first such direction.
+ *
+ * When cycles are allowed, the local cycles of a shared ordering are
+ * broken using the edge weights of its first direction. The ordering
+ * remains valid for the other directions, it only lags different
+ * edges than a freshly built one would.
+ *
+ * If cache_file_name is not empty, orderings previously written to the
+ * location's cache file are reused when the mesh connectivity and the
+ * signature match, and the file is rewritten when new orderings were
+ * built. The cache is only used if it is valid on all locations.*/
+std::vector<std::shared_ptr<chi_mesh::sweep_management::SPDS>>
+chi_mesh::sweep_management::
+  CreateUniqueSweepOrders(const std::vector<chi_mesh::Vector3>& omegas,
+                          chi_mesh::MeshContinuumPtr grid,
+                          bool cycle_allowance_flag,
+                          bool distributed_tdg_flag,
+                          const std::string& cache_file_name)
+{
+  std::vector<std::shared_ptr<SPDS>> unique_orders;
+  std::vector<std::vector<uint64_t>> unique_signatures;
+  std::vector<uint64_t>              unique_hashes;
+
+  const uint64_t mesh_hash = HashLocalConnectivity(grid);
+  const uint64_t cycle_flag = cycle_allowance_flag? 1 : 0;
+
+  //============================================= Read cache
+  size_t num_cached = 0;
+  if (not cache_file_name.empty())
+  {
+    bool location_succeeded = false;
+    std::ifstream file(cache_file_name, std::ios::in | std::ios::binary);
+    if (file.is_open())
+    {
+      char magic[8];
+      uint64_t file_mesh_hash = 0, file_cycle_flag = 0, num_entries = 0;
+      file.read(magic, 8);
+      file.read((char*)&file_mesh_hash, sizeof(uint64_t));
+      file.read((char*)&file_cycle_flag, sizeof(uint64_t));
+      file.read((char*)&num_entries, sizeof(uint64_t));
+
+      location_succeeded = file and
+                           std::memcmp(magic, SPDS_CACHE_MAGIC, 8) == 0 and
+                           file_mesh_hash == mesh_hash and
+                           file_cycle_flag == cycle_flag;
+
+      for (uint64_t e=0; e<num_entries and location_succeeded; ++e)
+      {
+        std::vector<uint64_t> signature;
+        auto spds = std::make_shared<SPDS>();
+        spds->grid = grid;
+
+        location_succeeded = ReadVector(file, signature) and
+                             ReadSPDS(file, *spds);
+
+        unique_hashes.push_back(HashWords(signature.data(),signature.size()));
+        unique_signatures.push_back(std::move(signature));
+        unique_orders.push_back(spds);
+      }
+      file.close();
+    }
+
+    //Entries are matched by index across locations, so every location
+    //must have read the same number of entries
+    int local_num = location_succeeded? static_cast<int>(unique_orders.size()) : -1;
+    int min_num = 0, max_num = 0;
+    MPI_Allreduce(&local_num, &min_num, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+    MPI_Allreduce(&local_num, &max_num, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+
+    if (min_num < 0 or min_num != max_num)
+    {
+      unique_orders.clear();
+      unique_signatures.clear();
+      unique_hashes.clear();
+    }
+    num_cached = unique_orders.size();
+
+    chi_log.Log(LOG_0VERBOSE_1)
+      << chi_program_timer.GetTimeString()
+      << " Read " << num_cached << " cached sweep orderings from "
+      << cache_file_name << " (location 0).";
+  }
+
+  //============================================= Build or reuse orderings
+  std::vector<std::shared_ptr<SPDS>> sweep_orders;
+  sweep_orders.reserve(omegas.size());
+  for (const auto& omega : omegas)
+  {
+    auto signature = ComputeSweepOrderSignature(omega, grid);
+    uint64_t hash = HashWords(signature.data(), signature.size());
+
+    //Since CreateSweepOrder is collective, an ordering is only reused if
+    //it matches on all locations
+    const size_t num_unique = unique_orders.size();
+    std::vector<int> local_match(num_unique, 0);
+    for (size_t u=0; u<num_unique; ++u)
+      local_match[u] = (unique_hashes[u] == hash and
+                        unique_signatures[u] == signature)? 1 : 0;
+
+    std::vector<int> global_match(num_unique, 0);
+    if (num_unique > 0)
+      MPI_Allreduce(local_match.data(), global_match.data(),
+                    static_cast<int>(num_unique),
+                    MPI_INT, MPI_LAND, MPI_COMM_WORLD);
+
+    auto match = std::find(global_match.begin(), global_match.end(), 1);
+    if (match != global_match.end())
+    {
+      sweep_orders.push_back(unique_orders[match - global_match.begin()]);
+      continue;
+    }
+
+    auto new_swp_order = CreateSweepOrder(omega, grid,
+                                          cycle_allowance_flag,
+                                          distributed_tdg_flag);
+
+    unique_orders.push_back(new_swp_order);
+    unique_signatures.push_back(std::move(signature));
+    unique_hashes.push_back(hash);
+    sweep_orders.push_back(new_swp_order);
+  }
+
+  chi_log.Log(LOG_0VERBOSE_1)
+    << chi_program_timer.GetTimeString()
+    << " " << unique_orders.size() - num_cached << " sweep orderings built, "
+    << num_cached << " read from cache, for " << omegas.size()
+    << " directions.";
+
+  //============================================= Write cache
+  if (not cache_file_name.empty() and unique_orders.size() > num_cached)
+  {
+    std::ofstream file(cache_file_name,
+                       std::ios::out | std::ios::binary | std::ios::trunc);
+    if (not file.is_open())
+    {
+      chi_log.Log(LOG_ALLWARNING)
+        << "Failed to write sweep ordering cache file: " << cache_file_name;
+      return sweep_orders;
+    }
+
+    uint64_t num_entries = unique_orders.size();
+    file.write(SPDS_CACHE_MAGIC, 8);
+    file.write((char*)&mesh_hash, sizeof(uint64_t));
+    file.write((char*)&cycle_flag, sizeof(uint64_t));
+    file.write((char*)&num_entries, sizeof(uint64_t));
+
+    for (size_t u=0; u<unique_orders.size(); ++u)
+    {
+      WriteVector(file, unique_signatures[u]);
+      WriteSPDS(file, *unique_orders[u]);
+    }
+    file.close();
+  }
+
+  return sweep_orders;
+}
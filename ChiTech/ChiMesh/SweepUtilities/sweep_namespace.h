@@ -3,6 +3,8 @@
 
 #include "../chi_mesh.h"
 #include <set>
+#include <string>
+#include <cstdint>
 
 #include <memory>
 
@@ -30,6 +32,7 @@ namespace sweep_management
   class SweepChunk;
 
   class SweepScheduler;
+  class SweepTrace;
 
   void PopulateCellRelationships(
     chi_mesh::MeshContinuumPtr grid,
@@ -52,7 +55,19 @@ namespace sweep_management
 
   std::shared_ptr<SPDS> CreateSweepOrder(const chi_mesh::Vector3& omega,
                                          chi_mesh::MeshContinuumPtr grid,
-                                         bool cycle_allowance_flag=false);
+                                         bool cycle_allowance_flag=false,
+                                         bool distributed_tdg_flag=false);
+
+  std::vector<uint64_t>
+  ComputeSweepOrderSignature(const chi_mesh::Vector3& omega,
+                             chi_mesh::MeshContinuumPtr grid);
+
+  std::vector<std::shared_ptr<SPDS>>
+  CreateUniqueSweepOrders(const std::vector<chi_mesh::Vector3>& omegas,
+                          chi_mesh::MeshContinuumPtr grid,
+                          bool cycle_allowance_flag=false,
+                          bool distributed_tdg_flag=false,
+                          const std::string& cache_file_name="");
 
   void PrintSweepOrdering(SPDS* sweep_order,
                           MeshContinuumPtr vol_continuum);
@@ -4,6 +4,7 @@
 #include "ChiMesh/SweepUtilities/AngleAggregation/angleaggregation.h"
 
 #include <functional>
+#include <memory>
 
 //###################################################################
 /**Sweep work function*/
@@ -119,6 +120,15 @@ public:
   /**Sweep chunks should override this.*/
   virtual void Sweep(AngleSet* angle_set)
   {}
+
+  /**Creates a copy of this chunk, with its own scratch storage, that
+   * accumulates flux moments into the given vector. Threaded sweep
+   * schedulers use these copies to execute independent angle sets
+   * concurrently. Sweep chunks that cannot be executed concurrently
+   * return nullptr, which makes the scheduler sweep serially.*/
+  virtual std::shared_ptr<SweepChunk>
+    MakeWorkerChunk(std::vector<double>& worker_destination_phi)
+  {return nullptr;}
 };
 
 #endif //CHI_SWEEPCHUNK_BASE_H
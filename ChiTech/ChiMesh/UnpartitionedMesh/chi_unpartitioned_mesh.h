@@ -6,6 +6,8 @@
 
 #include <vtkCell.h>
 
+#include <unordered_map>
+
 //###################################################################
 /**This object is intented for unpartitioned meshes that still require
  * partitioning.*/
@@ -45,6 +47,17 @@ public:
   std::vector<LightWeightCell*>    raw_boundary_cells;
   std::vector<std::set<uint64_t>>  vertex_cell_subscriptions;
 
+  //Meshes read with ParallelMethod::DIVIDE_WORK only hold a chunk of
+  //the cells on each location. The global id of each raw cell is then
+  //stored explicitly and only the vertices of the local cells are kept.
+  bool                                          distributed = false;
+  bool                                          redistributed = false;
+  std::vector<uint64_t>                         raw_cell_global_ids;
+  std::vector<int64_t>                          raw_cell_partition_ids;
+  std::unordered_map<uint64_t,chi_mesh::Vertex> local_vertices;
+  uint64_t                                      num_global_cells = 0;
+  uint64_t                                      num_global_vertices = 0;
+
 public:
   enum class ParallelMethod
   {
@@ -79,9 +92,18 @@ public:
 
   static LightWeightCell* CreateCellFromVTKVertex(vtkCell* vtk_cell);
 
+  /**Returns the vertex with the given global id.*/
+  const chi_mesh::Vertex& GetVertex(uint64_t vid) const
+  {
+    return distributed? local_vertices.at(vid) : vertices[vid];
+  }
+
   void BuildMeshConnectivity();
   void ComputeCentroidsAndCheckQuality();
 
+  void BuildDistributedMeshConnectivity();
+  void RedistributeCells(const std::vector<int64_t>& cell_partition_ids);
+
   void ReadFromVTU(const Options& options);
   void ReadFromEnsightGold(const Options& options);
   void ReadFromWavefrontOBJ(const Options& options);
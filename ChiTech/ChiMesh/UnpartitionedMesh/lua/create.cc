@@ -260,6 +260,10 @@ int chiUnpartitionedMeshFromWavefrontOBJ(lua_State* L)
 /**Creates an unpartitioned mesh from a .msh file.
 
 \param file_name char Filename of the .msh file.
+\param divide_work bool Optional. If true, every location only reads a
+                   chunk of the elements and the nodes it needs, instead of
+                   every location loading the entire mesh. The partitioner
+                   then redistributes the cells. Default: false.
 
 \ingroup LuaUnpartitionedMesh
 
@@ -300,6 +304,10 @@ int chiUnpartitionedMeshFromMshFormat(lua_State* L)
   chi_mesh::UnpartitionedMesh::Options options;
   options.file_name = std::string(temp);
 
+  if (num_args >= 2 and lua_toboolean(L,2))
+    options.parallel_method =
+      chi_mesh::UnpartitionedMesh::ParallelMethod::DIVIDE_WORK;
+
   new_object->ReadFromMsh(options);
 
   auto handler = chi_mesh::GetCurrentHandler();
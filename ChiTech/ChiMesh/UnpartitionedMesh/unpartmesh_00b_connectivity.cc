@@ -1,4 +1,5 @@
 #include "chi_unpartitioned_mesh.h"
+#include "unpartmesh_facekey.h"
 
 #include "chi_log.h"
 extern ChiLog& chi_log;
@@ -8,8 +9,82 @@ extern ChiTimer chi_program_timer;
 
 #include "chi_mpi.h"
 
+#include <unordered_map>
+#include <algorithm>
+#include <thread>
+
+namespace
+{
+using chi_mesh::unpartitioned_mesh_utils::FaceKey;
+using chi_mesh::unpartitioned_mesh_utils::FaceKeyHash;
+
+/**Face of a raw cell together with its key.*/
+struct FaceRef
+{
+  uint64_t cell_id;
+  uint32_t face_id;
+  FaceKey  key;
+};
+
+/**First face found for a key, and the number of faces sharing it.*/
+struct FaceEntry
+{
+  uint64_t cell_id;
+  uint32_t face_id;
+  uint32_t count;
+};
+
+//###################################################################
+/**Number of threads used to build the connectivity. The hardware
+ * threads of a node are divided over the locations on that node.*/
+size_t ConnectivityThreadCount()
+{
+  MPI_Comm node_comm;
+  MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0,
+                      MPI_INFO_NULL, &node_comm);
+  int locations_on_node = 1;
+  MPI_Comm_size(node_comm, &locations_on_node);
+  MPI_Comm_free(&node_comm);
+
+  const size_t hardware_threads = std::thread::hardware_concurrency();
+
+  return std::max<size_t>(1, hardware_threads/
+                             std::max(1, locations_on_node));
+}
+
+//###################################################################
+/**Splits [0,n) into num_threads contiguous ranges and calls
+ * func(thread_index, begin, end) for each on its own thread.*/
+template<typename Function>
+void ParallelFor(size_t num_threads, size_t n, Function&& func)
+{
+  if (num_threads <= 1)
+  {
+    func(0, 0, n);
+    return;
+  }
+
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads);
+  for (size_t t=0; t<num_threads; ++t)
+  {
+    const size_t begin = (n*t)/num_threads;
+    const size_t end   = (n*(t+1))/num_threads;
+    threads.emplace_back([&func, t, begin, end]() {func(t, begin, end);});
+  }
+  for (auto& thread : threads) thread.join();
+}
+}//namespace
+
 //###################################################################
-/**Establishes neighbor connectivity for the light-weight mesh.*/
+/**Establishes neighbor connectivity for the light-weight mesh.
+ *
+ * Every unconnected face is keyed by its sorted vertex ids and faces
+ * with equal keys are paired in a hash table, which takes linear time
+ * in the number of faces. The table is sharded by hash so that the
+ * keying and the pairing both run multithreaded. Faces whose key is
+ * shared by more than two cells are non-manifold; these are reported
+ * and only the first two faces of each are connected.*/
 void chi_mesh::UnpartitionedMesh::BuildMeshConnectivity()
 {
   const size_t num_raw_cells = raw_cells.size();
@@ -28,8 +103,7 @@ void chi_mesh::UnpartitionedMesh::BuildMeshConnectivity()
   chi_log.Log() << chi_program_timer.GetTimeString()
                 << " Establishing cell connectivity.";
 
-  //======================================== Establish internal connectivity
-  // Populate vertex subscriptions to internal cells
+  //======================================== Populate vertex subscriptions
   vertex_cell_subscriptions.resize(num_raw_vertices);
   {
     uint64_t cur_cell_id=0;
@@ -44,118 +118,129 @@ void chi_mesh::UnpartitionedMesh::BuildMeshConnectivity()
   chi_log.Log() << chi_program_timer.GetTimeString()
                 << " Vertex cell subscriptions complete.";
 
-  // Process raw cells
-  {
-    uint64_t aux_counter = 0;
-    uint64_t cur_cell_id=0;
-    for (auto& cell : raw_cells)
+  //======================================== Key unconnected faces
+  // Each thread keys the faces of a range of cells and buckets them
+  // by the shard of the hash table that will pair them.
+  const size_t num_threads = ConnectivityThreadCount();
+  const size_t num_shards  = num_threads;
+
+  std::vector<std::vector<std::vector<FaceRef>>>
+    buckets(num_threads, std::vector<std::vector<FaceRef>>(num_shards));
+
+  ParallelFor(num_threads, num_raw_cells,
+    [this,&buckets,num_shards](size_t t, size_t c_begin, size_t c_end)
     {
-      for (auto& cur_cell_face : cell->faces)
+      for (size_t c=c_begin; c<c_end; ++c)
       {
-        if (cur_cell_face.has_neighbor) {continue;}
-        const std::set<uint64_t> cfvids(cur_cell_face.vertex_ids.begin(),
-                                        cur_cell_face.vertex_ids.end());
+        const auto& faces = raw_cells[c]->faces;
+        for (uint32_t f=0; f<faces.size(); ++f)
+        {
+          if (faces[f].has_neighbor) continue;
 
-        std::set<size_t> cells_to_search;
-        for (uint64_t vid : cfvids)
-          for (uint64_t cell_id : vertex_cell_subscriptions.at(vid))
-            if (cell_id != cur_cell_id)
-              cells_to_search.insert(cell_id);
+          FaceRef ref{c, f, FaceKey(faces[f].vertex_ids)};
+          buckets[t][ref.key.hash % num_shards].push_back(std::move(ref));
+        }
+      }
+    });
 
-        for (uint64_t adj_cell_id : cells_to_search)
-        {
-          auto adj_cell = raw_cells.at(adj_cell_id);
+  chi_log.Log() << chi_program_timer.GetTimeString()
+                << " Face keys complete.";
+
+  //======================================== Pair faces
+  // Faces are only ever paired within one shard, hence every face is
+  // written by a single thread.
+  std::vector<size_t> shard_num_unmatched(num_shards, 0);
+  std::vector<size_t> shard_num_nonmanifold(num_shards, 0);
+
+  ParallelFor(num_threads, num_shards,
+    [this,&buckets,&shard_num_unmatched,&shard_num_nonmanifold,num_threads]
+    (size_t, size_t s_begin, size_t s_end)
+    {
+      for (size_t s=s_begin; s<s_end; ++s)
+      {
+        size_t shard_size = 0;
+        for (size_t t=0; t<num_threads; ++t)
+          shard_size += buckets[t][s].size();
+
+        std::unordered_map<FaceKey, FaceEntry, FaceKeyHash> face_table;
+        face_table.reserve(shard_size);
 
-          for (auto& adj_cell_face : adj_cell->faces)
+        for (size_t t=0; t<num_threads; ++t)
+          for (auto& ref : buckets[t][s])
           {
-            if (adj_cell_face.has_neighbor) {continue;}
-            const std::set<uint64_t> afvids(adj_cell_face.vertex_ids.begin(),
-                                            adj_cell_face.vertex_ids.end());
+            auto result = face_table.emplace(std::move(ref.key),
+                                             FaceEntry{ref.cell_id,
+                                                       ref.face_id, 1});
+            if (result.second) continue;
 
-            if (cfvids == afvids)
+            auto& entry = result.first->second;
+            if (entry.count == 1)
             {
-              cur_cell_face.neighbor = adj_cell_id;
-              adj_cell_face.neighbor = cur_cell_id;
+              auto& cur_face = raw_cells[ref.cell_id]->faces[ref.face_id];
+              auto& adj_face = raw_cells[entry.cell_id]->faces[entry.face_id];
 
-              cur_cell_face.has_neighbor = true;
-              adj_cell_face.has_neighbor = true;
+              cur_face.neighbor = entry.cell_id;
+              adj_face.neighbor = ref.cell_id;
 
-              goto face_neighbor_found;
+              cur_face.has_neighbor = true;
+              adj_face.has_neighbor = true;
             }
-          }//for adjacent cell face
+            ++entry.count;
+          }
+
+        for (const auto& key_entry : face_table)
+        {
+          if (key_entry.second.count == 1) ++shard_num_unmatched[s];
+          if (key_entry.second.count  > 2) ++shard_num_nonmanifold[s];
         }
-        face_neighbor_found:;
-      }//for face
 
-      ++cur_cell_id;
-      const double fraction_complete = static_cast<double>(cur_cell_id)/
-                                       static_cast<double>(num_raw_cells);
-      if (fraction_complete >= static_cast<double>(aux_counter+1)*0.1)
-      {
-        chi_log.Log() << chi_program_timer.GetTimeString()
-                      << " Surpassing cell " << cur_cell_id
-                      << " of " << num_raw_cells
-                      << " (" << (aux_counter+1)*10 << "%)";
-        ++aux_counter;
+        for (size_t t=0; t<num_threads; ++t)
+          std::vector<FaceRef>().swap(buckets[t][s]);
       }
-    }//for cell
-  }
-
-  chi_log.Log() << chi_program_timer.GetTimeString()
-                << " Establishing cell boundary connectivity.";
+    });
 
-  //======================================== Establish boundary connectivity
-  // Make list of internal cells on the boundary
-  std::vector<LightWeightCell*> internal_cells_on_boundary;
-  for (auto& cell : raw_cells)
+  size_t num_unmatched = 0, num_nonmanifold = 0;
+  for (size_t s=0; s<num_shards; ++s)
   {
-    bool cell_on_boundary = false;
-    for (auto& face : cell->faces)
-      if (not face.has_neighbor)
-      { cell_on_boundary = true; break; }
-
-    if (cell_on_boundary) internal_cells_on_boundary.push_back(cell);
+    num_unmatched   += shard_num_unmatched[s];
+    num_nonmanifold += shard_num_nonmanifold[s];
   }
 
-  // Populate vertex subscriptions to boundary cells
-  std::vector<std::set<uint64_t>> vertex_bndry_cell_subscriptions(vertices.size());
-  {
-    uint64_t cur_cell_id=0;
-    for (auto& cell : raw_boundary_cells)
-    {
-      for (auto vid : cell->vertex_ids)
-        vertex_bndry_cell_subscriptions.at(vid).insert(cur_cell_id);
-      ++cur_cell_id;
-    }
-  }
+  chi_log.Log(LOG_0VERBOSE_1) << chi_program_timer.GetTimeString()
+                              << " Number of unmatched faces: "
+                              << num_unmatched;
 
-  // Process boundary cells
-  for (auto& cell : internal_cells_on_boundary)
-    for (auto& face : cell->faces)
-    {
-      if (face.has_neighbor) continue;
-      std::set<uint64_t> cfvids(face.vertex_ids.begin(),
-                                face.vertex_ids.end());
+  if (num_nonmanifold > 0)
+    chi_log.Log(LOG_0WARNING)
+      << "Mesh connectivity: " << num_nonmanifold << " non-manifold faces "
+      << "shared by more than two cells. Only the first two cells of each "
+      << "are connected.";
 
-      std::set<size_t> cells_to_search;
-      for (uint64_t vid : face.vertex_ids)
-        for (uint64_t cell_id : vertex_bndry_cell_subscriptions[vid])
-          cells_to_search.insert(cell_id);
+  chi_log.Log() << chi_program_timer.GetTimeString()
+                << " Establishing cell boundary connectivity.";
 
-      for (uint64_t adj_cell_id : cells_to_search)
-      {
-        auto& adj_cell = raw_boundary_cells[adj_cell_id];
+  //======================================== Establish boundary connectivity
+  // Faces that remain unconnected get the material id of the boundary
+  // cell with the same vertices.
+  std::unordered_map<FaceKey, int, FaceKeyHash> bndry_cell_table;
+  bndry_cell_table.reserve(raw_boundary_cells.size());
+  for (const auto& cell : raw_boundary_cells)
+    bndry_cell_table.emplace(FaceKey(cell->vertex_ids), cell->material_id);
 
-        std::set<uint64_t> afvids(adj_cell->vertex_ids.begin(),
-                                  adj_cell->vertex_ids.end());
+  if (not bndry_cell_table.empty())
+    ParallelFor(num_threads, num_raw_cells,
+      [this,&bndry_cell_table](size_t, size_t c_begin, size_t c_end)
+      {
+        for (size_t c=c_begin; c<c_end; ++c)
+          for (auto& face : raw_cells[c]->faces)
+          {
+            if (face.has_neighbor) continue;
 
-        if (cfvids == afvids)
-        {
-          face.neighbor = adj_cell->material_id;
-          break;
-        }
-      }//for adj_cell_id
-    }//for face
+            auto bndry_cell = bndry_cell_table.find(FaceKey(face.vertex_ids));
+            if (bndry_cell != bndry_cell_table.end())
+              face.neighbor = bndry_cell->second;
+          }
+      });
 
   num_bndry_faces = 0;
   for (auto cell : raw_cells)
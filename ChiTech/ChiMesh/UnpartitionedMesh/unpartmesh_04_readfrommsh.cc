@@ -4,11 +4,20 @@
 extern ChiLog& chi_log;
 
 #include "chi_mpi.h"
+extern ChiMPI& chi_mpi;
 
+#include <fstream>
 #include <map>
+#include <limits>
+#include <unordered_set>
 
 //###################################################################
-/**Reads an unpartitioned mesh from a gmesh .msh legacy ASCII format 2 file.*/
+/**Reads an unpartitioned mesh from a gmesh .msh legacy ASCII format 2 file.
+ *
+ * With ParallelMethod::DIVIDE_WORK every location only keeps a contiguous
+ * chunk of the volume and boundary elements, and only the nodes used by
+ * them. The material- and boundary-ids are remapped consistently over all
+ * locations and the connectivity is built in a distributed fashion.*/
 void chi_mesh::UnpartitionedMesh::ReadFromMsh(const Options &options)
 {
   const std::string fname = __FUNCTION__;
@@ -29,6 +38,9 @@ void chi_mesh::UnpartitionedMesh::ReadFromMsh(const Options &options)
   MPI_Barrier(MPI_COMM_WORLD);
 
   //===================================================== Declarations
+  const bool divide_work =
+    options.parallel_method == ParallelMethod::DIVIDE_WORK;
+
   std::string file_line;
   std::istringstream iss;
   const std::string node_section_name="$Nodes";
@@ -48,39 +60,6 @@ void chi_mesh::UnpartitionedMesh::ReadFromMsh(const Options &options)
   else if (format != 2.2)
     throw std::logic_error(fname + ": Currently, only msh format 2.2 is supported.");
 
-  //=================================================== Find section with node
-  //                                                    information and then
-  //                                                    read the nodes
-  file.seekg(0);
-  while (std::getline(file, file_line))
-    if ( node_section_name == file_line ) break;
-
-  std::getline(file, file_line);
-  iss = std::istringstream(file_line);
-  int num_nodes;
-  if ( !(iss >> num_nodes) )
-    throw std::logic_error(fname + ": Failed while trying to read "
-                                   "the number of nodes.");
-
-  vertices.clear();
-  vertices.resize(num_nodes);
-
-  for (int n=0; n<num_nodes; n++)
-  {
-    std::getline(file, file_line);
-    iss = std::istringstream(file_line);
-
-    int vert_index;
-    if ( !(iss >> vert_index) )
-      throw std::logic_error(fname + ": Failed to read vertex index.");
-
-    if (!(iss >> vertices[vert_index-1].x
-              >> vertices[vert_index-1].y
-              >> vertices[vert_index-1].z))
-      throw std::logic_error(fname + ": Failed while reading the vertex "
-                                     "coordinates.");
-  }
-
   //================================================== Define utility lambdas
   /**Lambda for reading nodes.*/
   auto ReadNodes = [&iss,&fname](int num_nodes)
@@ -150,47 +129,70 @@ void chi_mesh::UnpartitionedMesh::ReadFromMsh(const Options &options)
     return cell_type;
   };
 
+  //================================================== Locate sections
+  // The node and element sections are located once. The node lines are
+  // skipped without being parsed since, when dividing the work, the
+  // nodes needed are only known after the elements are read.
+  const auto SkipLine = [&file]()
+  {
+    file.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+  };
+
+  std::streampos nodes_section_pos = -1;
+  std::streampos elements_section_pos = -1;
+  int num_nodes = 0;
+  int num_elems = 0;
+  while (std::getline(file, file_line))
+  {
+    if ( node_section_name == file_line )
+    {
+      if ( !(file >> num_nodes) )
+        throw std::logic_error(fname + ": Failed while trying to read "
+                                       "the number of nodes.");
+      SkipLine();
+      nodes_section_pos = file.tellg();
+      for (int n=0; n<num_nodes; ++n) SkipLine();
+    }
+    else if ( elements_section_name == file_line )
+    {
+      if ( !(file >> num_elems) )
+        throw std::logic_error(fname + ": Failed to read number of elements.");
+      SkipLine();
+      elements_section_pos = file.tellg();
+      break;
+    }
+  }
+
+  if (nodes_section_pos == std::streampos(-1) or
+      elements_section_pos == std::streampos(-1))
+    throw std::logic_error(fname + ": Failed to find the node and element "
+                                   "sections.");
+
   //================================================== Determine mesh type 2D/3D
   // Only 2D and 3D meshes are supported. If the mesh
   // is 1D then no elements will be read but the state
   // would still be safe.
   // This section will run through all the elements
-  // looking for a 3D element. It will not process
-  // any elements.
+  // looking for a 3D element. Only the element types are read.
+  // When dividing the work, all elements are counted
+  // in order to split them into chunks.
   bool mesh_is_2D_assumption = true;
-  file.seekg(0);
-  while (std::getline(file, file_line))
-    if ( elements_section_name == file_line ) break;
-
-  std::getline(file, file_line);
-  iss = std::istringstream(file_line);
-  int num_elems;
-  if (!(iss >> num_elems))
-    throw std::logic_error(fname + ": Failed to read number of elements.");
+  uint64_t num_elems_by_dim[3] = {0, 0, 0};
 
   for (int n=0; n<num_elems; n++)
   {
-    int elem_type, num_tags, physical_reg, tag, element_index;
-
-    std::getline(file, file_line);
-    iss = std::istringstream(file_line);
+    int elem_type, element_index;
 
-    if ( !(iss >> element_index >> elem_type >> num_tags) )
-      throw std::logic_error(fname + ": Failed while reading element index, "
-                                     "element type, and number of tags.");
+    if ( !(file >> element_index >> elem_type) )
+      throw std::logic_error(fname + ": Failed while reading element index "
+                                     "and element type.");
+    SkipLine();
 
-    if( !(iss>>physical_reg) )
-      throw std::logic_error(fname + ": Failed while reading physical region.");
-
-    for (int i=1; i<num_tags; i++)
-      if( !(iss >> tag) )
-        throw std::logic_error(fname + ": Failed when reading tags.");
-
-    if (IsElementType3D(elem_type))
+    if (IsElementType3D(elem_type) and mesh_is_2D_assumption)
     {
       mesh_is_2D_assumption = false;
       chi_log.Log() << "Mesh identified as 3D.";
-      break; //have the answer now leave loop
+      if (not divide_work) break; //have the answer now leave loop
     }
 
     if (elem_type == 15) //skip point type element
@@ -198,47 +200,60 @@ void chi_mesh::UnpartitionedMesh::ReadFromMsh(const Options &options)
 
     if (not IsElementSupported(elem_type))
       throw std::logic_error(fname + ": Unsupported element encountered.");
+
+    if      (elem_type == 1)                   ++num_elems_by_dim[0];
+    else if (elem_type == 2 or elem_type == 3) ++num_elems_by_dim[1];
+    else if (elem_type == 4 or elem_type == 5) ++num_elems_by_dim[2];
   }//for n
 
+  //================================================== Determine chunks
+  // Location i reads elements [N*i/P, N*(i+1)/P) of both the volume and
+  // the boundary elements.
+  const uint64_t num_volume_elems =
+    mesh_is_2D_assumption? num_elems_by_dim[1] : num_elems_by_dim[2];
+  const uint64_t num_bndry_elems =
+    mesh_is_2D_assumption? num_elems_by_dim[0] : num_elems_by_dim[1];
+
+  auto ChunkRange = [](uint64_t num_items)
+  {
+    const auto P = static_cast<uint64_t>(chi_mpi.process_count);
+    const auto i = static_cast<uint64_t>(chi_mpi.location_id);
+    return std::make_pair((num_items*i)/P, (num_items*(i+1))/P);
+  };
+  const auto volume_chunk = ChunkRange(num_volume_elems);
+  const auto bndry_chunk  = ChunkRange(num_bndry_elems);
+  uint64_t volume_elem_index = 0;
+  uint64_t bndry_elem_index  = 0;
+
   //================================================== Return to the element
   //                                                   listing section
-  // Now we will actually read the elements.
-  file.seekg(0);
-  while (std::getline(file, file_line))
-    if ( elements_section_name == file_line ) break;
-
-  std::getline(file, file_line);
-  iss = std::istringstream(file_line);
-  if (!(iss >> num_elems))
-    throw std::logic_error(fname + ": Failed to read number of elements.");
+  // Now we will actually read the elements. When dividing the work, the
+  // elements of other chunks are skipped without being parsed and the
+  // reading stops after the last element of the local chunks.
+  file.clear();
+  file.seekg(elements_section_pos);
 
   for (int n=0; n<num_elems; n++)
   {
-    int elem_type, num_tags, physical_reg, tag, element_index;
+    if (divide_work and volume_elem_index >= volume_chunk.second and
+                        bndry_elem_index  >= bndry_chunk.second)
+      break;
 
-    std::getline(file, file_line);
-    iss = std::istringstream(file_line);
-
-    if ( !(iss >> element_index >> elem_type >> num_tags) )
-      throw std::logic_error(fname + ": Failed while reading element index, "
-                                     "element type, and number of tags.");
+    int elem_type, num_tags, physical_reg, tag, element_index;
 
-    if( !(iss>>physical_reg) )
-      throw std::logic_error(fname + ": Failed while reading physical region.");
-
-    for (int i=1; i<num_tags; i++)
-      if ( !(iss >> tag) )
-        throw std::logic_error(fname + ": Failed when reading tags.");
+    if ( !(file >> element_index >> elem_type) )
+      throw std::logic_error(fname + ": Failed while reading element index "
+                                     "and element type.");
 
     if (elem_type == 15) //skip point type elements
+    {
+      SkipLine();
       continue;
+    }
 
     if (not IsElementSupported(elem_type))
       throw std::logic_error(fname + ": Unsupported element encountered.");
 
-    chi_log.Log(LOG_0VERBOSE_1) << "Reading element: " << file_line
-                                << " type: " << elem_type;
-
     int num_cell_nodes;
     if (elem_type == 1)
       num_cell_nodes = 2;
@@ -249,7 +264,46 @@ void chi_mesh::UnpartitionedMesh::ReadFromMsh(const Options &options)
     else if (elem_type == 5) //8-node hexahedron
       num_cell_nodes = 8;
     else
+    {
+      SkipLine();
       continue;
+    }
+
+    //====================================== Skip elements of other chunks
+    const bool is_volume_elem = mesh_is_2D_assumption?
+      IsElementType2D(elem_type) : IsElementType3D(elem_type);
+    const bool is_bndry_elem  = mesh_is_2D_assumption?
+      IsElementType1D(elem_type) : IsElementType2D(elem_type);
+
+    if (divide_work and (is_volume_elem or is_bndry_elem))
+    {
+      const uint64_t index = is_volume_elem?
+        volume_elem_index++ : bndry_elem_index++;
+      const auto& chunk = is_volume_elem? volume_chunk : bndry_chunk;
+      if (index < chunk.first or index >= chunk.second)
+      {
+        SkipLine();
+        continue;
+      }
+      if (is_volume_elem)
+        raw_cell_global_ids.push_back(index);
+    }
+
+    std::getline(file, file_line);
+    iss = std::istringstream(file_line);
+
+    if ( !(iss >> num_tags) )
+      throw std::logic_error(fname + ": Failed while reading number of tags.");
+
+    if( !(iss>>physical_reg) )
+      throw std::logic_error(fname + ": Failed while reading physical region.");
+
+    for (int i=1; i<num_tags; i++)
+      if ( !(iss >> tag) )
+        throw std::logic_error(fname + ": Failed when reading tags.");
+
+    chi_log.Log(LOG_0VERBOSE_1) << "Reading element: " << element_index
+                                << " type: " << elem_type;
 
     //====================================== Make the cell on either the volume
     //                                       or the boundary
@@ -346,6 +400,61 @@ void chi_mesh::UnpartitionedMesh::ReadFromMsh(const Options &options)
 
   }//for elements
 
+  //=================================================== Return to the section
+  //                                                    with node information
+  //                                                    and read the nodes
+  // The nodes are read after the elements so that, when dividing the
+  // work, only the nodes used by the local chunk need to be parsed and
+  // stored. The other node lines are skipped.
+  file.clear();
+  file.seekg(nodes_section_pos);
+
+  vertices.clear();
+  if (not divide_work)
+    vertices.resize(num_nodes);
+
+  //When dividing the work only the nodes of the local chunk are kept
+  std::unordered_set<uint64_t> chunk_vertex_ids;
+  if (divide_work)
+  {
+    for (const auto& cell : raw_cells)
+      chunk_vertex_ids.insert(cell->vertex_ids.begin(),
+                              cell->vertex_ids.end());
+    for (const auto& cell : raw_boundary_cells)
+      chunk_vertex_ids.insert(cell->vertex_ids.begin(),
+                              cell->vertex_ids.end());
+    local_vertices.clear();
+    local_vertices.reserve(chunk_vertex_ids.size());
+  }
+
+  for (int n=0; n<num_nodes; n++)
+  {
+    if (divide_work and local_vertices.size() == chunk_vertex_ids.size())
+      break;
+
+    int vert_index;
+    if ( !(file >> vert_index) )
+      throw std::logic_error(fname + ": Failed to read vertex index.");
+
+    const uint64_t vid = vert_index-1;
+    if (divide_work and chunk_vertex_ids.count(vid) == 0)
+    {
+      SkipLine();
+      continue;
+    }
+
+    chi_mesh::Vertex vertex;
+    if (!(file >> vertex.x >> vertex.y >> vertex.z))
+      throw std::logic_error(fname + ": Failed while reading the vertex "
+                                     "coordinates.");
+    SkipLine();
+
+    if (divide_work)
+      local_vertices[vid] = vertex;
+    else
+      vertices[vid] = vertex;
+  }
+
   file.close();
 
   //======================================== Remap material-ids
@@ -361,6 +470,37 @@ void chi_mesh::UnpartitionedMesh::ReadFromMsh(const Options &options)
   for (auto& cell : raw_boundary_cells)
     boundary_ids_set_as_read.insert(cell->material_id);
 
+  //The ids of all chunks are needed for a consistent mapping
+  if (divide_work)
+  {
+    auto GatherSet = [](const std::set<int>& local_set)
+    {
+      std::vector<int> local_ids(local_set.begin(), local_set.end());
+      int local_count = static_cast<int>(local_ids.size());
+      std::vector<int> counts(chi_mpi.process_count, 0);
+      MPI_Allgather(&local_count, 1, MPI_INT,
+                    counts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+
+      std::vector<int> displs(chi_mpi.process_count, 0);
+      int total_count = 0;
+      for (int p=0; p<chi_mpi.process_count; ++p)
+      {
+        displs[p] = total_count;
+        total_count += counts[p];
+      }
+
+      std::vector<int> global_ids(total_count, 0);
+      MPI_Allgatherv(local_ids.data(), local_count, MPI_INT,
+                     global_ids.data(), counts.data(), displs.data(), MPI_INT,
+                     MPI_COMM_WORLD);
+
+      return std::set<int>(global_ids.begin(), global_ids.end());
+    };
+
+    material_ids_set_as_read = GatherSet(material_ids_set_as_read);
+    boundary_ids_set_as_read = GatherSet(boundary_ids_set_as_read);
+  }
+
   {
     int m=0;
     for (const auto& mat_id : material_ids_set_as_read)
@@ -378,12 +518,26 @@ void chi_mesh::UnpartitionedMesh::ReadFromMsh(const Options &options)
     cell->material_id = boundary_mapping[cell->material_id];
 
   //======================================== Always do this
-  ComputeCentroidsAndCheckQuality();
-  BuildMeshConnectivity();
+  if (divide_work)
+  {
+    distributed         = true;
+    num_global_cells    = num_volume_elems;
+    num_global_vertices = num_nodes;
+
+    ComputeCentroidsAndCheckQuality();
+    BuildDistributedMeshConnectivity();
+  }
+  else
+  {
+    ComputeCentroidsAndCheckQuality();
+    BuildMeshConnectivity();
+  }
 
   chi_log.Log() << "Done processing " << options.file_name << ".\n"
-                << "Number of nodes read: " << vertices.size() << "\n"
-                << "Number of cells read: " << raw_cells.size();
+                << "Number of nodes read: "
+                << (divide_work? num_global_vertices : vertices.size()) << "\n"
+                << "Number of cells read: "
+                << (divide_work? num_global_cells : raw_cells.size());
 }
 
 
@@ -0,0 +1,482 @@
+#include "chi_unpartitioned_mesh.h"
+#include "unpartmesh_facekey.h"
+
+#include "chi_log.h"
+extern ChiLog& chi_log;
+
+#include "ChiTimer/chi_timer.h"
+extern ChiTimer chi_program_timer;
+
+#include "chi_mpi.h"
+extern ChiMPI& chi_mpi;
+
+#include "ChiMPI/chi_mpi_utils_map_all2all.h"
+
+#include <unordered_set>
+#include <cstring>
+
+namespace
+{
+using chi_mesh::unpartitioned_mesh_utils::FaceKey;
+using chi_mesh::unpartitioned_mesh_utils::FaceKeyHash;
+
+/**Kinds of face-key messages.*/
+enum FaceKeyKind : uint64_t
+{
+  CELL_FACE     = 0,
+  BOUNDARY_CELL = 1
+};
+
+/**Face of a cell on another location.*/
+struct RemoteFace
+{
+  int      location;
+  uint64_t cell_global_id;
+  uint64_t face_id;
+};
+
+/**First face found for a key, and the number of faces sharing it.*/
+struct RemoteFaceEntry
+{
+  RemoteFace face;
+  uint32_t   count;
+};
+
+uint64_t DoubleToBits(double value)
+{
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(double));
+  return bits;
+}
+
+double BitsToDouble(uint64_t bits)
+{
+  double value;
+  std::memcpy(&value, &bits, sizeof(double));
+  return value;
+}
+}//namespace
+
+//###################################################################
+/**Establishes neighbor connectivity for a mesh of which every location
+ * only holds a chunk of the raw cells (ParallelMethod::DIVIDE_WORK).
+ *
+ * Every unconnected face, as well as every boundary cell, is keyed by its
+ * sorted vertex ids and sent to the location owning the key's hash. The
+ * owner pairs equal keys and informs the locations holding the faces of
+ * their neighbor's global id, or of the boundary material for faces that
+ * only match a boundary cell. No location ever stores more than its own
+ * faces plus the faces whose keys it owns.*/
+void chi_mesh::UnpartitionedMesh::BuildDistributedMeshConnectivity()
+{
+  const int num_locations = chi_mpi.process_count;
+
+  chi_log.Log() << chi_program_timer.GetTimeString()
+                << " Establishing distributed cell connectivity.";
+
+  //======================================== Send keys to their owners
+  // Message per key: kind, cell global-id or boundary material,
+  // face index, number of vertices, sorted vertex ids
+  std::map<int, std::vector<uint64_t>> key_messages;
+  auto PushKey = [&key_messages,num_locations]
+    (uint64_t kind, uint64_t id, uint64_t face_id, const FaceKey& key)
+  {
+    auto& message = key_messages[static_cast<int>(key.hash % num_locations)];
+    message.push_back(kind);
+    message.push_back(id);
+    message.push_back(face_id);
+    message.push_back(key.vertex_ids.size());
+    message.insert(message.end(), key.vertex_ids.begin(), key.vertex_ids.end());
+  };
+
+  for (size_t c=0; c<raw_cells.size(); ++c)
+  {
+    const auto& faces = raw_cells[c]->faces;
+    for (uint64_t f=0; f<faces.size(); ++f)
+      if (not faces[f].has_neighbor)
+        PushKey(CELL_FACE, raw_cell_global_ids[c], f,
+                FaceKey(faces[f].vertex_ids));
+  }
+
+  for (const auto& cell : raw_boundary_cells)
+    PushKey(BOUNDARY_CELL,
+            static_cast<uint64_t>(static_cast<int64_t>(cell->material_id)), 0,
+            FaceKey(cell->vertex_ids));
+
+  auto received_keys = chi_mpi_utils::MapAllToAll(key_messages,
+                                                  MPI_UNSIGNED_LONG_LONG);
+  key_messages.clear();
+
+  chi_log.Log() << chi_program_timer.GetTimeString()
+                << " Face keys exchanged.";
+
+  //======================================== Pair keys
+  // Reply per face: cell global-id, face index, has_neighbor, neighbor
+  std::unordered_map<FaceKey, RemoteFaceEntry, FaceKeyHash> face_table;
+  std::unordered_map<FaceKey, int, FaceKeyHash>             bndry_table;
+  std::map<int, std::vector<uint64_t>> reply_messages;
+
+  auto PushReply = [&reply_messages](const RemoteFace& face,
+                                     bool has_neighbor, uint64_t neighbor)
+  {
+    auto& message = reply_messages[face.location];
+    message.push_back(face.cell_global_id);
+    message.push_back(face.face_id);
+    message.push_back(has_neighbor? 1 : 0);
+    message.push_back(neighbor);
+  };
+
+  for (auto& location_keys : received_keys)
+  {
+    const int location = location_keys.first;
+    const auto& data = location_keys.second;
+
+    size_t k=0;
+    while (k < data.size())
+    {
+      const uint64_t kind    = data[k];
+      const uint64_t id      = data[k+1];
+      const uint64_t face_id = data[k+2];
+      const uint64_t num_vids = data[k+3];
+      k += 4;
+
+      FaceKey key(std::vector<uint64_t>(data.begin() + k,
+                                        data.begin() + k + num_vids));
+      k += num_vids;
+
+      if (kind == BOUNDARY_CELL)
+      {
+        bndry_table.emplace(std::move(key),
+                            static_cast<int>(static_cast<int64_t>(id)));
+        continue;
+      }
+
+      RemoteFace face{location, id, face_id};
+      auto result = face_table.emplace(std::move(key),
+                                       RemoteFaceEntry{face, 1});
+      if (result.second) continue;
+
+      auto& entry = result.first->second;
+      if (entry.count == 1)
+      {
+        PushReply(face, true, entry.face.cell_global_id);
+        PushReply(entry.face, true, face.cell_global_id);
+      }
+      ++entry.count;
+    }
+    std::vector<uint64_t>().swap(location_keys.second);
+  }
+  received_keys.clear();
+
+  //======================================== Match boundary cells
+  uint64_t local_counts[2] = {0, 0}; //unmatched, non-manifold
+  for (const auto& key_entry : face_table)
+  {
+    const auto& entry = key_entry.second;
+    if (entry.count  > 2) ++local_counts[1];
+    if (entry.count != 1) continue;
+
+    ++local_counts[0];
+    auto bndry_cell = bndry_table.find(key_entry.first);
+    if (bndry_cell != bndry_table.end())
+      PushReply(entry.face, false,
+                static_cast<uint64_t>(bndry_cell->second));
+  }
+  face_table.clear();
+  bndry_table.clear();
+
+  uint64_t global_counts[2] = {0, 0};
+  MPI_Allreduce(local_counts, global_counts, 2,
+                MPI_UNSIGNED_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+
+  chi_log.Log(LOG_0VERBOSE_1) << chi_program_timer.GetTimeString()
+                              << " Number of unmatched faces: "
+                              << global_counts[0];
+
+  if (global_counts[1] > 0)
+    chi_log.Log(LOG_0WARNING)
+      << "Mesh connectivity: " << global_counts[1] << " non-manifold faces "
+      << "shared by more than two cells. Only the first two cells of each "
+      << "are connected.";
+
+  //======================================== Apply replies
+  auto received_replies = chi_mpi_utils::MapAllToAll(reply_messages,
+                                                     MPI_UNSIGNED_LONG_LONG);
+  reply_messages.clear();
+
+  std::unordered_map<uint64_t, size_t> global_to_local;
+  global_to_local.reserve(raw_cells.size());
+  for (size_t c=0; c<raw_cells.size(); ++c)
+    global_to_local[raw_cell_global_ids[c]] = c;
+
+  for (const auto& location_replies : received_replies)
+  {
+    const auto& data = location_replies.second;
+    for (size_t k=0; k<data.size(); k+=4)
+    {
+      auto& face = raw_cells[global_to_local.at(data[k])]->faces[data[k+1]];
+      face.has_neighbor = (data[k+2] == 1);
+      face.neighbor     = data[k+3];
+    }
+  }
+
+  MPI_Barrier(MPI_COMM_WORLD);
+  chi_log.Log() << chi_program_timer.GetTimeString()
+                << " Done establishing distributed cell connectivity.";
+}
+
+//###################################################################
+/**Sends the raw cells of a distributed mesh to the locations that need
+ * them, given the partition-id of every local raw cell. A location
+ * receives the cells of its own partition plus, as ghosts, every cell
+ * sharing a vertex with one of them, together with the coordinates of
+ * their vertices. Afterwards the raw cells, their global- and
+ * partition-ids and the local vertices are replaced by the received ones,
+ * sorted by global-id, and the boundary cells are released.
+ *
+ * The vertex-to-partition relation is gathered on the location owning
+ * each vertex (vid modulo the number of locations), so that no location
+ * needs the global vertex-cell subscriptions. A mesh can only be
+ * redistributed once.*/
+void chi_mesh::UnpartitionedMesh::
+  RedistributeCells(const std::vector<int64_t>& cell_partition_ids)
+{
+  const int num_locations = chi_mpi.process_count;
+
+  if (not distributed)
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "UnpartitionedMesh::RedistributeCells called on a mesh that "
+         "is not distributed.";
+    exit(EXIT_FAILURE);
+  }
+  if (redistributed)
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "UnpartitionedMesh::RedistributeCells: A distributed mesh can "
+         "only be partitioned once.";
+    exit(EXIT_FAILURE);
+  }
+
+  chi_log.Log() << chi_program_timer.GetTimeString()
+                << " Redistributing cells.";
+
+  //======================================== Collect vertex partitions
+  //                                         on the vertex owners
+  std::map<int, std::vector<uint64_t>> vertex_pid_messages;
+  for (size_t c=0; c<raw_cells.size(); ++c)
+  {
+    const auto pid = static_cast<uint64_t>(cell_partition_ids[c]);
+    for (uint64_t vid : raw_cells[c]->vertex_ids)
+    {
+      auto& message = vertex_pid_messages[static_cast<int>(vid % num_locations)];
+      message.push_back(vid);
+      message.push_back(pid);
+    }
+  }
+
+  auto received_vertex_pids =
+    chi_mpi_utils::MapAllToAll(vertex_pid_messages, MPI_UNSIGNED_LONG_LONG);
+  vertex_pid_messages.clear();
+
+  std::unordered_map<uint64_t, std::vector<uint64_t>> owned_vertex_pids;
+  for (const auto& location_data : received_vertex_pids)
+  {
+    const auto& data = location_data.second;
+    for (size_t k=0; k<data.size(); k+=2)
+      owned_vertex_pids[data[k]].push_back(data[k+1]);
+  }
+  for (auto& vid_pids : owned_vertex_pids)
+  {
+    auto& pids = vid_pids.second;
+    std::sort(pids.begin(), pids.end());
+    pids.erase(std::unique(pids.begin(), pids.end()), pids.end());
+  }
+
+  //======================================== Return the vertex partitions
+  // Reply per vertex: vid, number of partitions, partitions
+  std::map<int, std::vector<uint64_t>> vertex_pid_replies;
+  for (const auto& location_data : received_vertex_pids)
+  {
+    const auto& data = location_data.second;
+    auto& message = vertex_pid_replies[location_data.first];
+    std::unordered_set<uint64_t> vids_replied;
+    for (size_t k=0; k<data.size(); k+=2)
+    {
+      const uint64_t vid = data[k];
+      if (not vids_replied.insert(vid).second) continue;
+
+      const auto& pids = owned_vertex_pids.at(vid);
+      message.push_back(vid);
+      message.push_back(pids.size());
+      message.insert(message.end(), pids.begin(), pids.end());
+    }
+  }
+  received_vertex_pids.clear();
+  owned_vertex_pids.clear();
+
+  auto received_pid_replies =
+    chi_mpi_utils::MapAllToAll(vertex_pid_replies, MPI_UNSIGNED_LONG_LONG);
+  vertex_pid_replies.clear();
+
+  std::unordered_map<uint64_t, std::vector<uint64_t>> vertex_pids;
+  for (const auto& location_data : received_pid_replies)
+  {
+    const auto& data = location_data.second;
+    size_t k=0;
+    while (k < data.size())
+    {
+      const uint64_t vid = data[k];
+      const uint64_t num_pids = data[k+1];
+      vertex_pids[vid].assign(data.begin() + k + 2,
+                              data.begin() + k + 2 + num_pids);
+      k += 2 + num_pids;
+    }
+  }
+  received_pid_replies.clear();
+
+  //======================================== Send cells to their partitions
+  // Message per cell: global-id, partition-id, type, sub-type, material,
+  // centroid, number of vertices, (vid,x,y,z) per vertex, number of faces,
+  // (has_neighbor, neighbor, number of vertices, vids) per face
+  std::map<int, std::vector<uint64_t>> cell_messages;
+  std::vector<uint64_t> serial_cell;
+  for (size_t c=0; c<raw_cells.size(); ++c)
+  {
+    const auto& cell = *raw_cells[c];
+    const auto pid = static_cast<uint64_t>(cell_partition_ids[c]);
+
+    serial_cell.clear();
+    serial_cell.push_back(raw_cell_global_ids[c]);
+    serial_cell.push_back(pid);
+    serial_cell.push_back(static_cast<uint64_t>(cell.type));
+    serial_cell.push_back(static_cast<uint64_t>(cell.sub_type));
+    serial_cell.push_back(
+      static_cast<uint64_t>(static_cast<int64_t>(cell.material_id)));
+    serial_cell.push_back(DoubleToBits(cell.centroid.x));
+    serial_cell.push_back(DoubleToBits(cell.centroid.y));
+    serial_cell.push_back(DoubleToBits(cell.centroid.z));
+
+    serial_cell.push_back(cell.vertex_ids.size());
+    for (uint64_t vid : cell.vertex_ids)
+    {
+      const auto& vertex = GetVertex(vid);
+      serial_cell.push_back(vid);
+      serial_cell.push_back(DoubleToBits(vertex.x));
+      serial_cell.push_back(DoubleToBits(vertex.y));
+      serial_cell.push_back(DoubleToBits(vertex.z));
+    }
+
+    serial_cell.push_back(cell.faces.size());
+    for (const auto& face : cell.faces)
+    {
+      serial_cell.push_back(face.has_neighbor? 1 : 0);
+      serial_cell.push_back(face.neighbor);
+      serial_cell.push_back(face.vertex_ids.size());
+      serial_cell.insert(serial_cell.end(),
+                         face.vertex_ids.begin(), face.vertex_ids.end());
+    }
+
+    std::set<uint64_t> destinations = {pid};
+    for (uint64_t vid : cell.vertex_ids)
+      for (uint64_t vertex_pid : vertex_pids.at(vid))
+        destinations.insert(vertex_pid);
+
+    for (uint64_t destination : destinations)
+    {
+      auto& message = cell_messages[static_cast<int>(destination)];
+      message.insert(message.end(), serial_cell.begin(), serial_cell.end());
+    }
+  }
+  vertex_pids.clear();
+
+  //======================================== Release the chunk
+  for (auto& cell : raw_cells)          delete cell;
+  for (auto& cell : raw_boundary_cells) delete cell;
+  raw_cells.clear();
+  raw_boundary_cells.clear();
+  raw_cell_global_ids.clear();
+  raw_cell_partition_ids.clear();
+  local_vertices.clear();
+
+  auto received_cells = chi_mpi_utils::MapAllToAll(cell_messages,
+                                                   MPI_UNSIGNED_LONG_LONG);
+  cell_messages.clear();
+
+  //======================================== Unpack cells
+  struct ReceivedCell
+  {
+    uint64_t         global_id;
+    int64_t          partition_id;
+    LightWeightCell* cell;
+  };
+  std::vector<ReceivedCell> new_cells;
+
+  for (auto& location_data : received_cells)
+  {
+    const auto& data = location_data.second;
+    size_t k=0;
+    while (k < data.size())
+    {
+      const uint64_t global_id = data[k];
+      const auto partition_id  = static_cast<int64_t>(data[k+1]);
+      const auto type          = static_cast<CellType>(data[k+2]);
+      const auto sub_type      = static_cast<CellType>(data[k+3]);
+
+      auto cell = new LightWeightCell(type, sub_type);
+      cell->material_id = static_cast<int>(static_cast<int64_t>(data[k+4]));
+      cell->centroid = chi_mesh::Vertex(BitsToDouble(data[k+5]),
+                                        BitsToDouble(data[k+6]),
+                                        BitsToDouble(data[k+7]));
+      k += 8;
+
+      const uint64_t num_vids = data[k++];
+      cell->vertex_ids.reserve(num_vids);
+      for (uint64_t v=0; v<num_vids; ++v, k+=4)
+      {
+        const uint64_t vid = data[k];
+        cell->vertex_ids.push_back(vid);
+        local_vertices[vid] = chi_mesh::Vertex(BitsToDouble(data[k+1]),
+                                               BitsToDouble(data[k+2]),
+                                               BitsToDouble(data[k+3]));
+      }
+
+      const uint64_t num_faces = data[k++];
+      cell->faces.resize(num_faces);
+      for (auto& face : cell->faces)
+      {
+        face.has_neighbor = (data[k] == 1);
+        face.neighbor     = data[k+1];
+        const uint64_t num_face_vids = data[k+2];
+        k += 3;
+        face.vertex_ids.assign(data.begin() + k,
+                               data.begin() + k + num_face_vids);
+        k += num_face_vids;
+      }
+
+      new_cells.push_back({global_id, partition_id, cell});
+    }
+    std::vector<uint64_t>().swap(location_data.second);
+  }
+  received_cells.clear();
+
+  std::sort(new_cells.begin(), new_cells.end(),
+            [](const ReceivedCell& a, const ReceivedCell& b)
+            {return a.global_id < b.global_id;});
+
+  raw_cells.reserve(new_cells.size());
+  raw_cell_global_ids.reserve(new_cells.size());
+  raw_cell_partition_ids.reserve(new_cells.size());
+  for (const auto& new_cell : new_cells)
+  {
+    raw_cells.push_back(new_cell.cell);
+    raw_cell_global_ids.push_back(new_cell.global_id);
+    raw_cell_partition_ids.push_back(new_cell.partition_id);
+  }
+
+  redistributed = true;
+
+  MPI_Barrier(MPI_COMM_WORLD);
+  chi_log.Log() << chi_program_timer.GetTimeString()
+                << " Done redistributing cells.";
+}
@@ -0,0 +1,51 @@
+#ifndef CHI_MESH_UNPARTMESH_FACEKEY_H
+#define CHI_MESH_UNPARTMESH_FACEKEY_H
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+namespace chi_mesh
+{
+namespace unpartitioned_mesh_utils
+{
+//###################################################################
+/**Canonical key of a face, its sorted and unique vertex ids, with the
+ * hash computed once.*/
+struct FaceKey
+{
+  std::vector<uint64_t> vertex_ids;
+  size_t hash = 0;
+
+  FaceKey() = default;
+  explicit FaceKey(const std::vector<uint64_t>& in_vertex_ids) :
+    vertex_ids(in_vertex_ids)
+  {
+    std::sort(vertex_ids.begin(), vertex_ids.end());
+    vertex_ids.erase(std::unique(vertex_ids.begin(), vertex_ids.end()),
+                     vertex_ids.end());
+
+    uint64_t h = 14695981039346656037ULL;
+    for (uint64_t vid : vertex_ids)
+    {
+      h ^= vid + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+      h *= 1099511628211ULL;
+    }
+    hash = static_cast<size_t>(h);
+  }
+
+  bool operator==(const FaceKey& other) const
+  {
+    return hash == other.hash and vertex_ids == other.vertex_ids;
+  }
+};
+
+struct FaceKeyHash
+{
+  size_t operator()(const FaceKey& key) const {return key.hash;}
+};
+}//namespace unpartitioned_mesh_utils
+}//namespace chi_mesh
+
+#endif //CHI_MESH_UNPARTMESH_FACEKEY_H
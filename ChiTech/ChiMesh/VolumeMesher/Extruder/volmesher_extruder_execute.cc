@@ -62,6 +62,14 @@ void chi_mesh::VolumeMesherExtruder::Execute()
       << "VolumeMesherExtruder: Processing unpartitioned mesh"
       << std::endl;
 
+    if (template_unpartitioned_mesh->distributed)
+    {
+      chi_log.Log(LOG_ALLERROR)
+        << "VolumeMesherExtruder: Distributed unpartitioned meshes can not "
+           "be used as extrusion templates.";
+      exit(EXIT_FAILURE);
+    }
+
     //================================== Get node_z_incr
     node_z_index_incr = template_unpartitioned_mesh->vertices.size();
 
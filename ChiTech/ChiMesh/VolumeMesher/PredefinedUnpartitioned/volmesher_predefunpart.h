@@ -30,6 +30,6 @@ public:
     const chi_mesh::UnpartitionedMesh::LightWeightCell& raw_cell,
     uint64_t global_id,
     uint64_t partition_id,
-    const std::vector<chi_mesh::Vector3>& vertices);
+    const chi_mesh::UnpartitionedMesh& umesh);
 };
 #endif //VOLMESHER_PREDEFUNPART_H
\ No newline at end of file
@@ -9,7 +9,7 @@ chi_mesh::Cell* chi_mesh::VolumeMesherPredefinedUnpartitioned::
     const chi_mesh::UnpartitionedMesh::LightWeightCell &raw_cell,
     uint64_t global_id,
     uint64_t partition_id,
-    const std::vector<chi_mesh::Vector3>& vertices)
+    const chi_mesh::UnpartitionedMesh& umesh)
 {
   auto cell = new chi_mesh::Cell(raw_cell.type, raw_cell.sub_type);
   cell->centroid     = raw_cell.centroid;
@@ -30,7 +30,7 @@ chi_mesh::Cell* chi_mesh::VolumeMesherPredefinedUnpartitioned::
     newFace.vertex_ids = raw_face.vertex_ids;
     auto vfc = chi_mesh::Vertex(0.0, 0.0, 0.0);
     for (auto fvid : newFace.vertex_ids)
-      vfc = vfc + vertices[fvid];
+      vfc = vfc + umesh.GetVertex(fvid);
     newFace.centroid = vfc / static_cast<double>(newFace.vertex_ids.size());
 
     if (cell->Type() == CellType::SLAB)
@@ -50,7 +50,7 @@ chi_mesh::Cell* chi_mesh::VolumeMesherPredefinedUnpartitioned::
       // centroid. The normal is then just khat
       // cross-product with this vector.
       uint64_t fvid = newFace.vertex_ids[0];
-      auto vec_vvc = vertices[fvid] - newFace.centroid;
+      auto vec_vvc = umesh.GetVertex(fvid) - newFace.centroid;
 
       newFace.normal = chi_mesh::Vector3(0.0,0.0,1.0).Cross(vec_vvc);
       newFace.normal.Normalize();
@@ -70,8 +70,8 @@ chi_mesh::Cell* chi_mesh::VolumeMesherPredefinedUnpartitioned::
         uint64_t fvid_m = newFace.vertex_ids[fv  ];
         uint64_t fvid_p = newFace.vertex_ids[fvp1];
 
-        auto leg_m = vertices[fvid_m] - newFace.centroid;
-        auto leg_p = vertices[fvid_p] - newFace.centroid;
+        auto leg_m = umesh.GetVertex(fvid_m) - newFace.centroid;
+        auto leg_p = umesh.GetVertex(fvid_p) - newFace.centroid;
 
         auto vn = leg_m.Cross(leg_p);
 
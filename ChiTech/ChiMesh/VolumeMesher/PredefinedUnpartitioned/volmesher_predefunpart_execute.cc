@@ -87,25 +87,49 @@ void chi_mesh::VolumeMesherPredefinedUnpartitioned::Execute()
     cell_pids = PARMETIS(*umesh);
 
   //======================================== Load up the cells
-  auto& vertex_subs = umesh->vertex_cell_subscriptions;
-  size_t cell_globl_id = 0;
-  for (auto raw_cell : umesh->raw_cells)
+  if (umesh->distributed)
   {
-    if (CellHasLocalScope(*raw_cell, cell_globl_id, vertex_subs, cell_pids))
+    // Every location only holds a chunk of the cells. These are sent to
+    // the locations that need them, after which all the raw cells held
+    // are either local or ghost cells.
+    umesh->RedistributeCells(cell_pids);
+
+    for (size_t c=0; c<umesh->raw_cells.size(); ++c)
     {
-      auto cell = MakeCell(*raw_cell, cell_globl_id,
-                           cell_pids[cell_globl_id], umesh->vertices);
+      auto cell = MakeCell(*umesh->raw_cells[c],
+                           umesh->raw_cell_global_ids[c],
+                           umesh->raw_cell_partition_ids[c], *umesh);
 
       for (uint64_t vid : cell->vertex_ids)
-        grid->vertices.Insert(vid, umesh->vertices[vid]);
+        grid->vertices.Insert(vid, umesh->GetVertex(vid));
 
       grid->cells.push_back(cell);
     }
 
-    ++cell_globl_id;
-  }//for raw_cell
+    grid->SetGlobalVertexCount(umesh->num_global_vertices);
+  }
+  else
+  {
+    auto& vertex_subs = umesh->vertex_cell_subscriptions;
+    size_t cell_globl_id = 0;
+    for (auto raw_cell : umesh->raw_cells)
+    {
+      if (CellHasLocalScope(*raw_cell, cell_globl_id, vertex_subs, cell_pids))
+      {
+        auto cell = MakeCell(*raw_cell, cell_globl_id,
+                             cell_pids[cell_globl_id], *umesh);
 
-  grid->SetGlobalVertexCount(umesh->vertices.size());
+        for (uint64_t vid : cell->vertex_ids)
+          grid->vertices.Insert(vid, umesh->vertices[vid]);
+
+        grid->cells.push_back(cell);
+      }
+
+      ++cell_globl_id;
+    }//for raw_cell
+
+    grid->SetGlobalVertexCount(umesh->vertices.size());
+  }
 
   chi_log.Log(LOG_0) << "Cells loaded.";
   MPI_Barrier(MPI_COMM_WORLD);
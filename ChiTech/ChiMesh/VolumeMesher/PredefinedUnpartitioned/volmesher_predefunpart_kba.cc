@@ -42,9 +42,22 @@ std::vector<int64_t> chi_mesh::VolumeMesherPredefinedUnpartitioned::
     return nzi*Px*Py + nyi*Px + nxi;
   };
 
+  //======================================== Distributed meshes determine
+  //                                         the partition-IDs of their
+  //                                         own chunk
+  std::vector<int64_t> cell_pids(num_raw_cells, 0);
+  if (umesh.distributed)
+  {
+    uint64_t cell_id = 0;
+    for (auto& raw_cell : umesh.raw_cells)
+      cell_pids[cell_id++] = GetPIDFromCentroid(raw_cell->centroid);
+
+    chi_log.Log(LOG_0) << "Done partitioning mesh.";
+    return cell_pids;
+  }
+
   //======================================== Determine cell partition-IDs
   //                                         only on home location
-  std::vector<int64_t> cell_pids(num_raw_cells, 0);
   if (chi_mpi.location_id == 0)
   {
     uint64_t cell_id = 0;
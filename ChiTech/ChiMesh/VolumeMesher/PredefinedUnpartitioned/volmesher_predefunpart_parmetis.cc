@@ -11,6 +11,91 @@ extern ChiMPI& chi_mpi;
 
 #include "petsc.h"
 
+namespace
+{
+//###################################################################
+/**Partitions a distributed mesh with ParMETIS. The chunks of a
+ * distributed mesh are contiguous ranges of global cell-ids in location
+ * order, hence every location directly supplies its own rows of the
+ * distributed adjacency matrix and the partitioning itself runs in
+ * parallel.*/
+std::vector<int64_t>
+  PartitionDistributedMesh(const chi_mesh::UnpartitionedMesh& umesh)
+{
+  const size_t num_raw_cells = umesh.raw_cells.size();
+  std::vector<int64_t> cell_pids(num_raw_cells, 0);
+  if (umesh.num_global_cells <= 1)
+    return cell_pids;
+
+  if (umesh.num_global_cells < static_cast<uint64_t>(chi_mpi.process_count))
+  {
+    chi_log.Log(LOG_ALLERROR)
+      << "Distributed mesh partitioning requires at least as many cells ("
+      << umesh.num_global_cells << ") as processes ("
+      << chi_mpi.process_count << ").";
+    exit(EXIT_FAILURE);
+  }
+
+  //======================================== Build indices
+  size_t num_local_neighbors = 0;
+  for (auto cell : umesh.raw_cells)
+    for (auto& face : cell->faces)
+      if (face.has_neighbor) ++num_local_neighbors;
+
+  int64_t* i_indices_raw;
+  int64_t* j_indices_raw;
+  PetscMalloc((num_raw_cells+1)*sizeof(int64_t),&i_indices_raw);
+  PetscMalloc(std::max<size_t>(num_local_neighbors,1)*sizeof(int64_t),
+              &j_indices_raw);
+  {
+    int64_t i=0;
+    int64_t icount = 0;
+    for (auto cell : umesh.raw_cells)
+    {
+      i_indices_raw[i] = icount;
+
+      for (auto& face : cell->faces)
+        if (face.has_neighbor)
+          j_indices_raw[icount++] = static_cast<int64_t>(face.neighbor);
+      ++i;
+    }
+    i_indices_raw[i] = icount;
+  }
+
+  chi_log.Log(LOG_0VERBOSE_1) << "Done building distributed indices.";
+
+  //======================================== Create adjacency matrix
+  Mat Adj; //Adjacency matrix
+  MatCreateMPIAdj(PETSC_COMM_WORLD,
+                  (int64_t)num_raw_cells,
+                  (int64_t)umesh.num_global_cells,
+                  i_indices_raw, j_indices_raw, nullptr, &Adj);
+
+  //======================================== Create partitioning
+  MatPartitioning part;
+  IS is;
+  MatPartitioningCreate(PETSC_COMM_WORLD,&part);
+  MatPartitioningSetAdjacency(part,Adj);
+  MatPartitioningSetType(part,"parmetis");
+  MatPartitioningSetNParts(part,chi_mpi.process_count);
+  MatPartitioningApply(part,&is);
+  MatPartitioningDestroy(&part);
+  MatDestroy(&Adj);
+
+  //======================================== Get cell partition-ids
+  const int64_t* cell_pids_raw;
+  ISGetIndices(is,&cell_pids_raw);
+  for (size_t i=0; i<num_raw_cells; ++i)
+    cell_pids[i] = cell_pids_raw[i];
+  ISRestoreIndices(is,&cell_pids_raw);
+  ISDestroy(&is);
+
+  chi_log.Log(LOG_0) << "Done partitioning mesh.";
+
+  return cell_pids;
+}
+}//namespace
+
 //###################################################################
 /** Applies KBA-style partitioning to the mesh.*/
 std::vector<int64_t> chi_mesh::VolumeMesherPredefinedUnpartitioned::
@@ -18,6 +103,9 @@ std::vector<int64_t> chi_mesh::VolumeMesherPredefinedUnpartitioned::
 {
   chi_log.Log(LOG_0) << "Partitioning mesh with ParMETIS.";
 
+  if (umesh.distributed)
+    return PartitionDistributedMesh(umesh);
+
   //================================================== Determine avg num faces
   //                                                   per cell
   const size_t num_raw_cells = umesh.raw_cells.size();
@@ -43,6 +43,7 @@ void chi_mesh::VolumeMesher::
   //============================================= Copy nodes
   {
     uint64_t id = 0;
+    vol_continuum->vertices.Reserve(surface_mesh->vertices.size());
     for (auto& vertex : surface_mesh->vertices)
       vol_continuum->vertices.Insert(id++, vertex);
   }
@@ -198,6 +199,7 @@ void chi_mesh::VolumeMesher::
   //=================================== Copy nodes
   {
     uint64_t id = 0;
+    grid->vertices.Reserve(umesh.vertices.size());
     for (const auto& vertex : umesh.vertices)
       grid->vertices.Insert(id++, vertex);
   }
@@ -501,20 +503,32 @@ void chi_mesh::VolumeMesher::
   chi_mesh::Region* cur_region = handler->region_stack.back();
   chi_mesh::MeshContinuumPtr vol_cont = cur_region->GetGrid();
 
+  //============================================= Test all centroids at once
+  const auto& ghost_ids = vol_cont->cells.GetGhostGlobalIDs();
+  const size_t num_local_cells = vol_cont->local_cells.size();
+
+  std::vector<chi_mesh::Vector3> centroids;
+  centroids.reserve(num_local_cells + ghost_ids.size());
+  for (const auto& cell : vol_cont->local_cells)
+    centroids.push_back(cell.centroid);
+  for (uint64_t ghost_id : ghost_ids)
+    centroids.push_back(vol_cont->cells[ghost_id].centroid);
+
+  const auto inside = log_vol->InsideBatch(centroids);
+
   int num_cells_modified = 0;
   for (auto& cell : vol_cont->local_cells)
   {
-    if (log_vol->Inside(cell.centroid) && sense){
+    if (inside[cell.local_id] && sense){
       cell.material_id = mat_id;
       ++num_cells_modified;
     }
   }
 
-  const auto& ghost_ids = vol_cont->cells.GetGhostGlobalIDs();
-  for (uint64_t ghost_id : ghost_ids)
+  for (size_t g=0; g<ghost_ids.size(); ++g)
   {
-    auto& cell = vol_cont->cells[ghost_id];
-    if (log_vol->Inside(cell.centroid) && sense)
+    auto& cell = vol_cont->cells[ghost_ids[g]];
+    if (inside[num_local_cells + g] && sense)
       cell.material_id = mat_id;
   }
 
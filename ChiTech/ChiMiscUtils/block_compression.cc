@@ -0,0 +1,178 @@
+#include "chi_misc_utils.h"
+
+#include <cstring>
+#include <cstdint>
+
+namespace
+{
+const int      HASH_BITS      = 14;
+const size_t   MIN_MATCH      = 4;
+const size_t   MAX_OFFSET     = 65535;
+
+//###################################################################
+/**Transposes the bytes of num_bytes/element_size elements so that byte
+ * b of every element is stored contiguously. Trailing bytes that do not
+ * form a full element are copied as is.*/
+void ShuffleBytes(const unsigned char* in, unsigned char* out,
+                  const size_t num_bytes, const size_t element_size)
+{
+  const size_t num_elements = num_bytes / element_size;
+  for (size_t e=0; e<num_elements; ++e)
+    for (size_t b=0; b<element_size; ++b)
+      out[b*num_elements + e] = in[e*element_size + b];
+
+  const size_t tail = num_elements * element_size;
+  std::memcpy(out + tail, in + tail, num_bytes - tail);
+}
+
+//###################################################################
+/**Reverses ShuffleBytes.*/
+void UnshuffleBytes(const unsigned char* in, unsigned char* out,
+                    const size_t num_bytes, const size_t element_size)
+{
+  const size_t num_elements = num_bytes / element_size;
+  for (size_t e=0; e<num_elements; ++e)
+    for (size_t b=0; b<element_size; ++b)
+      out[e*element_size + b] = in[b*num_elements + e];
+
+  const size_t tail = num_elements * element_size;
+  std::memcpy(out + tail, in + tail, num_bytes - tail);
+}
+
+//###################################################################
+/**Appends an unsigned LEB128 encoded value.*/
+void PutVarint(std::vector<char>& out, uint64_t value)
+{
+  while (value >= 0x80)
+  {
+    out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+//###################################################################
+/**Reads an unsigned LEB128 encoded value. Returns false if the input is
+ * exhausted before the value is complete.*/
+bool GetVarint(const unsigned char* in, const size_t num_bytes,
+               size_t& pos, uint64_t& value)
+{
+  value = 0;
+  for (int shift=0; shift<64; shift+=7)
+  {
+    if (pos >= num_bytes) return false;
+    const unsigned char byte = in[pos++];
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if (not (byte & 0x80)) return true;
+  }
+  return false;
+}
+}//namespace
+
+//###################################################################
+/**Compresses a block of data with a byte-shuffle followed by a
+ * greedy LZ77-style match finder.
+ *
+ * The element size is used to group byte b of every element together
+ * before the match search. For floating-point arrays this places the
+ * sign/exponent bytes, which change slowly, next to each other so that
+ * they compress well, while the mantissa bytes are mostly emitted as
+ * literals. The output is a sequence of
+ * (literal count, literals, match length, match offset) records, where
+ * the final record has a match length of zero.
+ *
+ * The compressed size can exceed num_bytes for incompressible data,
+ * callers should then store the block uncompressed.*/
+std::vector<char> chi_misc_utils::
+  CompressBlock(const char* data, const size_t num_bytes,
+                const size_t element_size)
+{
+  std::vector<unsigned char> in(num_bytes);
+  ShuffleBytes(reinterpret_cast<const unsigned char*>(data), in.data(),
+               num_bytes, (element_size > 0)? element_size : 1);
+
+  std::vector<char> out;
+  out.reserve(num_bytes/2 + 16);
+
+  std::vector<int64_t> table(size_t(1) << HASH_BITS, -1);
+
+  size_t anchor = 0;
+  size_t i = 0;
+  while (i + MIN_MATCH <= num_bytes)
+  {
+    uint32_t v; std::memcpy(&v, &in[i], sizeof(uint32_t));
+    const uint32_t h = (v * 2654435761u) >> (32 - HASH_BITS);
+    const int64_t candidate = table[h];
+    table[h] = static_cast<int64_t>(i);
+
+    if (candidate >= 0 and (i - candidate) <= MAX_OFFSET and
+        std::memcmp(&in[candidate], &in[i], MIN_MATCH) == 0)
+    {
+      size_t length = MIN_MATCH;
+      while (i + length < num_bytes and in[candidate + length] == in[i + length])
+        ++length;
+
+      PutVarint(out, i - anchor);
+      out.insert(out.end(), in.begin() + anchor, in.begin() + i);
+      PutVarint(out, length);
+      PutVarint(out, i - candidate);
+
+      i += length;
+      anchor = i;
+    }
+    else
+      ++i;
+  }
+
+  PutVarint(out, num_bytes - anchor);
+  out.insert(out.end(), in.begin() + anchor, in.end());
+  PutVarint(out, 0);
+
+  return out;
+}
+
+//###################################################################
+/**Decompresses a block produced by CompressBlock into dest, which must
+ * hold num_bytes bytes. The element size must be the one used during
+ * compression. Returns false if the block is corrupt.*/
+bool chi_misc_utils::
+  DecompressBlock(const char* data, const size_t num_stored_bytes,
+                  char* dest, const size_t num_bytes,
+                  const size_t element_size)
+{
+  const auto* in = reinterpret_cast<const unsigned char*>(data);
+  std::vector<unsigned char> out(num_bytes);
+
+  size_t ip = 0;
+  size_t op = 0;
+  while (true)
+  {
+    uint64_t num_literals;
+    if (not GetVarint(in, num_stored_bytes, ip, num_literals)) return false;
+    if (num_literals > num_bytes - op or
+        num_literals > num_stored_bytes - ip) return false;
+
+    if (num_literals > 0)
+      std::memcpy(out.data() + op, in + ip, num_literals);
+    op += num_literals;
+    ip += num_literals;
+
+    uint64_t length;
+    if (not GetVarint(in, num_stored_bytes, ip, length)) return false;
+    if (length == 0) break;
+
+    uint64_t offset;
+    if (not GetVarint(in, num_stored_bytes, ip, offset)) return false;
+    if (offset == 0 or offset > op or length > num_bytes - op) return false;
+
+    //Matches may overlap their own output, therefore copy bytewise
+    for (uint64_t k=0; k<length; ++k, ++op)
+      out[op] = out[op - offset];
+  }
+
+  if (op != num_bytes) return false;
+
+  UnshuffleBytes(out.data(), reinterpret_cast<unsigned char*>(dest),
+                 num_bytes, (element_size > 0)? element_size : 1);
+  return true;
+}
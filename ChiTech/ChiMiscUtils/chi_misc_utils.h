@@ -3,6 +3,7 @@
 
 #include <cstddef>
 #include <string>
+#include <vector>
 
 /**Miscellaneous utilities. These utilities should have no dependencies.*/
 namespace chi_misc_utils
@@ -10,6 +11,12 @@ namespace chi_misc_utils
   std::string PrintIterationProgress(size_t current_iteration,
                                      size_t total_num_iterations,
                                      unsigned int num_intvls = 10);
+
+  std::vector<char> CompressBlock(const char* data, size_t num_bytes,
+                                  size_t element_size);
+  bool DecompressBlock(const char* data, size_t num_stored_bytes,
+                       char* dest, size_t num_bytes,
+                       size_t element_size);
 }//namespace chi_misc_utils
 
 #endif //CHITECH_CHI_MISC_UTILS_H
@@ -124,16 +124,25 @@ void ChiTech::ParseArguments(int argc, char** argv)
 int ChiTech::Initialize(int argc, char** argv)
 {
   int location_id = 0, number_processes = 1;
+  int mpi_thread_support = MPI_THREAD_SINGLE;
 
-  MPI_Init (&argc, &argv);                           /* starts MPI */
+  MPI_Init_thread(&argc, &argv,                      /* starts MPI, only  */
+                  MPI_THREAD_FUNNELED,               /* the main thread   */
+                  &mpi_thread_support);              /* communicates      */
   MPI_Comm_rank (MPI_COMM_WORLD, &location_id);      /* get current process id */
   MPI_Comm_size (MPI_COMM_WORLD, &number_processes); /* get number of processes */
 
   chi_mpi.SetLocationID(location_id);
   chi_mpi.SetProcessCount(number_processes);
+  chi_mpi.SetThreadSupport(mpi_thread_support);
 
   chi_console.PostMPIInfo(location_id, number_processes);
 
+  if (mpi_thread_support < MPI_THREAD_FUNNELED)
+    chi_log.Log(LOG_0WARNING)
+      << "The MPI implementation does not provide MPI_THREAD_FUNNELED. "
+         "Sweeps will be restricted to a single thread.";
+
   ParseArguments(argc, argv);
 
   chi_physics_handler.InitPetSc(argc,argv);
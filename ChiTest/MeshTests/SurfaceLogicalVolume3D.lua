@@ -0,0 +1,47 @@
+-- 3D material assignment from a closed surface mesh.
+-- Test: Cells in surface volume=672
+num_procs = 2
+
+
+
+
+
+--############################################### Check num_procs
+if (check_num_procs==nil and chi_number_of_processes ~= num_procs) then
+    chiLog(LOG_0ERROR,"Incorrect amount of processors. " ..
+                      "Expected "..tostring(num_procs)..
+                      ". Pass check_num_procs=false to override if possible.")
+    os.exit(false)
+end
+
+--############################################### Setup mesh
+chiMeshHandlerCreate()
+
+mesh={}
+N=20
+L=2.0
+xmin = -1.0
+dx = L/N
+for i=1,(N+1) do
+    k=i-1
+    mesh[i] = xmin + k*dx
+end
+chiMeshCreateUnpartitioned3DOrthoMesh(mesh,mesh,mesh)
+chiVolumeMesherExecute();
+
+--############################################### Set Material IDs
+-- The octahedron |x|+|y|+|z| <= 0.8 has no axis-aligned faces and
+-- no cell centroid on its surface.
+surf_mesh = chiSurfaceMeshCreate()
+chiSurfaceMeshImportFromOBJFile(surf_mesh,
+        "ChiResources/TestObjects/Octahedron.obj",false)
+
+vol0 = chiLogicalVolumeCreate(RPP,-1000,1000,-1000,1000,-1000,1000)
+vol1 = chiLogicalVolumeCreate(SURFACE,surf_mesh)
+chiVolumeMesherSetProperty(MATID_FROMLOGICAL,vol0,0)
+chiVolumeMesherSetProperty(MATID_FROMLOGICAL,vol1,1)
+
+--############################################### Count cells
+count = chiCountMeshInLogicalVolume(vol1)
+
+chiLog(LOG_0,string.format("Cells in surface volume=%d", count))
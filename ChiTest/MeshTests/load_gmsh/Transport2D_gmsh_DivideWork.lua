@@ -0,0 +1,195 @@
+-- 2D Transport test on a gmsh mesh read with DIVIDE_WORK. Every location
+-- only reads a chunk of the elements of the .msh file. The same problem is
+-- also solved on the mesh read in full by every location and the maximum
+-- values of the two solutions are compared.
+-- Test: Cells in mesh=1339, Max-value1 difference=0.0, Max-value2 difference=0.0
+num_procs = 4
+
+
+
+
+
+--############################################### Check num_procs
+if (check_num_procs==nil and chi_number_of_processes ~= num_procs) then
+    chiLog(LOG_0ERROR,"Incorrect amount of processors. " ..
+                      "Expected "..tostring(num_procs)..
+                      ". Pass check_num_procs=false to override if possible.")
+    os.exit(false)
+end
+
+chiMPIBarrier()
+if (chi_location_id == 0) then
+    print("############################################### LuaTest")
+end
+
+--############################################### Add materials
+materials = {}
+materials[1] = chiPhysicsAddMaterial("Test Material");
+materials[2] = chiPhysicsAddMaterial("Test Material2");
+
+chiPhysicsMaterialAddProperty(materials[1],TRANSPORT_XSECTIONS)
+chiPhysicsMaterialAddProperty(materials[2],TRANSPORT_XSECTIONS)
+
+chiPhysicsMaterialAddProperty(materials[1],ISOTROPIC_MG_SOURCE)
+chiPhysicsMaterialAddProperty(materials[2],ISOTROPIC_MG_SOURCE)
+
+
+num_groups = 168
+chiPhysicsMaterialSetProperty(materials[1],TRANSPORT_XSECTIONS,
+        PDT_XSFILE,"ChiTest/xs_3_170.data")
+chiPhysicsMaterialSetProperty(materials[2],TRANSPORT_XSECTIONS,
+        PDT_XSFILE,"ChiTest/xs_3_170.data")
+
+src={}
+for g=1,num_groups do
+    src[g] = 0.0
+end
+--src[1] = 1.0
+chiPhysicsMaterialSetProperty(materials[1],ISOTROPIC_MG_SOURCE,FROM_ARRAY,src)
+chiPhysicsMaterialSetProperty(materials[2],ISOTROPIC_MG_SOURCE,FROM_ARRAY,src)
+
+
+
+--############################################### Solve on a mesh
+-- Reads the gmsh mesh, with or without DIVIDE_WORK, into a new mesh
+-- handler, solves the transport problem on it and returns the maximum
+-- values of groups 0 and 159.
+function SolveOnMesh(divide_work)
+    --############################################### Setup mesh
+    chiMeshHandlerCreate()
+
+    chiSurfaceMeshCreate();
+    chiUnpartitionedMeshFromMshFormat("ChiResources/TestObjects/gmsh_2d_unstruct1.msh",
+                                      divide_work)
+
+    --############################################### Setup Regions
+    region1 = chiRegionCreate()
+    chiRegionAddSurfaceBoundary(region1,newSurfMesh);
+
+    --############################################### Create meshers
+    chiSurfaceMesherCreate(SURFACEMESHER_PREDEFINED);
+    chiVolumeMesherCreate(VOLUMEMESHER_UNPARTITIONED);
+
+    chiSurfaceMesherSetProperty(PARTITION_X,2)
+    chiSurfaceMesherSetProperty(PARTITION_Y,2)
+    chiSurfaceMesherSetProperty(CUT_X,50.0)
+    chiSurfaceMesherSetProperty(CUT_Y,50.0)
+
+    chiVolumeMesherSetProperty(FORCE_POLYGONS,true);
+
+    --############################################### Execute meshing
+    chiSurfaceMesherExecute();
+    chiVolumeMesherExecute();
+
+    --############################################### Set Material IDs
+    vol0 = chiLogicalVolumeCreate(RPP,-1000,1000,-1000,1000,-1000,1000)
+    chiVolumeMesherSetProperty(MATID_FROMLOGICAL,vol0,0)
+
+    count = chiCountMeshInLogicalVolume(vol0)
+    if (divide_work) then
+        chiLog(LOG_0,string.format("Cells in mesh=%d", count))
+    end
+
+    --############################################### Setup Physics
+    phys1 = chiLBSCreateSolver()
+    chiSolverAddRegion(phys1,region1)
+
+    --========== Groups
+    grp = {}
+    for g=1,num_groups do
+        grp[g] = chiLBSCreateGroup(phys1)
+    end
+
+    --========== ProdQuad
+    pquad = chiCreateProductQuadrature(GAUSS_LEGENDRE_CHEBYSHEV, 10, 1)
+
+    --========== Groupset def
+    gs0 = chiLBSCreateGroupset(phys1)
+    cur_gs = gs0
+    chiLBSGroupsetAddGroups(phys1,cur_gs,0,62)
+    chiLBSGroupsetSetQuadrature(phys1,cur_gs,pquad)
+    chiLBSGroupsetSetAngleAggDiv(phys1,cur_gs,1)
+    chiLBSGroupsetSetGroupSubsets(phys1,cur_gs,2)
+    chiLBSGroupsetSetIterativeMethod(phys1,cur_gs,NPT_GMRES_CYCLES)
+    chiLBSGroupsetSetResidualTolerance(phys1,cur_gs,1.0e-6)
+    chiLBSGroupsetSetMaxIterations(phys1,cur_gs,300)
+    chiLBSGroupsetSetGMRESRestartIntvl(phys1,cur_gs,100)
+
+    gs1 = chiLBSCreateGroupset(phys1)
+    cur_gs = gs1
+    chiLBSGroupsetAddGroups(phys1,cur_gs,63,167)
+    chiLBSGroupsetSetQuadrature(phys1,cur_gs,pquad)
+    chiLBSGroupsetSetAngleAggDiv(phys1,cur_gs,1)
+    chiLBSGroupsetSetGroupSubsets(phys1,cur_gs,2)
+    chiLBSGroupsetSetIterativeMethod(phys1,cur_gs,NPT_GMRES_CYCLES)
+    chiLBSGroupsetSetResidualTolerance(phys1,cur_gs,1.0e-6)
+    chiLBSGroupsetSetMaxIterations(phys1,cur_gs,300)
+    chiLBSGroupsetSetGMRESRestartIntvl(phys1,cur_gs,100)
+
+    --========== Boundary conditions
+    bsrc={}
+    for g=1,num_groups do
+        bsrc[g] = 0.0
+    end
+    bsrc[1] = 1.0/4.0/math.pi
+    chiLBSSetProperty(phys1,BOUNDARY_CONDITION,XMIN,
+                            LBSBoundaryTypes.INCIDENT_ISOTROPIC,bsrc);
+
+    --========== Solvers
+    chiLBSSetProperty(phys1,DISCRETIZATION_METHOD,PWLD3D)
+    chiLBSSetProperty(phys1,SCATTERING_ORDER,1)
+
+    chiLBSInitialize(phys1)
+    chiLBSExecute(phys1)
+
+    fflist,count = chiLBSGetScalarFieldFunctionList(phys1)
+
+    ffi1 = chiFFInterpolationCreate(VOLUME)
+    curffi = ffi1
+    chiFFInterpolationSetProperty(curffi,OPERATION,OP_MAX)
+    chiFFInterpolationSetProperty(curffi,LOGICAL_VOLUME,vol0)
+    chiFFInterpolationSetProperty(curffi,ADD_FIELDFUNCTION,fflist[1])
+
+    chiFFInterpolationInitialize(curffi)
+    chiFFInterpolationExecute(curffi)
+    maxval1 = chiFFInterpolationGetValue(curffi)
+
+    ffi1 = chiFFInterpolationCreate(VOLUME)
+    curffi = ffi1
+    chiFFInterpolationSetProperty(curffi,OPERATION,OP_MAX)
+    chiFFInterpolationSetProperty(curffi,LOGICAL_VOLUME,vol0)
+    chiFFInterpolationSetProperty(curffi,ADD_FIELDFUNCTION,fflist[160])
+
+    chiFFInterpolationInitialize(curffi)
+    chiFFInterpolationExecute(curffi)
+    maxval2 = chiFFInterpolationGetValue(curffi)
+
+    if (divide_work) then
+        slice2 = chiFFInterpolationCreate(SLICE)
+        chiFFInterpolationSetProperty(slice2,SLICE_POINT,0.0,0.0,0.025)
+        chiFFInterpolationSetProperty(slice2,ADD_FIELDFUNCTION,fflist[1])
+
+        chiFFInterpolationInitialize(slice2)
+        chiFFInterpolationExecute(slice2)
+
+        if (chi_location_id == 0 and master_export == nil) then
+            chiFFInterpolationExportPython(slice2)
+            local handle = io.popen("python ZPFFI00.py")
+        end
+
+        chiExportFieldFunctionToVTKG(fflist[1],"ZPhi_DivideWork","Phi")
+    end
+
+    return maxval1, maxval2
+end
+
+--############################################### Compare readers
+ref_maxval1, ref_maxval2 = SolveOnMesh(false)
+maxval1, maxval2 = SolveOnMesh(true)
+
+chiLog(LOG_0,string.format("Max-value1=%.5f", maxval1))
+chiLog(LOG_0,string.format("Max-value2=%.5e", maxval2))
+chiLog(LOG_0,string.format("Max-value1 difference=%.3e",
+                           math.abs(maxval1 - ref_maxval1)/ref_maxval1))
+chiLog(LOG_0,string.format("Max-value2 difference=%.3e",
+                           math.abs(maxval2 - ref_maxval2)/ref_maxval2))
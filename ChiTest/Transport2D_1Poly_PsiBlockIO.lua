@@ -0,0 +1,176 @@
+-- 2D Transport test with Vacuum and Incident-isotropic BC, writing the
+-- angular fluxes of a groupset in the compressed block format and reading
+-- them back into a second, unsolved, solver. Both solvers then write the
+-- angular fluxes uncompressed and the files are compared.
+-- SDM: PWLD
+-- Test: Max-value=0.50758, Psi round-trip match=1
+num_procs = 4
+
+
+
+
+
+--############################################### Check num_procs
+if (check_num_procs==nil and chi_number_of_processes ~= num_procs) then
+    chiLog(LOG_0ERROR,"Incorrect amount of processors. " ..
+                      "Expected "..tostring(num_procs)..
+                      ". Pass check_num_procs=false to override if possible.")
+    os.exit(false)
+end
+
+--############################################### Setup mesh
+chiMeshHandlerCreate()
+
+chiUnpartitionedMeshFromWavefrontOBJ(
+        "ChiResources/TestObjects/SquareMesh2x2QuadsBlock.obj")
+
+region1 = chiRegionCreate()
+
+chiSurfaceMesherCreate(SURFACEMESHER_PREDEFINED);
+chiVolumeMesherCreate(VOLUMEMESHER_UNPARTITIONED);
+
+chiVolumeMesherSetKBAPartitioningPxPyPz(2,2,1)
+chiVolumeMesherSetKBACutsX({0.0})
+chiVolumeMesherSetKBACutsY({0.0})
+
+chiVolumeMesherSetProperty(PARTITION_TYPE,KBA_STYLE_XYZ)
+
+chiSurfaceMesherExecute();
+chiVolumeMesherExecute();
+
+--############################################### Set Material IDs
+vol0 = chiLogicalVolumeCreate(RPP,-1000,1000,-1000,1000,-1000,1000)
+chiVolumeMesherSetProperty(MATID_FROMLOGICAL,vol0,0)
+
+
+--############################################### Add materials
+materials = {}
+materials[1] = chiPhysicsAddMaterial("Test Material");
+materials[2] = chiPhysicsAddMaterial("Test Material2");
+
+chiPhysicsMaterialAddProperty(materials[1],TRANSPORT_XSECTIONS)
+chiPhysicsMaterialAddProperty(materials[2],TRANSPORT_XSECTIONS)
+
+chiPhysicsMaterialAddProperty(materials[1],ISOTROPIC_MG_SOURCE)
+chiPhysicsMaterialAddProperty(materials[2],ISOTROPIC_MG_SOURCE)
+
+
+num_groups = 168
+chiPhysicsMaterialSetProperty(materials[1],TRANSPORT_XSECTIONS,
+        CHI_XSFILE,"ChiTest/xs_3_170.cxs")
+chiPhysicsMaterialSetProperty(materials[2],TRANSPORT_XSECTIONS,
+        CHI_XSFILE,"ChiTest/xs_3_170.cxs")
+
+--chiPhysicsMaterialSetProperty(materials[1],TRANSPORT_XSECTIONS,SIMPLEXS0,num_groups,0.1)
+--chiPhysicsMaterialSetProperty(materials[2],TRANSPORT_XSECTIONS,SIMPLEXS0,num_groups,0.1)
+
+src={}
+for g=1,num_groups do
+    src[g] = 0.0
+end
+--src[1] = 1.0
+chiPhysicsMaterialSetProperty(materials[1],ISOTROPIC_MG_SOURCE,FROM_ARRAY,src)
+chiPhysicsMaterialSetProperty(materials[2],ISOTROPIC_MG_SOURCE,FROM_ARRAY,src)
+
+--############################################### Setup Physics
+-- Creates a solver that saves its angular fluxes
+function CreateSolver()
+    local phys = chiLBSCreateSolver()
+    chiSolverAddRegion(phys,region1)
+
+    --========== Groups
+    for g=1,num_groups do
+        chiLBSCreateGroup(phys)
+    end
+
+    --========== ProdQuad
+    local pquad = chiCreateProductQuadrature(GAUSS_LEGENDRE_CHEBYSHEV,2, 1)
+
+    --========== Groupset def
+    local gs = chiLBSCreateGroupset(phys)
+    chiLBSGroupsetAddGroups(phys,gs,0,62)
+    chiLBSGroupsetSetQuadrature(phys,gs,pquad)
+    chiLBSGroupsetSetAngleAggDiv(phys,gs,1)
+    chiLBSGroupsetSetGroupSubsets(phys,gs,2)
+    chiLBSGroupsetSetIterativeMethod(phys,gs,NPT_GMRES)
+    chiLBSGroupsetSetResidualTolerance(phys,gs,1.0e-6)
+    chiLBSGroupsetSetMaxIterations(phys,gs,300)
+    chiLBSGroupsetSetGMRESRestartIntvl(phys,gs,100)
+
+    gs = chiLBSCreateGroupset(phys)
+    chiLBSGroupsetAddGroups(phys,gs,63,167)
+    chiLBSGroupsetSetQuadrature(phys,gs,pquad)
+    chiLBSGroupsetSetAngleAggDiv(phys,gs,1)
+    chiLBSGroupsetSetGroupSubsets(phys,gs,2)
+    chiLBSGroupsetSetIterativeMethod(phys,gs,NPT_GMRES)
+    chiLBSGroupsetSetResidualTolerance(phys,gs,1.0e-6)
+    chiLBSGroupsetSetMaxIterations(phys,gs,300)
+    chiLBSGroupsetSetGMRESRestartIntvl(phys,gs,100)
+
+    --========== Boundary conditions
+    local bsrc={}
+    for g=1,num_groups do
+        bsrc[g] = 0.0
+    end
+    bsrc[1] = 1.0/4.0/math.pi
+    chiLBSSetProperty(phys,BOUNDARY_CONDITION,XMIN,
+                            LBSBoundaryTypes.INCIDENT_ISOTROPIC,bsrc);
+
+    chiLBSSetProperty(phys,DISCRETIZATION_METHOD,PWLD)
+    chiLBSSetProperty(phys,SCATTERING_ORDER,1)
+    chiLBSSetProperty(phys,SAVE_ANGULAR_FLUX,true)
+
+    return phys
+end
+
+--############################################### Initialize and Execute Solver
+phys1 = CreateSolver()
+chiLBSInitialize(phys1)
+chiLBSExecute(phys1)
+
+--############################################### Write and read angular fluxes
+chiLBSWriteGroupsetAngularFlux(phys1,0,"ZPsiBlock",true)
+chiLBSWriteGroupsetAngularFlux(phys1,0,"ZPsiRef")
+
+phys2 = CreateSolver()
+chiLBSInitialize(phys2)
+chiLBSReadGroupsetAngularFlux(phys2,0,"ZPsiBlock")
+chiLBSWriteGroupsetAngularFlux(phys2,0,"ZPsiRead")
+
+chiMPIBarrier()
+
+--############################################### Compare angular fluxes
+if (chi_location_id == 0) then
+    match = 1
+    for p=0,chi_number_of_processes-1 do
+        local ref_file  = io.open("ZPsiRef"..tostring(p)..".data","rb")
+        local read_file = io.open("ZPsiRead"..tostring(p)..".data","rb")
+        if (ref_file == nil or read_file == nil) then
+            match = 0
+        else
+            local ref_data  = ref_file:read("*a")
+            local read_data = read_file:read("*a")
+            if (string.len(ref_data) == 0 or ref_data ~= read_data) then
+                match = 0
+            end
+            ref_file:close()
+            read_file:close()
+        end
+    end
+    chiLog(LOG_0,string.format("Psi round-trip match=%d", match))
+end
+
+--############################################### Volume integrations
+fflist,count = chiLBSGetScalarFieldFunctionList(phys1)
+
+ffi1 = chiFFInterpolationCreate(VOLUME)
+curffi = ffi1
+chiFFInterpolationSetProperty(curffi,OPERATION,OP_MAX)
+chiFFInterpolationSetProperty(curffi,LOGICAL_VOLUME,vol0)
+chiFFInterpolationSetProperty(curffi,ADD_FIELDFUNCTION,fflist[1])
+
+chiFFInterpolationInitialize(curffi)
+chiFFInterpolationExecute(curffi)
+maxval = chiFFInterpolationGetValue(curffi)
+
+chiLog(LOG_0,string.format("Max-value1=%.5f", maxval))
@@ -231,6 +231,88 @@ run_test(
     search_strings_vals_tols=[["[0]  Max-value1=", 0.50758, 1.0e-4],
                               ["[0]  Max-value2=", 2.52527e-04, 1.0e-4]])
 
+run_test(
+    file_name="Transport2D_1Poly_PsiBlockIO",
+    comment="2D LinearBSolver Test Compressed angular flux IO - PWLD",
+    num_procs=4,
+    search_strings_vals_tols=[["[0]  Max-value1=", 0.50758, 1.0e-4],
+                              ["[0]  Psi round-trip match=", 1, 0.5]])
+
+run_test(
+    file_name="Transport2D_1Poly_restart_part1",
+    comment="2D LinearBSolver Test Background checkpoint writing - PWLD",
+    num_procs=4,
+    search_strings_vals_tols=[["[0]  Max-value1=", 0.50758, 1.0e-4],
+                              ["[0]  Max-value2=", 2.52527e-04, 1.0e-4],
+                              ["[0]  Checkpoint committed=", 1, 0.5]])
+
+run_test(
+    file_name="Transport2D_1Poly_restart_part2",
+    comment="2D LinearBSolver Test Restart reading - PWLD",
+    num_procs=4,
+    search_strings_vals_tols=[["[0]  Max-value1=", 0.50758, 1.0e-4],
+                              ["[0]  Max-value2=", 2.52527e-04, 1.0e-4]])
+
+run_test(
+    file_name="Transport2D_1Poly_DSA",
+    comment="2D LinearBSolver Test WGDSA+TGDSA - PWLD",
+    num_procs=4,
+    search_strings_vals_tols=[["[0]  Max-value1=", 0.50758, 1.0e-4],
+                              ["[0]  Max-value2=", 2.52527e-04, 1.0e-6]])
+
+run_test(
+    file_name="Transport2D_1Poly_DSA_Rebuild",
+    comment="2D LinearBSolver Test DSA rebuild policies - PWLD",
+    num_procs=4,
+    search_strings_vals_tols=[["[0]  ALWAYS Max-value1=", 0.50758, 1.0e-4],
+                              ["[0]  ALWAYS Max-value2=", 2.52527e-04, 1.0e-6],
+                              ["[0]  ON_XS_CHANGE Max-value1=", 0.50758, 1.0e-4],
+                              ["[0]  ON_XS_CHANGE Max-value2=", 2.52527e-04, 1.0e-6],
+                              ["[0]  NEVER Max-value1=", 0.50758, 1.0e-4],
+                              ["[0]  NEVER Max-value2=", 2.52527e-04, 1.0e-6]])
+
+run_test(
+    file_name="Transport2D_1Poly_DSA_MF",
+    comment="2D LinearBSolver Test matrix-free WGDSA+TGDSA - PWLD",
+    num_procs=4,
+    search_strings_vals_tols=[["[0]  Max-value1=", 0.50758, 1.0e-4],
+                              ["[0]  Max-value2=", 2.52527e-04, 1.0e-6]])
+
+run_test(
+    file_name="Transport2D_1Poly_DSA_MFJacobi",
+    comment="2D LinearBSolver Test matrix-free WGDSA+TGDSA, Jacobi - PWLD",
+    num_procs=4,
+    search_strings_vals_tols=[["[0]  Max-value1=", 0.50758, 1.0e-4],
+                              ["[0]  Max-value2=", 2.52527e-04, 1.0e-6]])
+
+run_test(
+    file_name="Transport2D_1Poly_AGS_GS",
+    comment="2D LinearBSolver Test AGS Gauss-Seidel - PWLD",
+    num_procs=4,
+    search_strings_vals_tols=[["[0]  Max-value1=", 0.50758, 1.0e-4],
+                              ["[0]  Max-value2=", 2.52527e-04, 1.0e-6]])
+
+run_test(
+    file_name="Transport2D_1Poly_AGS_Upscatter",
+    comment="2D LinearBSolver Test AGS Gauss-Seidel with upscatter - PWLD",
+    num_procs=4,
+    search_strings_vals_tols=[["[0]  Max-value1=", 0.50758, 1.0e-4],
+                              ["[0]  Max-value2=", 2.52527e-04, 1.0e-6]])
+
+run_test(
+    file_name="Transport2D_1Poly_AGS_Jacobi",
+    comment="2D LinearBSolver Test AGS Jacobi - PWLD",
+    num_procs=4,
+    search_strings_vals_tols=[["[0]  Max-value1=", 0.50758, 1.0e-4],
+                              ["[0]  Max-value2=", 2.52527e-04, 1.0e-6]])
+
+run_test(
+    file_name="Transport2D_1Poly_AGS_TwoGrid",
+    comment="2D LinearBSolver Test AGS two-grid - PWLD",
+    num_procs=4,
+    search_strings_vals_tols=[["[0]  Max-value1=", 0.50758, 1.0e-4],
+                              ["[0]  Max-value2=", 2.52527e-04, 1.0e-6]])
+
 run_test(
     file_name="Transport2D_2Unstructured",
     comment="2D LinearBSolver Test Unstructured grid - PWLD",
@@ -252,6 +334,34 @@ run_test(
     search_strings_vals_tols=[["[0]  Max-value1=", 5.28310e-01, 1.0e-4],
                               ["[0]  Max-value2=", 8.04576e-04, 1.0e-4]])
 
+run_test(
+    file_name="Transport3D_1b_Ortho_PersistentComm",
+    comment="3D LinearBSolver Test - PWLD Reflecting BC, persistent sweep comm",
+    num_procs=4,
+    search_strings_vals_tols=[["[0]  Max-value1=", 5.28310e-01, 1.0e-4],
+                              ["[0]  Max-value2=", 8.04576e-04, 1.0e-4]])
+
+run_test(
+    file_name="Transport3D_1b_Ortho_OrderingCache",
+    comment="3D LinearBSolver Test - PWLD Reflecting BC, sweep ordering cache",
+    num_procs=4,
+    search_strings_vals_tols=[["[0]  Max-value1=", 5.28310e-01, 1.0e-4],
+                              ["[0]  Max-value2=", 8.04576e-04, 1.0e-4]])
+
+run_test(
+    file_name="Transport3D_1b_Ortho_DistributedTDG",
+    comment="3D LinearBSolver Test - PWLD Reflecting BC, distributed TDG",
+    num_procs=4,
+    search_strings_vals_tols=[["[0]  Max-value1=", 5.28310e-01, 1.0e-4],
+                              ["[0]  Max-value2=", 8.04576e-04, 1.0e-4]])
+
+run_test(
+    file_name="Transport3D_1c_Threads",
+    comment="3D LinearBSolver Test - PWLD Reflecting BC, threaded sweeps",
+    num_procs=4,
+    search_strings_vals_tols=[["[0]  Max-value1=", 5.28310e-01, 1.0e-4],
+                              ["[0]  Max-value2=", 8.04576e-04, 1.0e-4]])
+
 run_test(
     file_name="Transport3D_1Poly_parmetis",
     comment="3D LinearBSolver Test Ortho Grid Parmetis - PWLD",
@@ -310,6 +420,18 @@ run_test(
     num_procs=4,
     search_strings_vals_tols=[["[0]          Final k-eigenvalue    :", 0.99954, 1.0e-5]])
 
+run_test(
+    file_name="KEigenvalueTransport1D_1G_NKA",
+    comment="1D KSolver LinearBSolver Test - PWLD, NKA",
+    num_procs=4,
+    search_strings_vals_tols=[["[0]          Final k-eigenvalue    :", 0.99954, 1.0e-5]])
+
+run_test(
+    file_name="KEigenvalueTransport1D_1G_DA",
+    comment="1D KSolver LinearBSolver Test - PWLD, diffusion accelerated",
+    num_procs=4,
+    search_strings_vals_tols=[["[0]          Final k-eigenvalue    :", 0.99954, 1.0e-5]])
+
 run_test(
     file_name="Transport2DCyl_1Monoenergetic",
     comment="2D LinearBSolver Cylindrical Test mono-energetic - PWLD",
@@ -323,6 +445,20 @@ run_test(
     search_strings_vals_tols=[["[0]  Max-valueG1=", 1.00000, 1.0e-09],
                               ["[0]  Max-valueG2=", 0.25000, 1.0e-09]])
 
+run_test(
+    file_name="MeshTests/SurfaceLogicalVolume3D",
+    comment="3D Material IDs from a surface logical volume",
+    num_procs=2,
+    search_strings_vals_tols=[["[0]  Cells in surface volume=", 672, 0.5]])
+
+run_test(
+    file_name="MeshTests/load_gmsh/Transport2D_gmsh_DivideWork",
+    comment="2D Transport gmsh mesh read with DIVIDE_WORK",
+    num_procs=4,
+    search_strings_vals_tols=[["[0]  Cells in mesh=", 1339, 0.5],
+                              ["[0]  Max-value1 difference=", 0.0, 1.0e-5],
+                              ["[0]  Max-value2 difference=", 0.0, 1.0e-5]])
+
 # $$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$$ END OF TESTS
 print("")
 if num_failed == 0: